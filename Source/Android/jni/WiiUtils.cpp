@@ -100,7 +100,7 @@ JNIEXPORT void JNICALL Java_org_dolphinemu_dolphinemu_utils_WiiUtils_importNANDB
 {
   const std::string path = GetJString(env, jFile);
 
-  return DiscIO::NANDImporter().ImportNANDBin(
+  DiscIO::NANDImporter().ImportNANDBin(
       path,
       [] {
         // This callback gets called every now and then in case we want to update the GUI. However,
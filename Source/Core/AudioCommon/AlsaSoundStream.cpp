@@ -3,11 +3,13 @@
 
 #include "AudioCommon/AlsaSoundStream.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
 
 AlsaSound::AlsaSound()
     : m_thread_status(ALSAThreadStatus::STOPPED), handle(nullptr),
@@ -55,12 +57,19 @@ void AlsaSound::SoundLoop()
       if (rc == -EPIPE)
       {
         // Underrun
+        m_mixer->ReportOutputUnderrun();
         snd_pcm_prepare(handle);
       }
       else if (rc < 0)
       {
         ERROR_LOG_FMT(AUDIO, "writei fail: {}", snd_strerror(rc));
       }
+      else
+      {
+        snd_pcm_sframes_t delay;
+        if (snd_pcm_delay(handle, &delay) == 0)
+          m_mixer->SetOutputLatency(static_cast<u32>(std::max<snd_pcm_sframes_t>(delay, 0)));
+      }
     }
     if (m_thread_status.load() == ALSAThreadStatus::PAUSED)
     {
@@ -144,7 +153,14 @@ bool AlsaSound::AlsaInit()
     return false;
   }
 
-  periods = BUFFER_SIZE_MAX / FRAME_COUNT_MIN;
+  buffer_size_max = BUFFER_SIZE_MAX;
+  if (Config::Get(Config::MAIN_AUDIO_LOW_LATENCY))
+  {
+    buffer_size_max = std::clamp<snd_pcm_uframes_t>(m_mixer->GetLowLatencyOutputFrames(),
+                                                    FRAME_COUNT_MIN * 2, BUFFER_SIZE_MAX);
+  }
+
+  periods = buffer_size_max / FRAME_COUNT_MIN;
   err = snd_pcm_hw_params_set_periods_max(handle, hwparams, &periods, &dir);
   if (err < 0)
   {
@@ -152,7 +168,6 @@ bool AlsaSound::AlsaInit()
     return false;
   }
 
-  buffer_size_max = BUFFER_SIZE_MAX;
   err = snd_pcm_hw_params_set_buffer_size_max(handle, hwparams, &buffer_size_max);
   if (err < 0)
   {
@@ -17,6 +17,11 @@ public:
   void GetStretchedSamples(short* out, unsigned int num_out);
   void Clear();
 
+  // Ratio of input to output samples, which follows the emulation speed.
+  double GetStretchRatio() const { return m_stretch_ratio; }
+  // Stretched samples which have not been played yet.
+  unsigned int GetBufferedSamples() const { return m_sound_touch.numSamples(); }
+
 private:
   unsigned int m_sample_rate;
   std::array<short, 2> m_last_stretched_sample = {};
@@ -19,6 +19,7 @@
 
 // ~10 ms - needs to be at least 240 for surround
 constexpr u32 BUFFER_SAMPLES = 512;
+constexpr u32 SURROUND_MIN_SAMPLES = 240;
 
 long CubebStream::DataCallback(cubeb_stream* stream, void* user_data, const void* /*input_buffer*/,
                                void* output_buffer, long num_frames)
@@ -91,10 +92,21 @@ bool CubebStream::Init()
         ERROR_LOG_FMT(AUDIO, "Error getting minimum latency");
       INFO_LOG_FMT(AUDIO, "Minimum latency: {} frames", minimum_latency);
 
-      return_value =
-          cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr, nullptr,
-                            nullptr, &params, std::max(BUFFER_SAMPLES, minimum_latency),
-                            DataCallback, StateCallback, this) == CUBEB_OK;
+      u32 latency = BUFFER_SAMPLES;
+      if (Config::Get(Config::MAIN_AUDIO_LOW_LATENCY))
+      {
+        latency = m_mixer->GetLowLatencyOutputFrames();
+        if (!m_stereo)
+          latency = std::max(latency, SURROUND_MIN_SAMPLES);
+      }
+      latency = std::max(latency, minimum_latency);
+      INFO_LOG_FMT(AUDIO, "Requested latency: {} frames", latency);
+
+      return_value = cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr,
+                                       nullptr, nullptr, &params, latency, DataCallback,
+                                       StateCallback, this) == CUBEB_OK;
+      if (return_value)
+        m_mixer->SetOutputLatency(latency);
     }
 
 #ifdef _WIN32
@@ -117,7 +129,15 @@ bool CubebStream::SetRunning(bool running)
     Common::ScopeGuard sync_event_guard([&sync_event] { sync_event.Set(); });
 #endif
     if (running)
+    {
       return_value = cubeb_stream_start(m_stream) == CUBEB_OK;
+
+      // Includes the device's own buffering, which the requested latency doesn't. Not all cubeb
+      // backends can report this before the stream has played anything.
+      u32 latency = 0;
+      if (return_value && cubeb_stream_get_latency(m_stream, &latency) == CUBEB_OK && latency != 0)
+        m_mixer->SetOutputLatency(latency);
+    }
     else
       return_value = cubeb_stream_stop(m_stream) == CUBEB_OK;
 #ifdef _WIN32
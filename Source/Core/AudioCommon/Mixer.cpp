@@ -4,10 +4,12 @@
 #include "AudioCommon/Mixer.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 
 #include "AudioCommon/Enums.h"
+#include "AudioCommon/MixerKernels.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -62,8 +64,6 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
                                    bool consider_framelimit, float emulationspeed,
                                    int timing_variance)
 {
-  unsigned int currentSample = 0;
-
   // Cache access in non-volatile variable
   // This is the only function changing the read value, so it's safe to
   // cache it locally although it's written here.
@@ -107,34 +107,47 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  // Frames which must be available after the read position. Linear interpolation uses the next
+  // frame, cubic interpolation the next two.
+  const bool cubic = m_mixer->m_config_cubic_resampling;
+  const u32 lookahead = cubic ? 2 : 1;
+  const u32 available_frames = ((indexW - indexR) & INDEX_MASK) / 2;
+
+  // Output frames whose position is before input frame (available_frames - lookahead).
+  unsigned int actual_sample_count = 0;
+  if (available_frames > lookahead)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    const u64 end_position = (static_cast<u64>(available_frames - lookahead) << 16) - m_frac;
+    const u64 max_frames = ratio == 0 ? numSamples : (end_position - 1) / ratio + 1;
+    actual_sample_count = static_cast<u32>(std::min<u64>(numSamples, max_frames));
   }
 
-  // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
+  if (actual_sample_count != 0)
+  {
+    const u64 last_position = m_frac + static_cast<u64>(actual_sample_count - 1) * ratio;
+    const u32 input_frames = static_cast<u32>(last_position >> 16) + 1 + lookahead;
+
+    short* const input = m_mixer->m_resample_buffer.data();
+    CopyFrames(input, indexR - 2, input_frames + 1);
+
+    if (cubic)
+    {
+      AudioCommon::MixerKernels::MixCubic(samples, input + 2, actual_sample_count, m_frac, ratio,
+                                          lvolume, rvolume);
+    }
+    else
+    {
+      AudioCommon::MixerKernels::MixLinear(samples, input + 2, actual_sample_count, m_frac, ratio,
+                                           lvolume, rvolume);
+    }
+
+    const u64 position = last_position + ratio;
+    indexR += static_cast<u32>(position >> 16) * 2;
+    m_frac = static_cast<u32>(position & 0xffff);
+  }
 
   // Padding
+  unsigned int currentSample = actual_sample_count * 2;
   short s[2];
   s[0] = read_buffer((indexR - 1) & INDEX_MASK);
   s[1] = read_buffer((indexR - 2) & INDEX_MASK);
@@ -165,8 +178,9 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   // TODO: Determine how emulation speed will be used in audio
   // const float emulation_speed = g_perf_metrics.GetSpeed();
   const float emulation_speed = m_config_emulation_speed;
-  const int timing_variance = m_config_timing_variance;
-  if (m_config_audio_stretch)
+  const bool low_latency = m_config_low_latency;
+  const int timing_variance = low_latency ? GetLowLatencyFifoTarget() : m_config_timing_variance;
+  if (m_config_audio_stretch && (!low_latency || m_stretch_engaged))
   {
     unsigned int available_samples =
         std::min(m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples());
@@ -199,18 +213,51 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
     }
     m_stretcher.ProcessSamples(m_scratch_buffer.data(), available_samples, num_samples);
     m_stretcher.GetStretchedSamples(samples, num_samples);
+
+    if (low_latency)
+    {
+      // Go back to the FIFO once emulation has caught up, since the stretcher adds latency.
+      if (m_stretcher.GetStretchRatio() >= STRETCH_FULL_SPEED_RATIO)
+        m_frames_at_full_speed += num_samples;
+      else
+        m_frames_at_full_speed = 0;
+
+      if (m_frames_at_full_speed >= m_sampleRate * STRETCH_RECOVERY_SECONDS)
+      {
+        m_stretch_engaged = false;
+        m_fifo_primed = false;
+        m_fifo_underrun = true;
+      }
+    }
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    m_is_stretching = false;
+
+    // Rather than playing every sample as soon as it arrives and running dry right away, low
+    // latency mode holds back the DMA FIFO until it holds its target amount of audio. The other
+    // sources keep playing meanwhile, so that their FIFOs don't fill up and overflow.
+    if (low_latency && !m_fifo_primed &&
+        m_dma_mixer.AvailableSamples() >= static_cast<u32>(timing_variance) * m_sampleRate / 1000)
+    {
+      m_fifo_primed = true;
+    }
+    const bool mix_dma = !low_latency || m_fifo_primed;
+
+    unsigned int mixed_samples = 0;
+    if (mix_dma)
+      mixed_samples = m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     for (auto& mixer : m_gba_mixers)
       mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_is_stretching = false;
+
+    if (mix_dma)
+      UpdateUnderrunState(mixed_samples < num_samples, num_samples);
   }
 
+  PublishLatency();
   return num_samples;
 }
 
@@ -243,6 +290,99 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
   return num_samples;
 }
 
+void Mixer::SetOutputLatency(unsigned int num_frames)
+{
+  m_output_latency_frames.store(num_frames);
+}
+
+void Mixer::ReportOutputUnderrun()
+{
+  g_perf_metrics.CountAudioUnderrun();
+}
+
+unsigned int Mixer::GetLowLatencyOutputFrames() const
+{
+  // The sound stream gets half of the target latency, the DMA FIFO the rest.
+  const u32 target_frames = std::max(m_config_target_latency, 0) * m_sampleRate / 1000;
+  return std::max(target_frames / 2, MIN_OUTPUT_FRAMES);
+}
+
+int Mixer::GetLowLatencyFifoTarget() const
+{
+  const int output_ms =
+      static_cast<int>(static_cast<u64>(m_output_latency_frames.load()) * 1000 / m_sampleRate);
+  const int target = std::max(m_config_target_latency - output_ms, MIN_FIFO_LATENCY_MS);
+
+  // Never buffer more than outside of low latency mode.
+  return std::min(target + m_fifo_latency_margin_ms,
+                  std::max(m_config_timing_variance, MIN_FIFO_LATENCY_MS));
+}
+
+void Mixer::UpdateUnderrunState(bool underrun, unsigned int num_samples)
+{
+  if (!underrun)
+  {
+    m_fifo_underrun = false;
+    m_frames_since_underrun =
+        std::min(m_frames_since_underrun + num_samples, m_sampleRate * STRETCH_ENGAGE_SECONDS);
+
+    m_frames_since_margin_change += num_samples;
+    if (m_frames_since_margin_change >= m_sampleRate * FIFO_LATENCY_DECAY_SECONDS)
+    {
+      m_fifo_latency_margin_ms = std::max(m_fifo_latency_margin_ms - 1, 0);
+      m_frames_since_margin_change = 0;
+    }
+    return;
+  }
+
+  // Only count the first callback of an underrun, and none before the FIFO was ever full.
+  if (m_fifo_underrun)
+    return;
+  m_fifo_underrun = true;
+  g_perf_metrics.CountAudioUnderrun();
+
+  if (m_config_low_latency)
+  {
+    m_fifo_primed = false;
+    m_fifo_latency_margin_ms =
+        std::min(m_fifo_latency_margin_ms + FIFO_LATENCY_STEP_MS, m_config_timing_variance);
+    m_frames_since_margin_change = 0;
+
+    // Emulation can't keep up, so hide the gaps with the stretcher until it can.
+    if (m_config_audio_stretch && m_frames_since_underrun < m_sampleRate * STRETCH_ENGAGE_SECONDS)
+    {
+      m_stretch_engaged = true;
+      m_frames_at_full_speed = 0;
+    }
+  }
+  m_frames_since_underrun = 0;
+}
+
+void Mixer::PublishLatency()
+{
+  u32 buffered_frames = m_dma_mixer.AvailableSamples() + m_output_latency_frames.load();
+  if (m_is_stretching)
+    buffered_frames += m_stretcher.GetBufferedSamples();
+
+  g_perf_metrics.SetAudioLatency(std::chrono::duration_cast<DT>(
+      DT_s(static_cast<double>(buffered_frames) / m_sampleRate)));
+}
+
+void Mixer::MixerFifo::CopyFrames(short* dest, u32 index, u32 num_frames) const
+{
+  const u32 start = index & INDEX_MASK;
+  const u32 count = num_frames * 2;
+  const u32 first_count = std::min(count, MAX_SAMPLES * 2 - start);
+  std::copy_n(&m_buffer[start], first_count, dest);
+  std::copy_n(&m_buffer[0], count - first_count, dest + first_count);
+
+  if (!m_little_endian)
+  {
+    for (u32 i = 0; i < count; i++)
+      dest[i] = Common::swap16(dest[i]);
+  }
+}
+
 void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_samples)
 {
   // Cache access in non-volatile variable
@@ -458,6 +598,9 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_cubic_resampling = Config::Get(Config::MAIN_AUDIO_CUBIC_RESAMPLING);
+  m_config_low_latency = Config::Get(Config::MAIN_AUDIO_LOW_LATENCY);
+  m_config_target_latency = Config::Get(Config::MAIN_AUDIO_TARGET_LATENCY);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
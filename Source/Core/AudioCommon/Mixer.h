@@ -25,6 +25,14 @@ public:
   unsigned int Mix(short* samples, unsigned int numSamples);
   unsigned int MixSurround(float* samples, unsigned int num_samples);
 
+  // Called by sound streams which know how many frames they have queued ahead of the output
+  // device. This is added to the mixer's own buffering to get the end-to-end audio latency.
+  void SetOutputLatency(unsigned int num_frames);
+  // Called by sound streams when the output device ran out of samples.
+  void ReportOutputUnderrun();
+  // Number of frames a sound stream should buffer in low latency mode.
+  unsigned int GetLowLatencyOutputFrames() const;
+
   // Called from main thread
   void PushSamples(const short* samples, unsigned int num_samples);
   void PushStreamingSamples(const short* samples, unsigned int num_samples);
@@ -59,6 +67,19 @@ private:
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
 
+  // Low latency mode: the DMA FIFO target starts at the part of the target latency that the sound
+  // stream leaves over, and grows by a step on every underrun. It shrinks again by 1 ms after
+  // each decay period without underruns.
+  static constexpr int MIN_FIFO_LATENCY_MS = 5;
+  static constexpr int FIFO_LATENCY_STEP_MS = 2;
+  static constexpr u32 FIFO_LATENCY_DECAY_SECONDS = 10;
+  static constexpr u32 MIN_OUTPUT_FRAMES = 128;
+  // If stretching is enabled, low latency mode only stretches after two underruns within this
+  // period, and stops once emulation has been back at full speed for the recovery period.
+  static constexpr u32 STRETCH_ENGAGE_SECONDS = 1;
+  static constexpr u32 STRETCH_RECOVERY_SECONDS = 2;
+  static constexpr double STRETCH_FULL_SPEED_RATIO = 0.99;
+
   const unsigned int SURROUND_CHANNELS = 6;
 
   class MixerFifo final
@@ -80,6 +101,9 @@ private:
     unsigned int AvailableSamples() const;
 
   private:
+    // Copies frames out of the ring buffer, converting them to native endianness.
+    void CopyFrames(short* dest, u32 index, u32 num_frames) const;
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate_divisor;
     bool m_little_endian;
@@ -94,6 +118,9 @@ private:
   };
 
   void RefreshConfig();
+  int GetLowLatencyFifoTarget() const;
+  void UpdateUnderrunState(bool underrun, unsigned int num_samples);
+  void PublishLatency();
 
   MixerFifo m_dma_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
   MixerFifo m_streaming_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 48000, false};
@@ -106,9 +133,21 @@ private:
   unsigned int m_sampleRate;
 
   bool m_is_stretching = false;
+  // Only touched by the audio thread
+  bool m_fifo_underrun = true;
+  bool m_fifo_primed = false;
+  bool m_stretch_engaged = false;
+  int m_fifo_latency_margin_ms = 0;
+  u32 m_frames_since_underrun = 0;
+  u32 m_frames_since_margin_change = 0;
+  u32 m_frames_at_full_speed = 0;
+  // Set by the sound stream, possibly from a different thread
+  std::atomic<u32> m_output_latency_frames{0};
   AudioCommon::AudioStretcher m_stretcher;
   AudioCommon::SurroundDecoder m_surround_decoder;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
+  // Contiguous copy of the frames a MixerFifo is resampling, preceded by the frame before them.
+  std::array<short, (MAX_SAMPLES + 1) * 2> m_resample_buffer{};
 
   WaveFileWriter m_wave_writer_dtk;
   WaveFileWriter m_wave_writer_dsp;
@@ -119,6 +158,9 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  bool m_config_cubic_resampling;
+  bool m_config_low_latency;
+  int m_config_target_latency;
 
   size_t m_config_changed_callback_id;
 };
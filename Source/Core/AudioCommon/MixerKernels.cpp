@@ -0,0 +1,227 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/MixerKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+
+namespace AudioCommon::MixerKernels
+{
+namespace
+{
+constexpr s32 SAMPLE_MIN = -32767;
+constexpr s32 SAMPLE_MAX = 32767;
+
+// The intermediate result wraps around like a 32-bit SIMD multiplication.
+s32 InterpolateLinear(s16 s1, s16 s2, u32 t)
+{
+  return static_cast<s32>((static_cast<u32>(s1) << 16) + static_cast<u32>(s2 - s1) * t) >> 16;
+}
+
+float InterpolateCubic(float p0, float p1, float p2, float p3, float t)
+{
+  const float a = 0.5f * (p3 - p0) + 1.5f * (p1 - p2);
+  const float b = p0 - 2.5f * p1 + 2.0f * p2 - 0.5f * p3;
+  const float c = 0.5f * (p2 - p0);
+  return ((a * t + b) * t + c) * t + p1;
+}
+
+float GetCubicT(u64 position)
+{
+  return static_cast<float>(position & 0xffff) * (1.0f / 65536.0f);
+}
+
+void AddSaturated(s16* output, s32 right, s32 left)
+{
+  output[0] = static_cast<s16>(std::clamp(output[0] + right, SAMPLE_MIN, SAMPLE_MAX));
+  output[1] = static_cast<s16>(std::clamp(output[1] + left, SAMPLE_MIN, SAMPLE_MAX));
+}
+
+#ifdef _M_X86_64
+// Splits the input frames loaded for two output frames, [a0 a1 | b0 b1] with one (left, right)
+// pair each, into [a0 b0] and [a1 b1] with one sample per lane.
+FUNCTION_TARGET_SSR41
+void SplitFramesSSE41(__m128i frames_a, __m128i frames_b, __m128i* first, __m128i* second)
+{
+  const __m128i frames =
+      _mm_shuffle_epi32(_mm_unpacklo_epi64(frames_a, frames_b), _MM_SHUFFLE(3, 1, 2, 0));
+  *first = _mm_cvtepi16_epi32(frames);
+  *second = _mm_cvtepi16_epi32(_mm_srli_si128(frames, 8));
+}
+
+FUNCTION_TARGET_SSR41
+__m128i LoadFramesSSE41(const s16* frames)
+{
+  return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(frames));
+}
+
+// Applies the volume to [l0 r0 l1 r1] and returns it in output order, [r0 l0 r1 l1].
+FUNCTION_TARGET_SSR41
+__m128i ApplyVolumeSSE41(__m128i samples, __m128i volume)
+{
+  samples = _mm_srai_epi32(_mm_mullo_epi32(samples, volume), 8);
+  return _mm_shuffle_epi32(samples, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+FUNCTION_TARGET_SSR41
+__m128i AddSaturatedSSE41(__m128i output, __m128i samples)
+{
+  const __m128i sum = _mm_add_epi32(output, samples);
+  return _mm_min_epi32(_mm_max_epi32(sum, _mm_set1_epi32(SAMPLE_MIN)), _mm_set1_epi32(SAMPLE_MAX));
+}
+
+FUNCTION_TARGET_SSR41
+__m128i InterpolateLinearSSE41(const s16* input, u64 position_a, u64 position_b, __m128i volume)
+{
+  __m128i s1, s2;
+  SplitFramesSSE41(LoadFramesSSE41(input + (position_a >> 16) * 2),
+                   LoadFramesSSE41(input + (position_b >> 16) * 2), &s1, &s2);
+
+  const s32 t_a = static_cast<s32>(position_a & 0xffff);
+  const s32 t_b = static_cast<s32>(position_b & 0xffff);
+  const __m128i t = _mm_setr_epi32(t_a, t_a, t_b, t_b);
+
+  __m128i result = _mm_add_epi32(_mm_slli_epi32(s1, 16), _mm_mullo_epi32(_mm_sub_epi32(s2, s1), t));
+  result = _mm_srai_epi32(result, 16);
+  return ApplyVolumeSSE41(result, volume);
+}
+
+FUNCTION_TARGET_SSR41
+__m128i InterpolateCubicSSE41(const s16* input, u64 position_a, u64 position_b, __m128i volume)
+{
+  const s16* const frames_a = input + (position_a >> 16) * 2;
+  const s16* const frames_b = input + (position_b >> 16) * 2;
+
+  __m128i i0, i1, i2, i3;
+  SplitFramesSSE41(LoadFramesSSE41(frames_a - 2), LoadFramesSSE41(frames_b - 2), &i0, &i1);
+  SplitFramesSSE41(LoadFramesSSE41(frames_a + 2), LoadFramesSSE41(frames_b + 2), &i2, &i3);
+  const __m128 p0 = _mm_cvtepi32_ps(i0);
+  const __m128 p1 = _mm_cvtepi32_ps(i1);
+  const __m128 p2 = _mm_cvtepi32_ps(i2);
+  const __m128 p3 = _mm_cvtepi32_ps(i3);
+
+  const float t_a = GetCubicT(position_a);
+  const float t_b = GetCubicT(position_b);
+  const __m128 t = _mm_setr_ps(t_a, t_a, t_b, t_b);
+
+  // Same operations in the same order as InterpolateCubic, so that the results are identical.
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 a = _mm_add_ps(_mm_mul_ps(half, _mm_sub_ps(p3, p0)),
+                              _mm_mul_ps(_mm_set1_ps(1.5f), _mm_sub_ps(p1, p2)));
+  __m128 b = _mm_sub_ps(p0, _mm_mul_ps(_mm_set1_ps(2.5f), p1));
+  b = _mm_add_ps(b, _mm_mul_ps(_mm_set1_ps(2.0f), p2));
+  b = _mm_sub_ps(b, _mm_mul_ps(half, p3));
+  const __m128 c = _mm_mul_ps(half, _mm_sub_ps(p2, p0));
+
+  __m128 result = _mm_add_ps(_mm_mul_ps(a, t), b);
+  result = _mm_add_ps(_mm_mul_ps(result, t), c);
+  result = _mm_add_ps(_mm_mul_ps(result, t), p1);
+
+  return ApplyVolumeSSE41(_mm_cvtps_epi32(result), volume);
+}
+#endif
+}  // namespace
+
+void MixLinearScalar(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+                     s32 left_volume, s32 right_volume)
+{
+  for (u32 i = 0; i < num_frames; i++, position += ratio)
+  {
+    const s16* const frames = input + (position >> 16) * 2;
+    const u32 t = position & 0xffff;
+    const s32 left = (InterpolateLinear(frames[0], frames[2], t) * left_volume) >> 8;
+    const s32 right = (InterpolateLinear(frames[1], frames[3], t) * right_volume) >> 8;
+    AddSaturated(output + i * 2, right, left);
+  }
+}
+
+void MixCubicScalar(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+                    s32 left_volume, s32 right_volume)
+{
+  for (u32 i = 0; i < num_frames; i++, position += ratio)
+  {
+    const s16* const frames = input + (position >> 16) * 2;
+    const float t = GetCubicT(position);
+    const s32 left = static_cast<s32>(
+        std::lrintf(InterpolateCubic(frames[-2], frames[0], frames[2], frames[4], t)));
+    const s32 right = static_cast<s32>(
+        std::lrintf(InterpolateCubic(frames[-1], frames[1], frames[3], frames[5], t)));
+    AddSaturated(output + i * 2, (right * right_volume) >> 8, (left * left_volume) >> 8);
+  }
+}
+
+#ifdef _M_X86_64
+FUNCTION_TARGET_SSR41
+void MixLinearSSE41(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+                    s32 left_volume, s32 right_volume)
+{
+  const __m128i volume = _mm_setr_epi32(left_volume, right_volume, left_volume, right_volume);
+
+  // Four output frames per iteration.
+  u32 i = 0;
+  for (; i + 4 <= num_frames; i += 4, position += ratio * u64{4})
+  {
+    const __m128i samples_01 =
+        InterpolateLinearSSE41(input, position, position + ratio, volume);
+    const __m128i samples_23 =
+        InterpolateLinearSSE41(input, position + ratio * u64{2}, position + ratio * u64{3}, volume);
+
+    __m128i* const out = reinterpret_cast<__m128i*>(output + i * 2);
+    const __m128i current = _mm_loadu_si128(out);
+    const __m128i mixed_01 = AddSaturatedSSE41(_mm_cvtepi16_epi32(current), samples_01);
+    const __m128i mixed_23 =
+        AddSaturatedSSE41(_mm_cvtepi16_epi32(_mm_srli_si128(current, 8)), samples_23);
+    _mm_storeu_si128(out, _mm_packs_epi32(mixed_01, mixed_23));
+  }
+
+  MixLinearScalar(output + i * 2, input, num_frames - i, position, ratio, left_volume,
+                  right_volume);
+}
+
+FUNCTION_TARGET_SSR41
+void MixCubicSSE41(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+                   s32 left_volume, s32 right_volume)
+{
+  const __m128i volume = _mm_setr_epi32(left_volume, right_volume, left_volume, right_volume);
+
+  // Two output frames per iteration.
+  u32 i = 0;
+  for (; i + 2 <= num_frames; i += 2, position += ratio * u64{2})
+  {
+    const __m128i samples = InterpolateCubicSSE41(input, position, position + ratio, volume);
+
+    __m128i* const out = reinterpret_cast<__m128i*>(output + i * 2);
+    const __m128i mixed = AddSaturatedSSE41(_mm_cvtepi16_epi32(_mm_loadl_epi64(out)), samples);
+    _mm_storel_epi64(out, _mm_packs_epi32(mixed, mixed));
+  }
+
+  MixCubicScalar(output + i * 2, input, num_frames - i, position, ratio, left_volume,
+                 right_volume);
+}
+#endif
+
+void MixLinear(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+               s32 left_volume, s32 right_volume)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bSSE4_1)
+    return MixLinearSSE41(output, input, num_frames, position, ratio, left_volume, right_volume);
+#endif
+  MixLinearScalar(output, input, num_frames, position, ratio, left_volume, right_volume);
+}
+
+void MixCubic(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+              s32 left_volume, s32 right_volume)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bSSE4_1)
+    return MixCubicSSE41(output, input, num_frames, position, ratio, left_volume, right_volume);
+#endif
+  MixCubicScalar(output, input, num_frames, position, ratio, left_volume, right_volume);
+}
+}  // namespace AudioCommon::MixerKernels
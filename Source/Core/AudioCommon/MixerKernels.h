@@ -0,0 +1,37 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Resampling kernels of Mixer::MixerFifo.
+//
+// Input frames are interleaved (left, right) sample pairs, output frames are (right, left) pairs.
+// Output frame i is interpolated at the 16.16 fixed-point input position (position + i * ratio),
+// scaled by the volumes (0 to 256) and added to the output, saturating to [-32767, 32767].
+namespace AudioCommon::MixerKernels
+{
+// Reads the input frames at and after each position.
+void MixLinear(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+               s32 left_volume, s32 right_volume);
+
+// Catmull-Rom interpolation. Also reads the frame before and the second frame after each position,
+// so input[-2] and input[-1] must be valid.
+void MixCubic(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+              s32 left_volume, s32 right_volume);
+
+// Reference implementations, also used when SSE4.1 is not available.
+void MixLinearScalar(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+                     s32 left_volume, s32 right_volume);
+void MixCubicScalar(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+                    s32 left_volume, s32 right_volume);
+
+#ifdef _M_X86_64
+// Only call these if the CPU supports SSE4.1.
+void MixLinearSSE41(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+                    s32 left_volume, s32 right_volume);
+void MixCubicSSE41(s16* output, const s16* input, u32 num_frames, u64 position, u32 ratio,
+                   s32 left_volume, s32 right_volume);
+#endif
+}  // namespace AudioCommon::MixerKernels
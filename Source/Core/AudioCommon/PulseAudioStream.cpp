@@ -1,6 +1,7 @@
 // Copyright 2009 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 
 #include "AudioCommon/PulseAudioStream.h"
@@ -14,6 +15,7 @@
 namespace
 {
 const size_t BUFFER_SAMPLES = 512;  // ~10 ms - needs to be at least 240 for surround
+const size_t SURROUND_MIN_SAMPLES = 240;
 }
 
 PulseAudio::PulseAudio() = default;
@@ -116,8 +118,15 @@ bool PulseAudio::PulseInit()
   m_pa_ba.maxlength = -1;  // max buffer, so also max latency
   m_pa_ba.minreq = -1;     // don't read every byte, try to group them _a bit_
   m_pa_ba.prebuf = -1;     // start as early as possible
+  size_t buffer_samples = BUFFER_SAMPLES;
+  if (Config::Get(Config::MAIN_AUDIO_LOW_LATENCY))
+  {
+    buffer_samples = m_mixer->GetLowLatencyOutputFrames();
+    if (!m_stereo)
+      buffer_samples = std::max(buffer_samples, SURROUND_MIN_SAMPLES);
+  }
   m_pa_ba.tlength =
-      BUFFER_SAMPLES * m_channels *
+      buffer_samples * m_channels *
       m_bytespersample;  // designed latency, only change this flag for low latency output
   pa_stream_flags flags = pa_stream_flags(PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_ADJUST_LATENCY |
                                           PA_STREAM_AUTO_TIMING_UPDATE);
@@ -158,6 +167,8 @@ void PulseAudio::StateCallback(pa_context* c)
 // on underflow, increase pulseaudio latency in ~10ms steps
 void PulseAudio::UnderflowCallback(pa_stream* s)
 {
+  m_mixer->ReportOutputUnderrun();
+
   m_pa_ba.tlength += BUFFER_SAMPLES * m_channels * m_bytespersample;
   pa_operation* op = pa_stream_set_buffer_attr(s, &m_pa_ba, nullptr, nullptr);
   pa_operation_unref(op);
@@ -197,6 +208,12 @@ void PulseAudio::WriteCallback(pa_stream* s, size_t length)
   }
 
   m_pa_error = pa_stream_write(s, buffer, trunc_length, nullptr, 0, PA_SEEK_RELATIVE);
+
+  // Timing info is kept up to date by PA_STREAM_AUTO_TIMING_UPDATE.
+  pa_usec_t latency;
+  int negative;
+  if (pa_stream_get_latency(s, &latency, &negative) == 0 && !negative)
+    m_mixer->SetOutputLatency(static_cast<u32>(latency * m_mixer->GetSampleRate() / 1000000));
 }
 
 // Callbacks that forward to internal methods (required because PulseAudio is a C API).
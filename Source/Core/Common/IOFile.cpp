@@ -78,6 +78,11 @@ bool IOFile::Open(const std::string& filename, const char openmode[],
     m_file = _tfsopen(UTF8ToTStr(filename).c_str(), UTF8ToTStr(openmode).c_str(), SH_DENYWR);
     m_good = m_file != nullptr;
   }
+  else if (sh == SharedAccess::ReadWrite)
+  {
+    m_file = _tfsopen(UTF8ToTStr(filename).c_str(), UTF8ToTStr(openmode).c_str(), SH_DENYNO);
+    m_good = m_file != nullptr;
+  }
 #else
 #ifdef ANDROID
   if (IsPathAndroidContent(filename))
@@ -24,6 +24,8 @@ enum class SharedAccess
 {
   Default,
   Read,
+  // Other processes may also write to the file while it is open. Only matters on Windows.
+  ReadWrite,
 };
 
 // simple wrapper for cstdlib file functions to
@@ -0,0 +1,765 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/LinearDiskCache.h"
+#include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
+#include "Common/Version.h"
+
+// On disk format:
+// header{
+// u32 'DCIX';
+// u32 format_version;
+// char ver[40];  // scm rev
+// u16 sizeof(key_type);
+// u16 sizeof(value_type);
+// u32 flags;  // FLAG_INDEX_STALE while entries have been appended since the index was written
+// u64 data_end;  // offset of the index, records live in [sizeof(header), data_end)
+// u64 num_index_entries;
+//}
+
+// key_value_pair{
+// u32 value_size;
+// key_type   key;
+// value_type[value_size]   value;
+// u32 entry_number;
+//}
+
+// index_entry{  // num_index_entries of these at data_end, sorted by key_hash then offset
+// u64 key_hash;
+// u64 offset;  // offset of the key_value_pair
+//}
+
+namespace Common
+{
+// Key-value store with the same guarantees as LinearDiskCache, but memory-mapped and indexed.
+//
+// Opening the cache only reads the header and the index; values are read straight out of the
+// mapping when they are looked up. Appends are thread-safe and go to the end of the record area,
+// overwriting the on-disk index, which is rewritten by Close(). If the process dies before
+// that happens, the next Open() falls back to a linear scan of the records, like
+// LinearDiskCache does on every open.
+//
+// Appending a key which already exists leaves the old record in the file as dead weight. Compact()
+// rewrites the file without those records and may be called from any thread, or be left to a
+// background thread with CompactInBackground().
+
+// K and V are some POD type
+// K : the key type
+// V : value array type
+template <typename K, typename V>
+class IndexedDiskCache
+{
+public:
+  IndexedDiskCache() = default;
+  ~IndexedDiskCache() { Close(); }
+
+  IndexedDiskCache(const IndexedDiskCache&) = delete;
+  IndexedDiskCache& operator=(const IndexedDiskCache&) = delete;
+
+  // Opens the cache, creating it if it doesn't exist or is from another version.
+  // Returns the number of unique keys in the cache.
+  u32 Open(const std::string& filename)
+  {
+    static_assert(std::is_trivially_copyable_v<K>, "K must be a trivially copyable type");
+    static_assert(std::is_trivially_copyable_v<V>, "V must be a trivially copyable type");
+    // Values are handed out as pointers into the mapping, which are only byte-aligned.
+    static_assert(alignof(V) == 1, "V must not have alignment requirements");
+
+    WaitForCompaction();
+    std::unique_lock lk(m_mutex);
+    CloseInternal();
+    OpenInternal(filename);
+    return GetUniqueEntryCount();
+  }
+
+  // Opens the cache and passes every entry to the reader, for callers which want everything
+  // loaded up front. Only the most recent value of each key is passed to the reader.
+  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  {
+    const u32 count = Open(filename);
+    ForEach([&reader](const K& key, const V* value, u32 value_size) {
+      reader.Read(key, value, value_size);
+    });
+    return count;
+  }
+
+  // Calls func(const K& key, const V* value, u32 value_size) for the most recent value of every
+  // key which was in the cache when it was opened, in the order the entries were written.
+  // func must not call back into the cache.
+  template <typename Func>
+  void ForEach(Func&& func) const
+  {
+    std::shared_lock lk(m_mutex);
+    if (!m_mapping.IsOpen())
+      return;
+
+    std::vector<u64> offsets;
+    offsets.reserve(m_index.size());
+    for (size_t i = 0; i < m_index.size(); i++)
+    {
+      if (!IsSupersededInIndex(i))
+        offsets.push_back(m_index[i].offset);
+    }
+    std::sort(offsets.begin(), offsets.end());
+
+    m_mapping.Prefetch(sizeof(Header), m_data_end_mapped - sizeof(Header));
+    for (const u64 offset : offsets)
+    {
+      K key;
+      std::memcpy(&key, m_mapping.GetData() + offset + sizeof(u32), sizeof(K));
+      func(key, GetMappedValue(offset), GetMappedValueSize(offset));
+    }
+  }
+
+  // Calls func(const V* value, u32 value_size) with the most recent value of the key.
+  // Values which were in the file when it was opened are passed without copying.
+  // func must not call back into the cache.
+  // Returns false if the key isn't in the cache.
+  template <typename Func>
+  bool Lookup(const K& key, Func&& func) const
+  {
+    const u64 hash = HashKey(key);
+    {
+      std::shared_lock lk(m_mutex);
+      if (!m_pending.contains(hash))
+      {
+        const auto offset = FindMapped(key, hash);
+        if (!offset)
+          return false;
+
+        func(GetMappedValue(*offset), GetMappedValueSize(*offset));
+        return true;
+      }
+    }
+
+    // The value (or one with the same hash) was appended during this session, so it is not
+    // covered by the mapping. Read it back from the file.
+    std::unique_lock lk(m_mutex);
+    const auto offset = FindPending(key, hash);
+    if (!offset)
+    {
+      const auto mapped_offset = FindMapped(key, hash);
+      if (!mapped_offset)
+        return false;
+
+      func(GetMappedValue(*mapped_offset), GetMappedValueSize(*mapped_offset));
+      return true;
+    }
+
+    u32 value_size;
+    std::vector<V> value;
+    if (!ReadRecordFromFile(*offset, nullptr, &value_size, &value))
+      return false;
+
+    func(value.data(), value_size);
+    return true;
+  }
+
+  bool Contains(const K& key) const
+  {
+    const u64 hash = HashKey(key);
+    std::shared_lock lk(m_mutex);
+    return FindPending(key, hash) || FindMapped(key, hash);
+  }
+
+  // Appends a key-value pair to the store. Safe to call from multiple threads.
+  void Append(const K& key, const V* value, u32 value_size)
+  {
+    const u64 hash = HashKey(key);
+
+    std::unique_lock lk(m_mutex);
+    if (!m_file.IsOpen())
+      return;
+
+    if (!(m_header.flags & FLAG_INDEX_STALE))
+    {
+      // The records we're about to write clobber the index, so mark it as stale on disk first.
+      m_header.flags |= FLAG_INDEX_STALE;
+      m_file.Seek(0, File::SeekOrigin::Begin);
+      m_file.WriteArray(&m_header, 1);
+      m_file.Flush();
+      m_file.Seek(m_data_end, File::SeekOrigin::Begin);
+    }
+
+    if (FindPending(key, hash) || FindMapped(key, hash))
+      m_num_superseded++;
+
+    const u64 offset = m_data_end;
+    m_num_entries++;
+    m_file.WriteArray(&value_size, 1);
+    m_file.WriteArray(&key, 1);
+    m_file.WriteArray(value, value_size);
+    m_file.WriteArray(&m_num_entries, 1);
+    m_data_end += GetRecordSize(value_size);
+    m_pending.emplace(hash, PendingEntry{key, offset});
+  }
+
+  void Sync()
+  {
+    std::unique_lock lk(m_mutex);
+    m_file.Flush();
+  }
+
+  // Writes the index and closes the file, after waiting for a background compaction to finish.
+  void Close()
+  {
+    WaitForCompaction();
+    std::unique_lock lk(m_mutex);
+    CloseInternal();
+  }
+
+  // Returns true if enough keys have been overwritten that compacting would be worthwhile.
+  bool NeedsCompaction() const
+  {
+    std::shared_lock lk(m_mutex);
+    return m_num_superseded > 0 && m_num_superseded * 4 >= m_num_entries;
+  }
+
+  // Rewrites the cache without superseded records. Safe to call from any thread. The records which
+  // were in the file when it was opened are copied while lookups and appends go on; only copying
+  // the records appended since then and switching to the new file block them.
+  bool Compact()
+  {
+    std::lock_guard compact_lk(m_compact_mutex);
+
+    std::string filename;
+    std::string temp_filename;
+    const u8* mapping_data;
+    File::IOFile out;
+    Header header;
+    header.Init();
+    std::vector<IndexEntry> new_index;
+    u32 entry_number = 0;
+
+    const auto write_record = [&](u64 key_hash, const K& key, const V* value, u32 value_size) {
+      new_index.push_back({key_hash, out.Tell()});
+      entry_number++;
+      out.WriteArray(&value_size, 1);
+      out.WriteArray(&key, 1);
+      out.WriteArray(value, value_size);
+      out.WriteArray(&entry_number, 1);
+    };
+
+    {
+      std::shared_lock lk(m_mutex);
+      if (!m_file.IsOpen())
+        return false;
+
+      filename = m_filename;
+      temp_filename = filename + ".tmp";
+      mapping_data = m_mapping.GetData();
+      if (!out.Open(temp_filename, "wb"))
+        return false;
+      out.WriteArray(&header, 1);
+
+      for (const IndexEntry& entry : GetLiveEntries())
+      {
+        if (entry.offset >= m_data_end_mapped)
+          continue;
+
+        K key;
+        std::memcpy(&key, m_mapping.GetData() + entry.offset + sizeof(u32), sizeof(K));
+        write_record(entry.key_hash, key, GetMappedValue(entry.offset),
+                     GetMappedValueSize(entry.offset));
+      }
+    }
+
+    std::unique_lock lk(m_mutex);
+    if (!m_file.IsOpen() || m_filename != filename || m_mapping.GetData() != mapping_data)
+    {
+      // Reopened in the meantime.
+      out.Close();
+      File::Delete(temp_filename);
+      return false;
+    }
+
+    // Mapped records which were superseded since they were copied are kept, but are followed by
+    // the newer records, so the result is still correct.
+    K key;
+    u32 value_size;
+    std::vector<V> value;
+    for (const IndexEntry& entry : GetLiveEntries())
+    {
+      if (entry.offset < m_data_end_mapped)
+        continue;
+
+      if (!ReadRecordFromFile(entry.offset, &key, &value_size, &value))
+      {
+        out.Close();
+        File::Delete(temp_filename);
+        return false;
+      }
+      write_record(entry.key_hash, key, value.data(), value_size);
+    }
+
+    SortIndex(new_index);
+    header.data_end = out.Tell();
+    header.num_index_entries = new_index.size();
+    out.WriteArray(new_index.data(), new_index.size());
+    out.Seek(0, File::SeekOrigin::Begin);
+    out.WriteArray(&header, 1);
+    const bool good = out.IsGood();
+    out.Close();
+
+    if (!good)
+    {
+      File::Delete(temp_filename);
+      return false;
+    }
+
+    m_file.Close();
+    m_mapping.Close();
+    if (!File::Rename(temp_filename, filename))
+    {
+      File::Delete(temp_filename);
+      ResetState();
+      OpenInternal(filename);
+      return false;
+    }
+
+    ResetState();
+    OpenInternal(filename);
+    return true;
+  }
+
+  // Starts Compact() on another thread if NeedsCompaction() and no compaction is running yet.
+  void CompactInBackground()
+  {
+    std::lock_guard lk(m_compaction_thread_mutex);
+    if (m_compaction_running.load() || !NeedsCompaction())
+      return;
+
+    if (m_compaction_thread.joinable())
+      m_compaction_thread.join();
+
+    m_compaction_running.store(true);
+    m_compaction_thread = std::thread([this] {
+      Compact();
+      m_compaction_running.store(false);
+    });
+  }
+
+  void WaitForCompaction()
+  {
+    std::lock_guard lk(m_compaction_thread_mutex);
+    if (m_compaction_thread.joinable())
+      m_compaction_thread.join();
+  }
+
+  // Number of records in the file, including superseded ones.
+  u32 GetEntryCount() const
+  {
+    std::shared_lock lk(m_mutex);
+    return m_num_entries;
+  }
+
+private:
+  enum : u32
+  {
+    FORMAT_VERSION = 1,
+    FLAG_INDEX_STALE = 1 << 0,
+  };
+
+  struct Header
+  {
+    void Init()
+    {
+      // Null-terminator is intentionally not copied.
+      std::memcpy(&id, "DCIX", sizeof(u32));
+      std::memcpy(ver, Common::GetScmRevGitStr().c_str(),
+                  std::min(Common::GetScmRevGitStr().size(), sizeof(ver)));
+    }
+
+    // Everything up to flags must match for the file to be usable.
+    bool IsCompatible(const Header& other) const
+    {
+      return std::memcmp(this, &other, offsetof(Header, flags)) == 0;
+    }
+
+    u32 id = 0;
+    u32 format_version = FORMAT_VERSION;
+    char ver[40] = {};
+    u16 key_t_size = sizeof(K);
+    u16 value_t_size = sizeof(V);
+    u32 flags = 0;
+    u64 data_end = sizeof(Header);
+    u64 num_index_entries = 0;
+  };
+  static_assert(std::is_standard_layout_v<Header>);
+
+  struct IndexEntry
+  {
+    u64 key_hash;
+    u64 offset;
+  };
+
+  struct PendingEntry
+  {
+    K key;
+    u64 offset;
+  };
+
+  static u64 HashKey(const K& key)
+  {
+    // FNV-1a. Keys are small and collisions are resolved by comparing the full key.
+    u64 hash = 0xcbf29ce484222325ULL;
+    const u8* bytes = reinterpret_cast<const u8*>(&key);
+    for (size_t i = 0; i < sizeof(K); i++)
+      hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    return hash;
+  }
+
+  static constexpr u64 GetRecordSize(u32 value_size)
+  {
+    return sizeof(u32) + sizeof(K) + u64{value_size} * sizeof(V) + sizeof(u32);
+  }
+
+  static void SortIndex(std::vector<IndexEntry>& index)
+  {
+    std::sort(index.begin(), index.end(), [](const IndexEntry& a, const IndexEntry& b) {
+      return a.key_hash != b.key_hash ? a.key_hash < b.key_hash : a.offset < b.offset;
+    });
+  }
+
+  u32 GetMappedValueSize(u64 offset) const
+  {
+    u32 value_size;
+    std::memcpy(&value_size, m_mapping.GetData() + offset, sizeof(u32));
+    return value_size;
+  }
+
+  const V* GetMappedValue(u64 offset) const
+  {
+    return reinterpret_cast<const V*>(m_mapping.GetData() + offset + sizeof(u32) + sizeof(K));
+  }
+
+  bool MappedKeyEquals(u64 offset, const K& key) const
+  {
+    return std::memcmp(m_mapping.GetData() + offset + sizeof(u32), &key, sizeof(K)) == 0;
+  }
+
+  // Returns true if a later entry in the (sorted) index has the same key as entry i.
+  bool IsSupersededInIndex(size_t i) const
+  {
+    for (size_t j = i + 1; j < m_index.size() && m_index[j].key_hash == m_index[i].key_hash; j++)
+    {
+      if (std::memcmp(m_mapping.GetData() + m_index[i].offset + sizeof(u32),
+                      m_mapping.GetData() + m_index[j].offset + sizeof(u32), sizeof(K)) == 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::optional<u64> FindMapped(const K& key, u64 hash) const
+  {
+    const auto range = std::equal_range(
+        m_index.begin(), m_index.end(), IndexEntry{hash, 0},
+        [](const IndexEntry& a, const IndexEntry& b) { return a.key_hash < b.key_hash; });
+
+    // Entries with the same hash are sorted by offset, so search backwards for the newest value.
+    for (auto it = range.second; it != range.first;)
+    {
+      --it;
+      if (MappedKeyEquals(it->offset, key))
+        return it->offset;
+    }
+    return std::nullopt;
+  }
+
+  std::optional<u64> FindPending(const K& key, u64 hash) const
+  {
+    std::optional<u64> result;
+    const auto range = m_pending.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      const PendingEntry& entry = it->second;
+      if ((!result || entry.offset > *result) &&
+          std::memcmp(&entry.key, &key, sizeof(K)) == 0)
+      {
+        result = entry.offset;
+      }
+    }
+    return result;
+  }
+
+  // Reads a record which was appended after the file was mapped. Requires the exclusive lock, as
+  // it moves the file position (which is restored to the end of the records afterwards).
+  bool ReadRecordFromFile(u64 offset, K* key, u32* value_size, std::vector<V>* value) const
+  {
+    u32 size = 0;
+    K temp_key;
+    bool good = m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadArray(&size, 1) &&
+                m_file.ReadArray(&temp_key, 1);
+    if (good)
+    {
+      value->resize(size);
+      good = m_file.ReadArray(value->data(), size);
+    }
+    m_file.ClearError();
+    m_file.Seek(m_data_end, File::SeekOrigin::Begin);
+
+    if (key)
+      *key = temp_key;
+    *value_size = size;
+    return good;
+  }
+
+  std::vector<IndexEntry> GetLiveEntries() const
+  {
+    std::vector<IndexEntry> live;
+    live.reserve(m_index.size() + m_pending.size());
+    for (size_t i = 0; i < m_index.size(); i++)
+    {
+      K key;
+      std::memcpy(&key, m_mapping.GetData() + m_index[i].offset + sizeof(u32), sizeof(K));
+      if (!IsSupersededInIndex(i) && !FindPending(key, m_index[i].key_hash))
+        live.push_back(m_index[i]);
+    }
+    for (const auto& [hash, entry] : m_pending)
+    {
+      if (FindPending(entry.key, hash) == entry.offset)
+        live.push_back({hash, entry.offset});
+    }
+    return live;
+  }
+
+  u32 GetUniqueEntryCount() const
+  {
+    if (!m_mapping.IsOpen())
+      return 0;
+
+    u32 count = 0;
+    for (size_t i = 0; i < m_index.size(); i++)
+    {
+      if (!IsSupersededInIndex(i))
+        count++;
+    }
+    return count;
+  }
+
+  // Reads the index written by CloseInternal() from the mapping. Fails if any entry does not point
+  // at a whole record before the index, or if the entries are not sorted.
+  bool ReadIndex(const Header& file_header)
+  {
+    const u64 size = m_mapping.GetSize();
+    const u64 data_end = file_header.data_end;
+    if (data_end < sizeof(Header) || data_end > size ||
+        file_header.num_index_entries > (size - data_end) / sizeof(IndexEntry))
+    {
+      return false;
+    }
+
+    std::vector<IndexEntry> index(file_header.num_index_entries);
+    std::memcpy(index.data(), m_mapping.GetData() + data_end, index.size() * sizeof(IndexEntry));
+    for (size_t i = 0; i < index.size(); i++)
+    {
+      const IndexEntry& entry = index[i];
+      if (entry.offset < sizeof(Header) || entry.offset > data_end ||
+          data_end - entry.offset < GetRecordSize(0) ||
+          data_end - entry.offset < GetRecordSize(GetMappedValueSize(entry.offset)))
+      {
+        return false;
+      }
+
+      K key;
+      std::memcpy(&key, m_mapping.GetData() + entry.offset + sizeof(u32), sizeof(K));
+      if (HashKey(key) != entry.key_hash)
+        return false;
+
+      const IndexEntry* previous = i > 0 ? &index[i - 1] : nullptr;
+      if (previous && (previous->key_hash > entry.key_hash ||
+                       (previous->key_hash == entry.key_hash && previous->offset >= entry.offset)))
+      {
+        return false;
+      }
+    }
+
+    m_index = std::move(index);
+    m_data_end = data_end;
+    m_num_entries = static_cast<u32>(m_index.size());
+    return true;
+  }
+
+  // Reads the index from the mapping, or rebuilds it from the records if it is stale or damaged.
+  bool LoadIndex()
+  {
+    const u8* data = m_mapping.GetData();
+    const u64 size = m_mapping.GetSize();
+    if (size < sizeof(Header))
+      return false;
+
+    Header file_header;
+    std::memcpy(&file_header, data, sizeof(Header));
+    if (!m_header.IsCompatible(file_header))
+      return false;
+
+    m_header.flags = file_header.flags;
+    if ((file_header.flags & FLAG_INDEX_STALE) || !ReadIndex(file_header))
+    {
+      if (!(file_header.flags & FLAG_INDEX_STALE))
+      {
+        WARN_LOG_FMT(COMMON, "Discarding damaged index of {}", m_filename);
+        // Have CloseInternal() write a good one.
+        m_header.flags |= FLAG_INDEX_STALE;
+      }
+
+      // The index wasn't written out, scan the records instead.
+      u64 offset = sizeof(Header);
+      while (offset + sizeof(u32) + sizeof(K) <= size)
+      {
+        const u64 record_size = GetRecordSize(GetMappedValueSize(offset));
+        if (record_size > size - offset)
+          break;
+
+        u32 entry_number;
+        std::memcpy(&entry_number, data + offset + record_size - sizeof(u32), sizeof(u32));
+        if (entry_number != m_num_entries + 1)
+          break;
+
+        K key;
+        std::memcpy(&key, data + offset + sizeof(u32), sizeof(K));
+        m_index.push_back({HashKey(key), offset});
+        m_num_entries++;
+        offset += record_size;
+      }
+      m_data_end = offset;
+      SortIndex(m_index);
+    }
+
+    m_data_end_mapped = m_data_end;
+    for (size_t i = 0; i < m_index.size(); i++)
+    {
+      if (IsSupersededInIndex(i))
+        m_num_superseded++;
+    }
+    return true;
+  }
+
+  // The file is opened for writing once and stays open, and it is only ever truncated while it is
+  // not mapped: Windows refuses to truncate mapped files, and elsewhere the mapping would fault.
+  void OpenInternal(const std::string& filename)
+  {
+    m_filename = filename;
+    m_header.Init();
+
+    if (!File::Exists(filename))
+    {
+      if (m_file.Open(filename, "w+b"))
+      {
+        m_file.WriteArray(&m_header, 1);
+        m_file.Flush();
+      }
+      return;
+    }
+
+    if (!m_file.Open(filename, "r+b"))
+    {
+      // Most likely in use by another instance. Leave it alone and run without the cache.
+      ERROR_LOG_FMT(COMMON, "Failed to open {} for writing, not using it", filename);
+      return;
+    }
+
+    if (m_mapping.Open(filename) && LoadIndex() &&
+        m_file.Seek(m_data_end, File::SeekOrigin::Begin))
+    {
+      return;
+    }
+
+    // Empty file or bad header. Recreate the file in place.
+    m_mapping.Close();
+    ResetState();
+    m_header.Init();
+    m_file.Resize(0);
+    m_file.Seek(0, File::SeekOrigin::Begin);
+    m_file.WriteArray(&m_header, 1);
+    m_file.Flush();
+  }
+
+  void CloseInternal()
+  {
+    // The index may be shorter than what it overwrites, so the file may be truncated below.
+    m_mapping.Close();
+
+    if (m_file.IsOpen())
+    {
+      if (m_header.flags & FLAG_INDEX_STALE)
+      {
+        std::vector<IndexEntry> index = m_index;
+        index.reserve(m_index.size() + m_pending.size());
+        for (const auto& [hash, entry] : m_pending)
+          index.push_back({hash, entry.offset});
+        SortIndex(index);
+
+        m_file.Seek(m_data_end, File::SeekOrigin::Begin);
+        m_file.WriteArray(index.data(), index.size());
+        m_file.Resize(m_data_end + index.size() * sizeof(IndexEntry));
+
+        m_header.flags &= ~FLAG_INDEX_STALE;
+        m_header.data_end = m_data_end;
+        m_header.num_index_entries = index.size();
+        m_file.Seek(0, File::SeekOrigin::Begin);
+        m_file.WriteArray(&m_header, 1);
+      }
+      m_file.Close();
+    }
+
+    ResetState();
+  }
+
+  void ResetState()
+  {
+    m_header = {};
+    m_index.clear();
+    m_pending.clear();
+    m_data_end = sizeof(Header);
+    m_data_end_mapped = 0;
+    m_num_entries = 0;
+    m_num_superseded = 0;
+  }
+
+  std::string m_filename;
+  Header m_header;
+  // Mutable as lookups of entries appended this session read them back through the file.
+  mutable File::IOFile m_file;
+  MappedFile m_mapping;
+
+  // Index of the records covered by the mapping.
+  std::vector<IndexEntry> m_index;
+  // Records appended since the file was mapped, keyed by hash.
+  std::unordered_multimap<u64, PendingEntry> m_pending;
+
+  u64 m_data_end = sizeof(Header);
+  u64 m_data_end_mapped = 0;
+  u32 m_num_entries = 0;
+  u32 m_num_superseded = 0;
+
+  mutable std::shared_mutex m_mutex;
+  // Serializes Compact(), which drops m_mutex between copying the mapped and the appended records.
+  std::mutex m_compact_mutex;
+
+  std::mutex m_compaction_thread_mutex;
+  std::thread m_compaction_thread;
+  std::atomic<bool> m_compaction_running = false;
+};
+}  // namespace Common
@@ -80,6 +80,8 @@ public:
     layer->Set(Config::MAIN_SYNC_GPU_MAX_DISTANCE, m_settings.sync_gpu_max_distance);
     layer->Set(Config::MAIN_SYNC_GPU_MIN_DISTANCE, m_settings.sync_gpu_min_distance);
     layer->Set(Config::MAIN_SYNC_GPU_OVERCLOCK, m_settings.sync_gpu_overclock);
+    // The decode stage reads ahead of the emulated GPU, which changes CP register timings.
+    layer->Set(Config::MAIN_GPU_PIPELINING, false);
 
     layer->Set(Config::MAIN_JIT_FOLLOW_BRANCH, m_settings.jit_follow_branch);
     layer->Set(Config::MAIN_FAST_DISC_SPEED, m_settings.fast_disc_speed);
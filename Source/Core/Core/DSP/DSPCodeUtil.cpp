@@ -188,4 +188,30 @@ bool DumpDSPCode(const u8* code_be, size_t size_in_bytes, u32 crc)
   return File::WriteStringToFile(text_file, text);
 }
 
+bool DumpJITProfile(const std::vector<JIT::BlockStat>& stats, u32 crc)
+{
+  const std::string filename =
+      File::GetUserPath(D_DUMPDSP_IDX) + fmt::format("DSP_UC_{:08X}_profile.txt", crc);
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    ERROR_LOG_FMT(DSPLLE, "Can't write DSP JIT profile to file '{}'", filename);
+    return false;
+  }
+
+  u64 cycles_sum = 0;
+  for (const JIT::BlockStat& stat : stats)
+    cycles_sum += stat.cycles;
+
+  f.WriteString("addr\tsize\trunCount\tcycles\tpercent\n");
+  for (const JIT::BlockStat& stat : stats)
+  {
+    const double percent =
+        100.0 * static_cast<double>(stat.cycles) / static_cast<double>(cycles_sum);
+    f.WriteString(fmt::format("{:04x}\t{}\t{}\t{}\t{:.2f}\n", stat.address, stat.size,
+                              stat.run_count, stat.cycles, percent));
+  }
+  return true;
+}
 }  // namespace DSP
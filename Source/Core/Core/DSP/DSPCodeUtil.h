@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/DSP/Jit/DSPEmitterBase.h"
 
 namespace DSP
 {
@@ -24,4 +25,6 @@ std::optional<std::vector<u16>> LoadBinary(const std::string& filename);
 bool SaveBinary(const std::vector<u16>& code, const std::string& filename);
 
 bool DumpDSPCode(const u8* code_be, size_t size_in_bytes, u32 crc);
+// Writes the block profile of the ucode with the given CRC next to the ucode dump.
+bool DumpJITProfile(const std::vector<JIT::BlockStat>& stats, u32 crc);
 }  // namespace DSP
@@ -8,6 +8,7 @@
 #include <array>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -18,6 +19,7 @@
 
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCodeUtil.h"
 #include "Core/DSP/DSPHost.h"
 #include "Core/DSP/Interpreter/DSPInterpreter.h"
 #include "Core/DSP/Jit/DSPEmitterBase.h"
@@ -420,7 +422,12 @@ bool DSPCore::Initialize(const DSPInitOptions& opts)
 
   // Initialize JIT, if necessary
   if (opts.core_type == DSPInitOptions::CoreType::JIT64)
+  {
     m_dsp_jit = JIT::CreateDSPEmitter(*this);
+    m_dsp_jit->SetProfilingEnabled(opts.jit_profiling);
+  }
+  m_jit_profiling = opts.jit_profiling;
+  m_profiled_iram_crc = m_dsp.GetIRAMCRC();
 
   m_dsp_cap.reset(opts.capture_logger);
 
@@ -435,6 +442,7 @@ void DSPCore::Shutdown()
 
   m_core_state = State::Stopped;
 
+  DumpJITProfile();
   m_dsp_jit.reset();
   m_dsp.Shutdown();
   m_dsp_cap.reset();
@@ -496,7 +504,19 @@ void DSPCore::ClearIRAM()
   if (!m_dsp_jit)
     return;
 
+  DumpJITProfile();
   m_dsp_jit->ClearIRAM();
+  m_profiled_iram_crc = m_dsp.GetIRAMCRC();
+}
+
+void DSPCore::DumpJITProfile()
+{
+  if (!m_jit_profiling || !m_dsp_jit)
+    return;
+
+  const std::vector<JIT::BlockStat> stats = m_dsp_jit->GetProfileResults();
+  if (!stats.empty())
+    DSP::DumpJITProfile(stats, m_profiled_iram_crc);
 }
 
 void DSPCore::SetState(State new_state)
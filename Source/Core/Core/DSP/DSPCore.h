@@ -301,6 +301,11 @@ struct DSPInitOptions
   };
   CoreType core_type = CoreType::JIT64;
 
+  // Whether the JIT counts how often each block runs. The counts are dumped next to the ucode
+  // dumps whenever the ucode changes or the DSP is shut down.
+  // Default: false.
+  bool jit_profiling = false;
+
   // Optional capture logger used to log internal DSP data transfers.
   // Default: dummy implementation, does nothing.
   DSPCaptureLogger* capture_logger;
@@ -408,6 +413,7 @@ struct SDSP
 
   // Sets the calculated IRAM CRC for debugging purposes.
   void SetIRAMCRC(u32 crc) { m_iram_crc = crc; }
+  u32 GetIRAMCRC() const { return m_iram_crc; }
 
   // Saves and loads any necessary state.
   void DoState(PointerWrap& p);
@@ -509,7 +515,8 @@ public:
   // Resets DSP state as if the reset exception vector has been taken.
   void Reset();
 
-  // Clears the DSP instruction RAM.
+  // Clears the DSP instruction RAM. If JIT profiling is enabled, the profile of the previous ucode
+  // is dumped first.
   void ClearIRAM();
 
   // Dictates whether or not the DSP is currently stopped, running or stepping
@@ -579,10 +586,15 @@ public:
   const Interpreter::Interpreter& GetInterpreter() const { return *m_dsp_interpreter; }
 
 private:
+  void DumpJITProfile();
+
   SDSP m_dsp;
   DSPBreakpoints m_dsp_breakpoints;
   State m_core_state = State::Stopped;
   bool m_init_hax = false;
+  bool m_jit_profiling = false;
+  // CRC of the ucode the current JIT profile belongs to.
+  u32 m_profiled_iram_crc = 0;
   std::unique_ptr<Interpreter::Interpreter> m_dsp_interpreter;
   std::unique_ptr<JIT::DSPEmitter> m_dsp_jit;
   std::unique_ptr<DSPCaptureLogger> m_dsp_cap;
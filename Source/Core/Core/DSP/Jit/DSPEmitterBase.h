@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 
@@ -16,6 +17,18 @@ class DSPCore;
 
 namespace DSP::JIT
 {
+struct BlockStat
+{
+  u16 address;
+  // Number of instructions in the whole block.
+  u16 size;
+  // Entries into the block, including every iteration of a loop linked back into it.
+  u64 run_count;
+  // Cycles the block was accounted for. Runs that leave the block early, like loop iterations
+  // that end before the last instruction, only count the instructions up to where they left.
+  u64 cycles;
+};
+
 class DSPEmitter
 {
 public:
@@ -25,6 +38,11 @@ public:
   virtual void ClearIRAM() = 0;
 
   virtual void DoState(PointerWrap& p) = 0;
+
+  // Only affects blocks compiled afterwards. Clearing IRAM also clears the counters.
+  virtual void SetProfilingEnabled(bool enabled) = 0;
+  // Returns the blocks that ran at least once, sorted by the cycles spent in them.
+  virtual std::vector<BlockStat> GetProfileResults() const = 0;
 };
 
 class DSPEmitterNull final : public DSPEmitter
@@ -33,6 +51,8 @@ public:
   u16 RunCycles(u16) override { return 0; }
   void ClearIRAM() override {}
   void DoState(PointerWrap&) override {}
+  void SetProfilingEnabled(bool) override {}
+  std::vector<BlockStat> GetProfileResults() const override { return {}; }
 };
 
 std::unique_ptr<DSPEmitter> CreateDSPEmitter(DSPCore& dsp);
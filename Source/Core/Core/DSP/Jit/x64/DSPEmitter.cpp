@@ -31,7 +31,8 @@ constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
 
 DSPEmitter::DSPEmitter(DSPCore& dsp)
     : m_compile_status_register{SR_INT_ENABLE | SR_EXT_INT_ENABLE}, m_blocks(MAX_BLOCKS),
-      m_block_size(MAX_BLOCKS), m_block_links(MAX_BLOCKS), m_dsp_core{dsp}
+      m_block_size(MAX_BLOCKS), m_block_links(MAX_BLOCKS), m_block_run_counts(MAX_BLOCKS),
+      m_block_cycle_counts(MAX_BLOCKS), m_dsp_core{dsp}
 {
   x64::InitInstructionTables();
   AllocCodeSpace(COMPILED_CODE_SIZE);
@@ -80,9 +81,33 @@ void DSPEmitter::ClearIRAM()
     m_block_size[i] = 0;
     m_unresolved_jumps[i].clear();
   }
+  std::fill(m_block_run_counts.begin(), m_block_run_counts.end(), 0);
+  std::fill(m_block_cycle_counts.begin(), m_block_cycle_counts.end(), 0);
   m_dsp_core.DSPState().reset_dspjit_codespace = true;
 }
 
+void DSPEmitter::SetProfilingEnabled(bool enabled)
+{
+  m_profile_blocks = enabled;
+}
+
+std::vector<BlockStat> DSPEmitter::GetProfileResults() const
+{
+  std::vector<BlockStat> stats;
+  for (size_t i = 0; i < MAX_BLOCKS; i++)
+  {
+    if (m_block_run_counts[i] == 0)
+      continue;
+
+    stats.push_back({static_cast<u16>(i), m_block_size[i], m_block_run_counts[i],
+                     m_block_cycle_counts[i]});
+  }
+
+  std::sort(stats.begin(), stats.end(),
+            [](const BlockStat& a, const BlockStat& b) { return a.cycles > b.cycles; });
+  return stats;
+}
+
 void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
 {
   ClearCodeSpace();
@@ -116,6 +141,7 @@ void DSPEmitter::checkExceptions(u32 retval)
   DSPJitRegCache c(m_gpr);
   m_gpr.SaveRegs();
   ABI_CallFunctionP(CheckExceptionsThunk, &m_dsp_core);
+  WriteProfileCycles(static_cast<u16>(retval));
   MOV(32, R(EAX), Imm32(retval));
   JMP(m_return_dispatcher, Jump::Near);
   m_gpr.LoadRegs(false);
@@ -236,6 +262,12 @@ void DSPEmitter::Compile(u16 start_addr)
 
   m_block_link_entry = GetCodePtr();
 
+  if (m_profile_blocks)
+  {
+    MOV(64, R(RAX), ImmPtr(&m_block_run_counts[start_addr]));
+    ADD(64, MatR(RAX), Imm8(1));
+  }
+
   m_compile_pc = start_addr;
   bool fixup_pc = false;
   m_block_size[start_addr] = 0;
@@ -281,15 +313,14 @@ void DSPEmitter::Compile(u16 start_addr)
       // end of each block and in this order
       DSPJitRegCache c(m_gpr);
       HandleLoop();
+      if (!analyzer.IsIdleSkip(start_addr))
+        WriteLoopLink();
       m_gpr.SaveRegs();
-      if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-      {
-        MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-      }
-      else
-      {
-        MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-      }
+      const u16 cycles = !Host::OnThread() && analyzer.IsIdleSkip(start_addr) ?
+                             DSP_IDLE_SKIP_CYCLES :
+                             m_block_size[start_addr];
+      WriteProfileCycles(cycles);
+      MOV(16, R(EAX), Imm16(cycles));
       JMP(m_return_dispatcher, Jump::Near);
       m_gpr.LoadRegs(false);
       m_gpr.FlushRegs(c, false);
@@ -318,14 +349,11 @@ void DSPEmitter::Compile(u16 start_addr)
         DSPJitRegCache c(m_gpr);
         // don't update g_dsp.pc -- the branch insn already did
         m_gpr.SaveRegs();
-        if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-        {
-          MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-        }
-        else
-        {
-          MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-        }
+        const u16 cycles = !Host::OnThread() && analyzer.IsIdleSkip(start_addr) ?
+                               DSP_IDLE_SKIP_CYCLES :
+                               m_block_size[start_addr];
+        WriteProfileCycles(cycles);
+        MOV(16, R(EAX), Imm16(cycles));
         JMP(m_return_dispatcher, Jump::Near);
         m_gpr.LoadRegs(false);
         m_gpr.FlushRegs(c, false);
@@ -381,14 +409,11 @@ void DSPEmitter::Compile(u16 start_addr)
   }
 
   m_gpr.SaveRegs();
-  if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-  {
-    MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-  }
-  else
-  {
-    MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-  }
+  const u16 cycles = !Host::OnThread() && analyzer.IsIdleSkip(start_addr) ?
+                         DSP_IDLE_SKIP_CYCLES :
+                         m_block_size[start_addr];
+  WriteProfileCycles(cycles);
+  MOV(16, R(EAX), Imm16(cycles));
   JMP(m_return_dispatcher, Jump::Near);
 }
 
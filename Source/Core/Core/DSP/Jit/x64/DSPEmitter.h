@@ -33,6 +33,8 @@ public:
   u16 RunCycles(u16 cycles) override;
   void DoState(PointerWrap& p) override;
   void ClearIRAM() override;
+  void SetProfilingEnabled(bool enabled) override;
+  std::vector<BlockStat> GetProfileResults() const override;
 
   // Ext commands
   void l(UDSPInstruction opc);
@@ -213,6 +215,8 @@ private:
 
   void WriteBranchExit();
   void WriteBlockLink(u16 dest);
+  void WriteLoopLink();
+  void WriteProfileCycles(u16 cycles);
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
@@ -319,6 +323,13 @@ private:
   std::vector<DSPCompiledCode> m_blocks;
   std::vector<u16> m_block_size;
   std::vector<Block> m_block_links;
+  // Runs of each block, when profiling. Incremented at the link entry, so that linked blocks and
+  // loop iterations are counted as well.
+  std::vector<u64> m_block_run_counts;
+  // Cycles accounted to each block, when profiling. Added at every exit of the block with the
+  // cycles of the part that actually ran, which may be less than the whole block.
+  std::vector<u64> m_block_cycle_counts;
+  bool m_profile_blocks = false;
   Block m_block_link_entry;
 
   std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
@@ -101,14 +101,11 @@ void DSPEmitter::WriteBranchExit()
 {
   DSPJitRegCache c(m_gpr);
   m_gpr.SaveRegs();
-  if (m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
-  {
-    MOV(16, R(EAX), Imm16(0x1000));
-  }
-  else
-  {
-    MOV(16, R(EAX), Imm16(m_block_size[m_start_address]));
-  }
+  const u16 cycles = m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address) ?
+                         0x1000 :
+                         m_block_size[m_start_address];
+  WriteProfileCycles(cycles);
+  MOV(16, R(EAX), Imm16(cycles));
   JMP(m_return_dispatcher, Jump::Near);
   m_gpr.LoadRegs(false);
   m_gpr.FlushRegs(c, false);
@@ -130,6 +127,7 @@ void DSPEmitter::WriteBlockLink(u16 dest)
 
       SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
       MOV(16, MatR(RAX), R(ECX));
+      WriteProfileCycles(m_block_size[m_start_address]);
       JMP(m_block_links[dest], Jump::Near);
       SetJumpTarget(notEnoughCycles);
     }
@@ -142,6 +140,41 @@ void DSPEmitter::WriteBlockLink(u16 dest)
   }
 }
 
+// Loops that start at the start of the current block jump straight back into it while there are
+// enough cycles left, instead of returning to the dispatcher after every iteration. This is a
+// plain back edge that checks the cycle budget on every iteration; it does not depend on the loop
+// counter, so LOOP, BLOOP and their immediate forms are all handled the same way. This is where
+// ucodes spend most of their time, e.g. in the per-sample loops of the mixers.
+//
+// Only the instructions up to the loop end run in an iteration, which is the block size so far.
+void DSPEmitter::WriteLoopLink()
+{
+  m_gpr.FlushRegs();
+  CMP(16, M_SDSP_pc(), Imm16(m_start_address));
+  FixupBranch notLoopStart = J_CC(CC_NE);
+
+  MOV(64, R(RAX), ImmPtr(&m_cycles_left));
+  MOV(16, R(ECX), MatR(RAX));
+  CMP(16, R(ECX), Imm16(2 * m_block_size[m_start_address]));
+  FixupBranch notEnoughCycles = J_CC(CC_BE);
+
+  SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
+  MOV(16, MatR(RAX), R(ECX));
+  WriteProfileCycles(m_block_size[m_start_address]);
+  JMP(m_block_link_entry, Jump::Near);
+  SetJumpTarget(notEnoughCycles);
+  SetJumpTarget(notLoopStart);
+}
+
+void DSPEmitter::WriteProfileCycles(u16 cycles)
+{
+  if (!m_profile_blocks)
+    return;
+
+  MOV(64, R(RAX), ImmPtr(&m_block_cycle_counts[m_start_address]));
+  ADD(64, MatR(RAX), Imm32(cycles));
+}
+
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
 {
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
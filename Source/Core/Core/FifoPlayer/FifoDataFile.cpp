@@ -9,6 +9,9 @@
 #include <string>
 #include <vector>
 
+#include <zstd.h>
+
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
@@ -16,11 +19,17 @@
 #include "Core/System.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 5;
+constexpr u32 VERSION_NUMBER = 6;
 constexpr u32 MIN_LOADER_VERSION = 1;
 // This value is only used if the DFF file was created with overridden RAM sizes.
 // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
 constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+constexpr u32 MIN_LOADER_VERSION_FOR_COMPRESSION = 6;
+
+// Favors speed, as saving happens right after recording, while the emulator is still running.
+constexpr int COMPRESSION_LEVEL = 3;
+// Number of decompressed frames to keep around when streaming a compressed file.
+constexpr size_t FRAME_CACHE_SIZE = 8;
 
 #pragma pack(push, 1)
 
@@ -46,7 +55,9 @@ struct FileHeader
   // will crash and burn with mismatched settings.  See PR #8722.
   u32 mem1_size;
   u32 mem2_size;
-  u8 reserved[32];
+  // Only used by compressed files, which store texture memory as a compressed chunk.
+  u32 texMemCompressedSize;
+  u8 reserved[28];
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 
@@ -62,6 +73,22 @@ struct FileFrameInfo
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
+// Index entry of a compressed file. The chunk holds the frame's FileMemoryUpdate list, followed
+// by its FIFO data and then the data of all memory updates. The dataOffset of each memory update
+// is relative to the start of the decompressed chunk.
+struct FileCompressedFrameInfo
+{
+  u64 chunkOffset;
+  u32 chunkSize;
+  u32 uncompressedSize;
+  u32 fifoDataSize;
+  u32 fifoStart;
+  u32 fifoEnd;
+  u32 numMemoryUpdates;
+  u8 reserved[32];
+};
+static_assert(sizeof(FileCompressedFrameInfo) == 64, "FileCompressedFrameInfo should be 64 bytes");
+
 struct FileMemoryUpdate
 {
   u32 fifoPosition;
@@ -75,6 +102,44 @@ static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 byt
 
 #pragma pack(pop)
 
+namespace
+{
+struct ZstdCCtxDeleter
+{
+  void operator()(ZSTD_CCtx* ctx) const { ZSTD_freeCCtx(ctx); }
+};
+
+std::vector<u8> SerializeFrame(const FifoFrameInfo& frame)
+{
+  const size_t updates_size = frame.memoryUpdates.size() * sizeof(FileMemoryUpdate);
+  size_t size = updates_size + frame.fifoData.size();
+  for (const MemoryUpdate& update : frame.memoryUpdates)
+    size += update.data.size();
+
+  std::vector<u8> chunk(size);
+  std::copy(frame.fifoData.begin(), frame.fifoData.end(), chunk.begin() + updates_size);
+
+  size_t data_offset = updates_size + frame.fifoData.size();
+  for (size_t i = 0; i < frame.memoryUpdates.size(); ++i)
+  {
+    const MemoryUpdate& srcUpdate = frame.memoryUpdates[i];
+
+    FileMemoryUpdate dstUpdate{};
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.dataOffset = data_offset;
+    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+    dstUpdate.type = srcUpdate.type;
+    std::memcpy(chunk.data() + i * sizeof(FileMemoryUpdate), &dstUpdate, sizeof(dstUpdate));
+
+    std::copy(srcUpdate.data.begin(), srcUpdate.data.end(), chunk.begin() + data_offset);
+    data_offset += srcUpdate.data.size();
+  }
+
+  return chunk;
+}
+}  // namespace
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -99,12 +164,64 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
+bool FifoDataFile::IsCompressed() const
+{
+  return GetFlag(FLAG_COMPRESSED);
+}
+
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  m_Frames.emplace_back().frame = std::make_shared<FifoFrameInfo>(frameInfo);
 }
 
-bool FifoDataFile::Save(const std::string& filename)
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  const FrameEntry& entry = m_Frames[frame];
+  if (entry.frame)
+    return entry.frame;
+
+  std::lock_guard lk(m_chunk_mutex);
+
+  for (const auto& [cached_frame, cached_info] : m_chunk_cache)
+  {
+    if (cached_frame == frame)
+      return cached_info;
+  }
+
+  std::shared_ptr<const FifoFrameInfo> info = LoadFrameChunk(entry);
+  if (!info)
+  {
+    PanicAlertFmtT("Failed to read frame {0} of the DFF file.", frame);
+
+    // Play back an empty frame, which keeps the FIFO bounds valid.
+    auto empty_frame = std::make_shared<FifoFrameInfo>();
+    empty_frame->fifoStart = entry.fifo_start;
+    empty_frame->fifoEnd = entry.fifo_end;
+    info = std::move(empty_frame);
+  }
+
+  if (m_chunk_cache.size() >= FRAME_CACHE_SIZE)
+    m_chunk_cache.erase(m_chunk_cache.begin());
+  m_chunk_cache.emplace_back(frame, info);
+
+  return info;
+}
+
+bool FifoDataFile::Save(const std::string& filename, bool compressed)
+{
+  // The frames of a loaded compressed file are read from disk while saving, possibly from the
+  // file being replaced. Write a new file and only replace the old one once it's complete.
+  const std::string temp_filename = File::GetTempFilenameForAtomicWrite(filename);
+  if (!WriteFile(temp_filename, compressed) || !File::Rename(temp_filename, filename))
+  {
+    File::Delete(temp_filename, File::IfAbsentBehavior::NoConsoleWarning);
+    return false;
+  }
+
+  return true;
+}
+
+bool FifoDataFile::WriteFile(const std::string& filename, bool compressed)
 {
   File::IOFile file;
   if (!file.Open(filename, "wb"))
@@ -113,9 +230,10 @@ bool FifoDataFile::Save(const std::string& filename)
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
-  // Add space for frame list
+  // Add space for frame list. Compressed files store it at the end instead.
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  if (!compressed)
+    PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
@@ -130,14 +248,32 @@ bool FifoDataFile::Save(const std::string& filename)
   file.WriteArray(m_XFRegs);
 
   u64 texMemOffset = file.Tell();
-  file.WriteArray(m_TexMem);
+  u32 texMemCompressedSize = 0;
+  if (compressed)
+  {
+    std::vector<u8> chunk(ZSTD_compressBound(TEX_MEM_SIZE));
+    const size_t size = ZSTD_compress(chunk.data(), chunk.size(), m_TexMem.data(), TEX_MEM_SIZE,
+                                      COMPRESSION_LEVEL);
+    if (ZSTD_isError(size))
+      return false;
+
+    file.WriteBytes(chunk.data(), size);
+    texMemCompressedSize = static_cast<u32>(size);
+  }
+  else
+  {
+    file.WriteArray(m_TexMem);
+  }
 
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
+  // Maintain backwards compatability so long as the RAM sizes aren't overridden and the file isn't
+  // compressed.
+  if (compressed)
+    header.min_loader_version = MIN_LOADER_VERSION_FOR_COMPRESSION;
+  else if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
     header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
   else
     header.min_loader_version = MIN_LOADER_VERSION;
@@ -156,11 +292,15 @@ bool FifoDataFile::Save(const std::string& filename)
 
   header.texMemOffset = texMemOffset;
   header.texMemSize = TEX_MEM_SIZE;
+  header.texMemCompressedSize = texMemCompressedSize;
+
+  if (compressed && !WriteCompressedFrames(file, &frameListOffset))
+    return false;
 
   header.frameListOffset = frameListOffset;
   header.frameCount = (u32)m_Frames.size();
 
-  header.flags = m_Flags;
+  header.flags = compressed ? (m_Flags | FLAG_COMPRESSED) : (m_Flags & ~FLAG_COMPRESSED);
 
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
@@ -170,10 +310,15 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
 
+  // The frames of compressed files have already been written, followed by their index.
+  if (compressed)
+    return file.Close();
+
   // Write frames list
   for (unsigned int i = 0; i < m_Frames.size(); ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
+    const std::shared_ptr<const FifoFrameInfo> frame = GetFrame(i);
+    const FifoFrameInfo& srcFrame = *frame;
 
     // Write FIFO data
     file.Seek(0, File::SeekOrigin::End);
@@ -202,6 +347,44 @@ bool FifoDataFile::Save(const std::string& filename)
   return true;
 }
 
+bool FifoDataFile::WriteCompressedFrames(File::IOFile& file, u64* indexOffset) const
+{
+  std::unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> ctx(ZSTD_createCCtx());
+  if (!ctx)
+    return false;
+
+  std::vector<FileCompressedFrameInfo> index(m_Frames.size());
+  std::vector<u8> compressed;
+
+  for (u32 i = 0; i < m_Frames.size(); ++i)
+  {
+    const std::shared_ptr<const FifoFrameInfo> frame = GetFrame(i);
+    const std::vector<u8> chunk = SerializeFrame(*frame);
+
+    compressed.resize(ZSTD_compressBound(chunk.size()));
+    const size_t size = ZSTD_compressCCtx(ctx.get(), compressed.data(), compressed.size(),
+                                          chunk.data(), chunk.size(), COMPRESSION_LEVEL);
+    if (ZSTD_isError(size))
+      return false;
+
+    FileCompressedFrameInfo& dstFrame = index[i];
+    dstFrame = {};
+    dstFrame.chunkOffset = file.Tell();
+    dstFrame.chunkSize = static_cast<u32>(size);
+    dstFrame.uncompressedSize = static_cast<u32>(chunk.size());
+    dstFrame.fifoDataSize = static_cast<u32>(frame->fifoData.size());
+    dstFrame.fifoStart = frame->fifoStart;
+    dstFrame.fifoEnd = frame->fifoEnd;
+    dstFrame.numMemoryUpdates = static_cast<u32>(frame->memoryUpdates.size());
+
+    if (!file.WriteBytes(compressed.data(), size))
+      return false;
+  }
+
+  *indexOffset = file.Tell();
+  return file.WriteArray(index.data(), index.size());
+}
+
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
 {
   File::IOFile file;
@@ -302,7 +485,19 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
 
   // Texture memory saving was added in version 4.
   dataFile->m_TexMem.fill(0);
-  if (dataFile->m_Version >= 4)
+  if (dataFile->IsCompressed())
+  {
+    std::vector<u8> chunk(header.texMemCompressedSize);
+    file.Seek(header.texMemOffset, File::SeekOrigin::Begin);
+    if (!file.ReadBytes(chunk.data(), chunk.size()))
+      return panic_failed_to_read();
+
+    const size_t result = ZSTD_decompress(dataFile->m_TexMem.data(), TEX_MEM_SIZE, chunk.data(),
+                                          chunk.size());
+    if (ZSTD_isError(result))
+      return panic_failed_to_read();
+  }
+  else if (dataFile->m_Version >= 4)
   {
     size = std::min<u32>(TEX_MEM_SIZE, header.texMemSize);
     file.Seek(header.texMemOffset, File::SeekOrigin::Begin);
@@ -316,6 +511,16 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
+  // Only the index of a compressed file is read here. Its frames are read on demand.
+  if (dataFile->IsCompressed())
+  {
+    if (!LoadCompressedFrameIndex(header.frameListOffset, header.frameCount, dataFile.get(), file))
+      return panic_failed_to_read();
+
+    dataFile->m_chunk_file = std::make_unique<File::IOFile>(std::move(file));
+    return dataFile;
+  }
+
   // Read frames
   for (u32 i = 0; i < header.frameCount; ++i)
   {
@@ -325,26 +530,102 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
       return panic_failed_to_read();
 
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
+    auto dstFrame = std::make_shared<FifoFrameInfo>();
+    dstFrame->fifoData.resize(srcFrame.fifoDataSize);
+    dstFrame->fifoStart = srcFrame.fifoStart;
+    dstFrame->fifoEnd = srcFrame.fifoEnd;
 
     file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
+    file.ReadBytes(dstFrame->fifoData.data(), srcFrame.fifoDataSize);
 
     ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+                      dstFrame->memoryUpdates, file);
 
     if (!file.IsGood())
       return panic_failed_to_read();
 
-    dataFile->AddFrame(dstFrame);
+    dataFile->m_Frames.emplace_back().frame = std::move(dstFrame);
   }
 
   return dataFile;
 }
 
+bool FifoDataFile::LoadCompressedFrameIndex(u64 offset, u32 count, FifoDataFile* dataFile,
+                                            File::IOFile& file)
+{
+  std::vector<FileCompressedFrameInfo> index(count);
+  file.Seek(offset, File::SeekOrigin::Begin);
+  if (!file.ReadArray(index.data(), index.size()))
+    return false;
+
+  const u64 file_size = file.GetSize();
+  dataFile->m_Frames.reserve(count);
+  for (const FileCompressedFrameInfo& srcFrame : index)
+  {
+    const u64 payload_size =
+        u64(srcFrame.numMemoryUpdates) * sizeof(FileMemoryUpdate) + srcFrame.fifoDataSize;
+    if (srcFrame.chunkOffset > file_size || srcFrame.chunkSize > file_size - srcFrame.chunkOffset ||
+        payload_size > srcFrame.uncompressedSize)
+    {
+      return false;
+    }
+
+    FrameEntry& dstFrame = dataFile->m_Frames.emplace_back();
+    dstFrame.chunk_offset = srcFrame.chunkOffset;
+    dstFrame.chunk_size = srcFrame.chunkSize;
+    dstFrame.uncompressed_size = srcFrame.uncompressedSize;
+    dstFrame.fifo_data_size = srcFrame.fifoDataSize;
+    dstFrame.fifo_start = srcFrame.fifoStart;
+    dstFrame.fifo_end = srcFrame.fifoEnd;
+    dstFrame.num_memory_updates = srcFrame.numMemoryUpdates;
+  }
+
+  return true;
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::LoadFrameChunk(const FrameEntry& entry) const
+{
+  std::vector<u8> compressed(entry.chunk_size);
+  m_chunk_file->Seek(entry.chunk_offset, File::SeekOrigin::Begin);
+  if (!m_chunk_file->ReadBytes(compressed.data(), compressed.size()))
+    return nullptr;
+
+  std::vector<u8> chunk(entry.uncompressed_size);
+  const size_t size =
+      ZSTD_decompress(chunk.data(), chunk.size(), compressed.data(), compressed.size());
+  if (ZSTD_isError(size) || size != chunk.size())
+    return nullptr;
+
+  auto frame = std::make_shared<FifoFrameInfo>();
+  frame->fifoStart = entry.fifo_start;
+  frame->fifoEnd = entry.fifo_end;
+
+  const size_t updates_size = entry.num_memory_updates * sizeof(FileMemoryUpdate);
+  const u8* fifo_data = chunk.data() + updates_size;
+  frame->fifoData.assign(fifo_data, fifo_data + entry.fifo_data_size);
+
+  frame->memoryUpdates.resize(entry.num_memory_updates);
+  for (u32 i = 0; i < entry.num_memory_updates; ++i)
+  {
+    FileMemoryUpdate srcUpdate;
+    std::memcpy(&srcUpdate, chunk.data() + i * sizeof(FileMemoryUpdate), sizeof(srcUpdate));
+    if (srcUpdate.dataOffset > chunk.size() ||
+        srcUpdate.dataSize > chunk.size() - srcUpdate.dataOffset)
+    {
+      return nullptr;
+    }
+
+    MemoryUpdate& dstUpdate = frame->memoryUpdates[i];
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+    const u8* data = chunk.data() + srcUpdate.dataOffset;
+    dstUpdate.data.assign(data, data + srcUpdate.dataSize);
+  }
+
+  return frame;
+}
+
 void FifoDataFile::PadFile(size_t numBytes, File::IOFile& file)
 {
   for (size_t i = 0; i < numBytes; ++i)
@@ -5,7 +5,9 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -73,18 +75,46 @@ public:
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
+  // Frames of compressed files are only read from disk when they are requested, and may be dropped
+  // from memory again once the returned pointer is released.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
   u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
-  bool Save(const std::string& filename);
+  bool IsCompressed() const;
+
+  // The compressed format stores every frame as a separately compressed chunk, with an index of
+  // all chunks at the end of the file. It requires a version 6 loader.
+  bool Save(const std::string& filename, bool compressed = false);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
   enum
   {
-    FLAG_IS_WII = 1
+    FLAG_IS_WII = 1,
+    FLAG_COMPRESSED = 2,
+  };
+
+  struct FrameEntry
+  {
+    // Set for all frames of recordings and uncompressed files.
+    std::shared_ptr<const FifoFrameInfo> frame;
+
+    // Location of the frame in a compressed file.
+    u64 chunk_offset = 0;
+    u32 chunk_size = 0;
+    u32 uncompressed_size = 0;
+    u32 fifo_data_size = 0;
+    u32 fifo_start = 0;
+    u32 fifo_end = 0;
+    u32 num_memory_updates = 0;
   };
 
+  bool WriteFile(const std::string& filename, bool compressed);
+  bool WriteCompressedFrames(File::IOFile& file, u64* indexOffset) const;
+  std::shared_ptr<const FifoFrameInfo> LoadFrameChunk(const FrameEntry& entry) const;
+  static bool LoadCompressedFrameIndex(u64 offset, u32 count, FifoDataFile* dataFile,
+                                       File::IOFile& file);
+
   void PadFile(size_t numBytes, File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
@@ -105,5 +135,11 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  std::vector<FrameEntry> m_Frames;
+
+  // Compressed files stay open, so that their frames can be streamed from disk.
+  std::unique_ptr<File::IOFile> m_chunk_file;
+  // Recently decompressed frames, oldest first. Guarded by m_chunk_mutex, as is m_chunk_file.
+  mutable std::vector<std::pair<u32, std::shared_ptr<const FifoFrameInfo>>> m_chunk_cache;
+  mutable std::mutex m_chunk_mutex;
 };
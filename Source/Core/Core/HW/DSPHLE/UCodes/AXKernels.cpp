@@ -0,0 +1,279 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXKernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+#include "Common/MathUtil.h"
+
+namespace DSP::HLE::AXKernels
+{
+namespace
+{
+constexpr s32 SAMPLE_MIN = -32767;
+constexpr s32 SAMPLE_MAX = 32767;
+
+s32 ScaleSample(s16 sample, u16 volume)
+{
+  return std::clamp((s32(sample) * volume) >> 15, SAMPLE_MIN, SAMPLE_MAX);
+}
+
+u32 GetCoefficientIndex(u64 position)
+{
+  return ((position & 0xFFFF) >> 9) << 2;
+}
+
+#ifdef _M_X86_64
+// Volumes of the next four samples, zero-extended to 32 bits.
+FUNCTION_TARGET_SSR41
+__m128i GetVolumesSSE41(u16 volume, u16 volume_delta)
+{
+  return _mm_setr_epi32(volume, u16(volume + volume_delta), u16(volume + 2 * volume_delta),
+                        u16(volume + 3 * volume_delta));
+}
+
+// The product of a sample and a volume always fits in 32 bits.
+FUNCTION_TARGET_SSR41
+__m128i ScaleSamplesSSE41(const s16* samples, __m128i volumes)
+{
+  const __m128i input =
+      _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(samples)));
+  const __m128i scaled = _mm_srai_epi32(_mm_mullo_epi32(input, volumes), 15);
+  return _mm_min_epi32(_mm_max_epi32(scaled, _mm_set1_epi32(SAMPLE_MIN)),
+                       _mm_set1_epi32(SAMPLE_MAX));
+}
+
+FUNCTION_TARGET_SSR41
+__m128i NextVolumesSSE41(__m128i volumes, u16 volume_delta)
+{
+  return _mm_and_si128(_mm_add_epi32(volumes, _mm_set1_epi32(u16(4 * volume_delta))),
+                       _mm_set1_epi32(0xFFFF));
+}
+
+s32 LoadSamplePair(const s16* samples)
+{
+  s32 pair;
+  std::memcpy(&pair, samples, sizeof(pair));
+  return pair;
+}
+#endif
+}  // namespace
+
+void MixAddScalar(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta, s16* dpop)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 sample = ScaleSample(input[i], *volume);
+    out[i] += sample;
+    *volume += volume_delta;
+    *dpop = s16(sample);
+  }
+}
+
+void ApplyVolumeEnvelopeScalar(s16* samples, u32 count, u16* volume, u16 volume_delta)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    samples[i] = ScaleSample(samples[i], *volume);
+    *volume += volume_delta;
+  }
+}
+
+void ResampleLinearScalar(s16* output, const s16* input, u32 count, u64 position, u32 ratio)
+{
+  u64 current = position;
+  for (u32 i = 0; i < count; ++i)
+  {
+    current += ratio;
+    const u32 k = u32(current >> 16);
+    const s32 frac = s32(current & 0xFFFF);
+
+    // Never overflows, as this is a weighted average of two samples scaled by 65536.
+    output[i] = s16((input[k] * (0x10000 - frac) + input[k + 1] * frac) >> 16);
+  }
+}
+
+void ResamplePolyphaseScalar(s16* output, const s16* input, u32 count, u64 position, u32 ratio,
+                             const s16* coeffs)
+{
+  u64 current = position;
+  for (u32 i = 0; i < count; ++i)
+  {
+    current += ratio;
+    const s16* t = &input[current >> 16];
+    const s16* c = &coeffs[GetCoefficientIndex(current)];
+
+    const s64 sum = s64(t[0]) * c[0] + s64(t[1]) * c[1] + s64(t[2]) * c[2] + s64(t[3]) * c[3];
+    output[i] = MathUtil::SaturatingCast<s16>(sum >> 15);
+  }
+}
+
+#ifdef _M_X86_64
+FUNCTION_TARGET_SSR41
+void MixAddSSE41(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta, s16* dpop)
+{
+  u32 i = 0;
+  if (count >= 4)
+  {
+    __m128i volumes = GetVolumesSSE41(*volume, volume_delta);
+    __m128i samples = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4)
+    {
+      samples = ScaleSamplesSSE41(input + i, volumes);
+      __m128i* const dest = reinterpret_cast<__m128i*>(out + i);
+      _mm_storeu_si128(dest, _mm_add_epi32(_mm_loadu_si128(dest), samples));
+      volumes = NextVolumesSSE41(volumes, volume_delta);
+    }
+    *volume += u16(i * volume_delta);
+    *dpop = s16(_mm_extract_epi32(samples, 3));
+  }
+
+  MixAddScalar(out + i, input + i, count - i, volume, volume_delta, dpop);
+}
+
+FUNCTION_TARGET_SSR41
+void ApplyVolumeEnvelopeSSE41(s16* samples, u32 count, u16* volume, u16 volume_delta)
+{
+  u32 i = 0;
+  __m128i volumes = GetVolumesSSE41(*volume, volume_delta);
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128i scaled = ScaleSamplesSSE41(samples + i, volumes);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(samples + i), _mm_packs_epi32(scaled, scaled));
+    volumes = NextVolumesSSE41(volumes, volume_delta);
+  }
+  *volume += u16(i * volume_delta);
+
+  ApplyVolumeEnvelopeScalar(samples + i, count - i, volume, volume_delta);
+}
+
+FUNCTION_TARGET_SSR41
+void ResampleLinearSSE41(s16* output, const s16* input, u32 count, u64 position, u32 ratio)
+{
+  u64 current = position;
+  u32 i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    // Each lane holds the pair of samples to interpolate between.
+    s32 pairs[4];
+    s32 fracs[4];
+    for (int j = 0; j < 4; j++)
+    {
+      current += ratio;
+      pairs[j] = LoadSamplePair(&input[current >> 16]);
+      fracs[j] = s32(current & 0xFFFF);
+    }
+
+    const __m128i pair = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pairs));
+    const __m128i s0 = _mm_srai_epi32(_mm_slli_epi32(pair, 16), 16);
+    const __m128i s1 = _mm_srai_epi32(pair, 16);
+    const __m128i frac = _mm_loadu_si128(reinterpret_cast<const __m128i*>(fracs));
+    const __m128i inv_frac = _mm_sub_epi32(_mm_set1_epi32(0x10000), frac);
+
+    const __m128i result = _mm_srai_epi32(
+        _mm_add_epi32(_mm_mullo_epi32(s0, inv_frac), _mm_mullo_epi32(s1, frac)), 16);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(result, result));
+  }
+
+  ResampleLinearScalar(output + i, input, count - i, current, ratio);
+}
+
+FUNCTION_TARGET_SSR41
+void ResamplePolyphaseSSE41(s16* output, const s16* input, u32 count, u64 position, u32 ratio,
+                            const s16* coeffs)
+{
+  const auto load4 = [](const s16* p) {
+    return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+  };
+
+  u64 current = position;
+  u32 i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i taps[2];
+    __m128i coefs[2];
+    for (int j = 0; j < 2; j++)
+    {
+      const u64 position_a = current + ratio;
+      const u64 position_b = position_a + ratio;
+      current = position_b;
+      taps[j] = _mm_unpacklo_epi64(load4(&input[position_a >> 16]),
+                                   load4(&input[position_b >> 16]));
+      coefs[j] = _mm_unpacklo_epi64(load4(&coeffs[GetCoefficientIndex(position_a)]),
+                                    load4(&coeffs[GetCoefficientIndex(position_b)]));
+    }
+
+    // Full 32-bit products, four per output sample.
+    __m128i products[4];
+    for (int j = 0; j < 2; j++)
+    {
+      const __m128i lo = _mm_mullo_epi16(taps[j], coefs[j]);
+      const __m128i hi = _mm_mulhi_epi16(taps[j], coefs[j]);
+      products[j * 2] = _mm_unpacklo_epi16(lo, hi);
+      products[j * 2 + 1] = _mm_unpackhi_epi16(lo, hi);
+    }
+
+    // The sum of four products can overflow 32 bits. As only the sum shifted right by 15 is
+    // needed, sum the upper and lower 15-bit parts of the products separately instead.
+    __m128i high[4];
+    __m128i low[4];
+    for (int j = 0; j < 4; j++)
+    {
+      high[j] = _mm_srai_epi32(products[j], 15);
+      low[j] = _mm_and_si128(products[j], _mm_set1_epi32(0x7FFF));
+    }
+    const __m128i high_sum = _mm_hadd_epi32(_mm_hadd_epi32(high[0], high[1]),
+                                            _mm_hadd_epi32(high[2], high[3]));
+    const __m128i low_sum =
+        _mm_hadd_epi32(_mm_hadd_epi32(low[0], low[1]), _mm_hadd_epi32(low[2], low[3]));
+
+    const __m128i result = _mm_add_epi32(high_sum, _mm_srai_epi32(low_sum, 15));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(result, result));
+  }
+
+  ResamplePolyphaseScalar(output + i, input, count - i, current, ratio, coeffs);
+}
+#endif
+
+void MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta, s16* dpop)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bSSE4_1)
+    return MixAddSSE41(out, input, count, volume, volume_delta, dpop);
+#endif
+  MixAddScalar(out, input, count, volume, volume_delta, dpop);
+}
+
+void ApplyVolumeEnvelope(s16* samples, u32 count, u16* volume, u16 volume_delta)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bSSE4_1)
+    return ApplyVolumeEnvelopeSSE41(samples, count, volume, volume_delta);
+#endif
+  ApplyVolumeEnvelopeScalar(samples, count, volume, volume_delta);
+}
+
+void ResampleLinear(s16* output, const s16* input, u32 count, u64 position, u32 ratio)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bSSE4_1)
+    return ResampleLinearSSE41(output, input, count, position, ratio);
+#endif
+  ResampleLinearScalar(output, input, count, position, ratio);
+}
+
+void ResamplePolyphase(s16* output, const s16* input, u32 count, u64 position, u32 ratio,
+                       const s16* coeffs)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bSSE4_1)
+    return ResamplePolyphaseSSE41(output, input, count, position, ratio, coeffs);
+#endif
+  ResamplePolyphaseScalar(output, input, count, position, ratio, coeffs);
+}
+}  // namespace DSP::HLE::AXKernels
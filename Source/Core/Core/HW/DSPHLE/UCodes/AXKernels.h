@@ -0,0 +1,46 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Per-voice sample processing of the AX ucodes, see ProcessVoice in AXVoice.h.
+//
+// Volumes are 1.15 fixed point and are incremented by volume_delta (wrapping around) after each
+// sample. Scaled samples saturate to [-32767, 32767].
+namespace DSP::HLE::AXKernels
+{
+// Adds the scaled input to out. The last scaled sample is stored to *dpop if count isn't 0.
+void MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta, s16* dpop);
+
+// Scales the samples in place.
+void ApplyVolumeEnvelope(s16* samples, u32 count, u16* volume, u16 volume_delta);
+
+// Sample rate conversion. input holds the four samples kept from the previous frame, followed by
+// the new input samples. For output sample i, k and frac are the integer and fractional parts of
+// the 16.16 fixed-point position (position + (i + 1) * ratio).
+
+// Interpolates between input[k] and input[k + 1].
+void ResampleLinear(s16* output, const s16* input, u32 count, u64 position, u32 ratio);
+// Filters input[k] to input[k + 3]. coeffs holds 128 sets of four filter taps, selected by the
+// upper 7 bits of frac.
+void ResamplePolyphase(s16* output, const s16* input, u32 count, u64 position, u32 ratio,
+                       const s16* coeffs);
+
+// Reference implementations, also used when SSE4.1 is not available.
+void MixAddScalar(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta, s16* dpop);
+void ApplyVolumeEnvelopeScalar(s16* samples, u32 count, u16* volume, u16 volume_delta);
+void ResampleLinearScalar(s16* output, const s16* input, u32 count, u64 position, u32 ratio);
+void ResamplePolyphaseScalar(s16* output, const s16* input, u32 count, u64 position, u32 ratio,
+                             const s16* coeffs);
+
+#ifdef _M_X86_64
+// Only call these if the CPU supports SSE4.1.
+void MixAddSSE41(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta, s16* dpop);
+void ApplyVolumeEnvelopeSSE41(s16* samples, u32 count, u16* volume, u16 volume_delta);
+void ResampleLinearSSE41(s16* output, const s16* input, u32 count, u64 position, u32 ratio);
+void ResamplePolyphaseSSE41(s16* output, const s16* input, u32 count, u64 position, u32 ratio,
+                            const s16* coeffs);
+#endif
+}  // namespace DSP::HLE::AXKernels
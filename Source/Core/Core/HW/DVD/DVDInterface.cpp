@@ -39,6 +39,7 @@
 #include "Core/System.h"
 
 #include "DiscIO/Blob.h"
+#include "DiscIO/CachedBlob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/VolumeDisc.h"
@@ -424,7 +425,7 @@ void DVDInterface::EjectDiscCallback(Core::System& system, u64 userdata, s64 cyc
 void DVDInterface::InsertDiscCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
   auto& di = system.GetDVDInterface();
-  std::unique_ptr<DiscIO::VolumeDisc> new_disc = DiscIO::CreateDisc(di.m_disc_path_to_insert);
+  std::unique_ptr<DiscIO::VolumeDisc> new_disc = CreateDisc(di.m_disc_path_to_insert);
 
   if (new_disc)
     di.SetDisc(std::move(new_disc), {});
@@ -1525,4 +1526,12 @@ void DVDInterface::ScheduleReads(u64 offset, u32 length, const DiscIO::Partition
                 ticks_until_completion * 1000000 / SystemTimers::GetTicksPerSecond());
 }
 
+std::unique_ptr<DiscIO::VolumeDisc> CreateDisc(const std::string& path)
+{
+  if (!Config::Get(Config::MAIN_DISC_READ_AHEAD))
+    return DiscIO::CreateDisc(path);
+
+  return DiscIO::CreateDisc(DiscIO::CreateCachedBlobReader(path));
+}
+
 }  // namespace DVD
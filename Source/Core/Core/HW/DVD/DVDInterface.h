@@ -120,6 +120,10 @@ enum class EjectCause
   Software,
 };
 
+// Opens a disc image for emulation. Unless disabled in the settings, compressed images are read
+// through a cache which decompresses blocks ahead of time.
+std::unique_ptr<DiscIO::VolumeDisc> CreateDisc(const std::string& path);
+
 class DVDInterface
 {
 public:
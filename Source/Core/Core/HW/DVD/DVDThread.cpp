@@ -3,6 +3,9 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -21,6 +24,7 @@
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -32,10 +36,20 @@
 #include "Core/System.h"
 
 #include "DiscIO/Enums.h"
+#include "DiscIO/Filesystem.h"
 #include "DiscIO/Volume.h"
 
 namespace DVD
 {
+// DVDInterface splits reads into one request per block. Adjacent requests which are queued at
+// the same time are served with a single read from the disc image, up to this size.
+constexpr u64 MAX_COALESCED_READ_SIZE = 0x100000;
+
+// How far ahead to read into a file that is being read, and in which steps. Prefetching stops
+// between steps as soon as a new request comes in.
+constexpr u64 PREFETCH_WINDOW_SIZE = 0x400000;
+constexpr u64 PREFETCH_CHUNK_SIZE = 0x40000;
+
 DVDThread::DVDThread(Core::System& system) : m_system(system)
 {
 }
@@ -55,6 +69,10 @@ void DVDThread::Start()
   // much, because this will never get exposed to the emulated game.
   m_next_id = 0;
 
+  m_prefetch_enabled = Config::Get(Config::MAIN_DISC_READ_AHEAD);
+  m_prefetch = {};
+  m_statistics = {};
+
   StartDVDThread();
 }
 
@@ -68,6 +86,7 @@ void DVDThread::StartDVDThread()
 void DVDThread::Stop()
 {
   StopDVDThread();
+  LogStatistics();
   m_disc.reset();
 }
 
@@ -132,6 +151,7 @@ void DVDThread::SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
   m_disc = std::move(disc);
+  m_prefetch = {};
 }
 
 bool DVDThread::HasDisc() const
@@ -332,6 +352,7 @@ void DVDThread::DVDThreadMain()
 {
   Common::SetCurrentThreadName("DVD thread");
 
+  std::vector<ReadRequest> requests;
   while (true)
   {
     m_request_queue_expanded.Wait();
@@ -339,23 +360,211 @@ void DVDThread::DVDThreadMain()
     if (m_dvd_thread_exiting.IsSet())
       return;
 
-    ReadRequest request;
-    while (m_request_queue.Pop(request))
+    while (PopAdjacentRequests(&requests))
     {
-      m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
+      ProcessRequests(&requests);
 
-      std::vector<u8> buffer(request.length);
-      if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+      if (m_dvd_thread_exiting.IsSet())
+        return;
+    }
 
-      request.realtime_done_us = Common::Timer::NowUs();
+    // The emulated software is waiting for the data it has requested, or busy with it
+    Prefetch();
+  }
+}
 
-      m_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
-      m_result_queue_expanded.Set();
+// Pops the next request along with the requests that directly follow it on the disc.
+bool DVDThread::PopAdjacentRequests(std::vector<ReadRequest>* requests)
+{
+  requests->clear();
 
-      if (m_dvd_thread_exiting.IsSet())
-        return;
+  ReadRequest request;
+  if (!m_request_queue.Pop(request))
+    return false;
+
+  u64 end = request.dvd_offset + request.length;
+  u64 size = request.length;
+  const DiscIO::Partition partition = request.partition;
+  requests->push_back(std::move(request));
+
+  while (!m_request_queue.Empty())
+  {
+    ReadRequest& next = m_request_queue.Front();
+    if (next.partition != partition || next.dvd_offset != end ||
+        size + next.length > MAX_COALESCED_READ_SIZE)
+    {
+      break;
+    }
+
+    end += next.length;
+    size += next.length;
+    requests->push_back(std::move(next));
+    m_request_queue.Pop();
+  }
+
+  return true;
+}
+
+void DVDThread::ProcessRequests(std::vector<ReadRequest>* requests)
+{
+  const DiscIO::Partition partition = requests->front().partition;
+  const u64 offset = requests->front().dvd_offset;
+  const u64 length = requests->back().dvd_offset + requests->back().length - offset;
+
+  for (const ReadRequest& request : *requests)
+    m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
+
+  std::vector<u8> buffer(length);
+  bool success = ReadFromPrefetchBuffer(offset, length, buffer.data(), partition);
+  if (success)
+  {
+    m_statistics.prefetch_hits += requests->size();
+  }
+  else
+  {
+    success = m_disc->Read(offset, length, buffer.data(), partition);
+    ++m_statistics.disc_reads;
+    m_statistics.bytes_read += length;
+  }
+  UpdatePrefetchTarget(offset, length, partition);
+
+  const u8* data = buffer.data();
+  for (ReadRequest& request : *requests)
+  {
+    std::vector<u8> request_buffer;
+    if (success)
+    {
+      request_buffer.assign(data, data + request.length);
+    }
+    else if (requests->size() > 1)
+    {
+      // Only fail the requests that actually can't be read
+      request_buffer.resize(request.length);
+      ++m_statistics.disc_reads;
+      m_statistics.bytes_read += request.length;
+      if (!m_disc->Read(request.dvd_offset, request.length, request_buffer.data(), partition))
+        request_buffer.clear();
+    }
+    data += request.length;
+
+    request.realtime_done_us = Common::Timer::NowUs();
+
+    const u64 wait_us = request.realtime_done_us - request.realtime_started_us;
+    ++m_statistics.requests;
+    m_statistics.bytes_requested += request.length;
+    m_statistics.total_wait_us += wait_us;
+    m_statistics.max_wait_us = std::max(m_statistics.max_wait_us, wait_us);
+
+    m_result_queue.Push(ReadResult(std::move(request), std::move(request_buffer)));
+    m_result_queue_expanded.Set();
+  }
+}
+
+bool DVDThread::ReadFromPrefetchBuffer(u64 offset, u64 length, u8* buffer,
+                                       const DiscIO::Partition& partition) const
+{
+  if (partition != m_prefetch.partition || offset < m_prefetch.offset ||
+      offset + length > m_prefetch.end)
+  {
+    return false;
+  }
+
+  // All chunks except the last one have the same size
+  u64 offset_in_buffer = offset - m_prefetch.offset;
+  while (length > 0)
+  {
+    const std::vector<u8>& chunk = m_prefetch.chunks[offset_in_buffer / PREFETCH_CHUNK_SIZE];
+    const u64 offset_in_chunk = offset_in_buffer % PREFETCH_CHUNK_SIZE;
+    const u64 bytes_to_copy = std::min(chunk.size() - offset_in_chunk, length);
+    std::memcpy(buffer, chunk.data() + offset_in_chunk, bytes_to_copy);
+
+    buffer += bytes_to_copy;
+    length -= bytes_to_copy;
+    offset_in_buffer += bytes_to_copy;
+  }
+
+  return true;
+}
+
+void DVDThread::UpdatePrefetchTarget(u64 offset, u64 length, const DiscIO::Partition& partition)
+{
+  if (!m_prefetch_enabled)
+    return;
+
+  const u64 end = offset + length;
+  if (partition == m_prefetch.partition && offset >= m_prefetch.offset &&
+      offset < m_prefetch.file_end)
+  {
+    // The file is still being read, so drop the data that has been read and keep going
+    if (end > m_prefetch.end)
+    {
+      m_prefetch.chunks.clear();
+      m_prefetch.offset = m_prefetch.end = end;
+      return;
     }
+
+    while (!m_prefetch.chunks.empty() &&
+           m_prefetch.offset + m_prefetch.chunks.front().size() <= end)
+    {
+      m_prefetch.offset += m_prefetch.chunks.front().size();
+      m_prefetch.chunks.pop_front();
+    }
+    return;
+  }
+
+  m_prefetch = {};
+
+  // Games usually read a file from its start to its end, even if they need several reads for it
+  const DiscIO::FileSystem* file_system = m_disc->GetFileSystem(partition);
+  if (!file_system)
+    return;
+  const std::unique_ptr<DiscIO::FileInfo> file_info = file_system->FindFileInfo(offset);
+  if (!file_info || file_info->GetOffset() != offset)
+    return;
+
+  const u64 file_end = file_info->GetOffset() + file_info->GetSize();
+  if (end >= file_end)
+    return;
+
+  m_prefetch.partition = partition;
+  m_prefetch.offset = end;
+  m_prefetch.end = end;
+  m_prefetch.file_end = file_end;
+}
+
+void DVDThread::Prefetch()
+{
+  while (m_prefetch.end < m_prefetch.file_end &&
+         m_prefetch.end - m_prefetch.offset < PREFETCH_WINDOW_SIZE)
+  {
+    if (!m_request_queue.Empty() || m_dvd_thread_exiting.IsSet())
+      return;
+
+    std::vector<u8> chunk(std::min(PREFETCH_CHUNK_SIZE, m_prefetch.file_end - m_prefetch.end));
+    if (!m_disc->Read(m_prefetch.end, chunk.size(), chunk.data(), m_prefetch.partition))
+    {
+      // Leave it to a real request to report the error
+      m_prefetch.file_end = m_prefetch.end;
+      return;
+    }
+
+    m_statistics.bytes_prefetched += chunk.size();
+    m_prefetch.end += chunk.size();
+    m_prefetch.chunks.push_back(std::move(chunk));
   }
 }
+
+void DVDThread::LogStatistics() const
+{
+  if (m_statistics.requests == 0)
+    return;
+
+  INFO_LOG_FMT(DVDINTERFACE,
+               "{} read requests ({} KiB) were served by {} disc image reads ({} KiB) and {} "
+               "prefetched reads ({} KiB prefetched). Wait time: {} us on average, {} us at most.",
+               m_statistics.requests, m_statistics.bytes_requested / 1024,
+               m_statistics.disc_reads, m_statistics.bytes_read / 1024,
+               m_statistics.prefetch_hits, m_statistics.bytes_prefetched / 1024,
+               m_statistics.total_wait_us / m_statistics.requests, m_statistics.max_wait_us);
+}
 }  // namespace DVD
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <optional>
@@ -118,7 +119,7 @@ private:
     // it's fine to re-use IDs of requests that have existed in the past.
     u64 id = 0;
 
-    // Only used for logging
+    // Only used for logging and statistics
     u64 time_started_ticks = 0;
     u64 realtime_started_us = 0;
     u64 realtime_done_us = 0;
@@ -126,6 +127,43 @@ private:
 
   using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+  // While a file is being read, the rest of it is read ahead whenever the DVD thread is idle.
+  // Only used by the DVD thread.
+  struct PrefetchBuffer
+  {
+    DiscIO::Partition partition{};
+    // The prefetched data covers offset to end. file_end is the end of the file being read.
+    u64 offset = 0;
+    u64 end = 0;
+    u64 file_end = 0;
+    std::deque<std::vector<u8>> chunks;
+  };
+
+  bool PopAdjacentRequests(std::vector<ReadRequest>* requests);
+  void ProcessRequests(std::vector<ReadRequest>* requests);
+  bool ReadFromPrefetchBuffer(u64 offset, u64 length, u8* buffer,
+                              const DiscIO::Partition& partition) const;
+  void UpdatePrefetchTarget(u64 offset, u64 length, const DiscIO::Partition& partition);
+  void Prefetch();
+
+  // Only used by the DVD thread while it's running
+  struct Statistics
+  {
+    // Requests from DVDInterface, and the reads from the disc image that served them
+    u64 requests = 0;
+    u64 bytes_requested = 0;
+    u64 disc_reads = 0;
+    u64 bytes_read = 0;
+    // Requests served from data that was read ahead
+    u64 prefetch_hits = 0;
+    u64 bytes_prefetched = 0;
+    // Real time from a request being made until its data is ready
+    u64 total_wait_us = 0;
+    u64 max_wait_us = 0;
+  };
+
+  void LogStatistics() const;
+
   CoreTiming::EventType* m_finish_read = nullptr;
 
   u64 m_next_id = 0;
@@ -141,6 +179,10 @@ private:
 
   std::unique_ptr<DiscIO::Volume> m_disc;
 
+  bool m_prefetch_enabled = false;
+  PrefetchBuffer m_prefetch;
+  Statistics m_statistics;
+
   FileMonitor::FileLogger m_file_logger;
 
   Core::System& m_system;
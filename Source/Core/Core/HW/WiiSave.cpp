@@ -393,8 +393,13 @@ public:
 
   bool WriteFiles(const std::vector<SaveFile>& files) override
   {
-    if (!m_file.Seek(sizeof(Header) + sizeof(BkHeader), File::SeekOrigin::Begin))
+    // Hash the signed data while it's being written instead of reading it back afterwards
+    const std::optional<BkHeader> bk_header = ReadBkHeader();
+    if (!bk_header || !m_file.Seek(sizeof(Header) + sizeof(BkHeader), File::SeekOrigin::Begin))
       return false;
+    const auto sha1 = Common::SHA1::CreateContext();
+    sha1->Update(reinterpret_cast<const u8*>(&*bk_header), sizeof(BkHeader));
+    u64 files_size = 0;
 
     for (const SaveFile& save_file : files)
     {
@@ -418,6 +423,8 @@ public:
 
       if (!m_file.WriteArray(&file_hdr, 1))
         return false;
+      sha1->Update(reinterpret_cast<const u8*>(&file_hdr), sizeof(file_hdr));
+      files_size += sizeof(file_hdr);
 
       if (data)
       {
@@ -427,10 +434,19 @@ public:
                        file_data_enc.size(), file_data_enc.data(), IOS::PID_ES);
         if (!m_file.WriteBytes(file_data_enc.data(), file_data_enc.size()))
           return false;
+        sha1->Update(file_data_enc);
+        files_size += file_data_enc.size();
       }
     }
 
-    if (!WriteSignatures())
+    if (files_size != bk_header->size_of_files)
+    {
+      ERROR_LOG_FMT(CORE, "WiiSave::WriteFiles: Wrote {:#x} bytes of files, expected {:#x}",
+                    files_size, bk_header->size_of_files);
+      return false;
+    }
+
+    if (!WriteSignatures(sha1->Finish()))
     {
       ERROR_LOG_FMT(CORE, "WiiSave::WriteFiles: Failed to write signatures");
       return false;
@@ -439,23 +455,9 @@ public:
   }
 
 private:
-  bool WriteSignatures()
+  // data_sha1 is the digest of the bk header and the files.
+  bool WriteSignatures(const Common::SHA1::Digest& data_sha1)
   {
-    const std::optional<BkHeader> bk_header = ReadBkHeader();
-    if (!bk_header)
-      return false;
-
-    // Read data to sign.
-    Common::SHA1::Digest data_sha1;
-    {
-      const u32 data_size = bk_header->size_of_files + sizeof(BkHeader);
-      auto data = std::make_unique<u8[]>(data_size);
-      m_file.Seek(sizeof(Header), File::SeekOrigin::Begin);
-      if (!m_file.ReadBytes(data.get(), data_size))
-        return false;
-      data_sha1 = Common::SHA1::CalculateDigest(data.get(), data_size);
-    }
-
     // Sign the data.
     IOS::CertECC ap_cert;
     Common::ec::Signature ap_sig;
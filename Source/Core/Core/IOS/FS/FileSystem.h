@@ -200,6 +200,9 @@ public:
 
   virtual void DoState(PointerWrap& p) = 0;
 
+  /// Write any changes that are only buffered in memory to the backing storage.
+  virtual void Flush() = 0;
+
   /// Format the file system.
   virtual ResultCode Format(Uid uid) = 0;
 
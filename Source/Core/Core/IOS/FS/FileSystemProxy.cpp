@@ -4,6 +4,7 @@
 #include "Core/IOS/FS/FileSystemProxy.h"
 
 #include <algorithm>
+#include <bit>
 #include <cstring>
 #include <string_view>
 
@@ -13,6 +14,7 @@
 #include "Common/EnumUtils.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Timer.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/IOS/FS/FileSystem.h"
@@ -84,6 +86,10 @@ constexpr SystemTimers::TimeBaseTick GetFreeClusterCheckTbTicks()
 
 constexpr size_t CLUSTER_DATA_SIZE = 0x4000;
 
+// How often changes that the FS backend buffers in memory are written to the host, at most.
+// They are also written when emulation stops or a savestate is made.
+constexpr u64 FLUSH_INTERVAL_MS = 1000;
+
 FSCore::FSCore(Kernel& ios) : m_ios(ios)
 {
   if (ios.GetFS()->Delete(PID_KERNEL, PID_KERNEL, "/tmp") == ResultCode::Success)
@@ -100,7 +106,57 @@ FSDevice::FSDevice(EmulationKernel& ios, FSCore& core, const std::string& device
 {
 }
 
-FSDevice::~FSDevice() = default;
+FSDevice::~FSDevice()
+{
+  LogLatencyHistograms();
+}
+
+void FSDevice::Update()
+{
+  const u64 now_ms = Common::Timer::NowMs();
+  if (now_ms - m_last_flush_ms < FLUSH_INTERVAL_MS)
+    return;
+
+  m_last_flush_ms = now_ms;
+  m_ios.GetFS()->Flush();
+}
+
+void FSDevice::LatencyHistogram::Add(u64 us)
+{
+  // Bucket i holds durations below 2^i microseconds
+  const size_t bucket = std::min<size_t>(std::bit_width(us), NUM_BUCKETS - 1);
+  ++counts[bucket];
+  total_us += us;
+  max_us = std::max(max_us, us);
+}
+
+template <typename Function>
+std::optional<IPCReply> FSDevice::MeasureLatency(std::string_view operation, Function function)
+{
+  const u64 start_us = Common::Timer::NowUs();
+  std::optional<IPCReply> reply = function();
+  m_latency_histograms[operation].Add(Common::Timer::NowUs() - start_us);
+  return reply;
+}
+
+void FSDevice::LogLatencyHistograms() const
+{
+  for (const auto& [operation, histogram] : m_latency_histograms)
+  {
+    u64 count = 0;
+    std::string buckets;
+    for (size_t i = 0; i < histogram.counts.size(); ++i)
+    {
+      if (histogram.counts[i] == 0)
+        continue;
+      count += histogram.counts[i];
+      buckets += fmt::format(" <{}us: {}", u64(1) << i, histogram.counts[i]);
+    }
+
+    INFO_LOG_FMT(IOS_FS, "{}: {} requests, {} us on average, {} us at most. Histogram:{}",
+                 operation, count, histogram.total_us / count, histogram.max_us, buckets);
+  }
+}
 
 void FSDevice::DoState(PointerWrap& p)
 {
@@ -170,11 +226,13 @@ static IPCReply GetReplyForSuperblockOperation(int ios_version, ResultCode resul
 
 std::optional<IPCReply> FSDevice::Open(const OpenRequest& request)
 {
-  return MakeIPCReply([&](Ticks t) {
-    return m_core
-        .Open(request.uid, request.gid, request.path, static_cast<Mode>(request.flags & 3),
-              request.fd, t)
-        .Release();
+  return MeasureLatency("Open", [&] {
+    return MakeIPCReply([&](Ticks t) {
+      return m_core
+          .Open(request.uid, request.gid, request.path, static_cast<Mode>(request.flags & 3),
+                request.fd, t)
+          .Release();
+    });
   });
 }
 
@@ -211,7 +269,9 @@ FSCore::ScopedFd FSCore::Open(FS::Uid uid, FS::Gid gid, const std::string& path,
 
 std::optional<IPCReply> FSDevice::Close(u32 fd)
 {
-  return MakeIPCReply([&](Ticks t) { return m_core.Close(static_cast<u64>(fd), t); });
+  return MeasureLatency("Close", [&] {
+    return MakeIPCReply([&](Ticks t) { return m_core.Close(static_cast<u64>(fd), t); });
+  });
 }
 
 s32 FSCore::Close(u64 fd, Ticks ticks)
@@ -323,11 +383,13 @@ bool FSCore::HasCacheForFile(u64 fd, u32 offset) const
 
 std::optional<IPCReply> FSDevice::Read(const ReadWriteRequest& request)
 {
-  return MakeIPCReply([&](Ticks t) {
-    auto& system = GetSystem();
-    auto& memory = system.GetMemory();
-    return m_core.Read(request.fd, memory.GetPointer(request.buffer), request.size, request.buffer,
-                       t);
+  return MeasureLatency("Read", [&] {
+    return MakeIPCReply([&](Ticks t) {
+      auto& system = GetSystem();
+      auto& memory = system.GetMemory();
+      return m_core.Read(request.fd, memory.GetPointer(request.buffer), request.size,
+                         request.buffer, t);
+    });
   });
 }
 
@@ -354,11 +416,13 @@ s32 FSCore::Read(u64 fd, u8* data, u32 size, std::optional<u32> ipc_buffer_addr,
 
 std::optional<IPCReply> FSDevice::Write(const ReadWriteRequest& request)
 {
-  return MakeIPCReply([&](Ticks t) {
-    auto& system = GetSystem();
-    auto& memory = system.GetMemory();
-    return m_core.Write(request.fd, memory.GetPointer(request.buffer), request.size, request.buffer,
-                        t);
+  return MeasureLatency("Write", [&] {
+    return MakeIPCReply([&](Ticks t) {
+      auto& system = GetSystem();
+      auto& memory = system.GetMemory();
+      return m_core.Write(request.fd, memory.GetPointer(request.buffer), request.size,
+                          request.buffer, t);
+    });
   });
 }
 
@@ -385,8 +449,10 @@ s32 FSCore::Write(u64 fd, const u8* data, u32 size, std::optional<u32> ipc_buffe
 
 std::optional<IPCReply> FSDevice::Seek(const SeekRequest& request)
 {
-  return MakeIPCReply([&](Ticks t) {
-    return m_core.Seek(request.fd, request.offset, HLE::FS::SeekMode(request.mode), t);
+  return MeasureLatency("Seek", [&] {
+    return MakeIPCReply([&](Ticks t) {
+      return m_core.Seek(request.fd, request.offset, HLE::FS::SeekMode(request.mode), t);
+    });
   });
 }
 
@@ -453,27 +519,28 @@ std::optional<IPCReply> FSDevice::IOCtl(const IOCtlRequest& request)
   switch (request.request)
   {
   case ISFS_IOCTL_FORMAT:
-    return Format(it->second, request);
+    return MeasureLatency("Format", [&] { return Format(it->second, request); });
   case ISFS_IOCTL_GETSTATS:
-    return GetStats(it->second, request);
+    return MeasureLatency("GetStats", [&] { return GetStats(it->second, request); });
   case ISFS_IOCTL_CREATEDIR:
-    return CreateDirectory(it->second, request);
+    return MeasureLatency("CreateDirectory", [&] { return CreateDirectory(it->second, request); });
   case ISFS_IOCTL_SETATTR:
-    return SetAttribute(it->second, request);
+    return MeasureLatency("SetAttribute", [&] { return SetAttribute(it->second, request); });
   case ISFS_IOCTL_GETATTR:
-    return GetAttribute(it->second, request);
+    return MeasureLatency("GetAttribute", [&] { return GetAttribute(it->second, request); });
   case ISFS_IOCTL_DELETE:
-    return DeleteFile(it->second, request);
+    return MeasureLatency("DeleteFile", [&] { return DeleteFile(it->second, request); });
   case ISFS_IOCTL_RENAME:
-    return RenameFile(it->second, request);
+    return MeasureLatency("RenameFile", [&] { return RenameFile(it->second, request); });
   case ISFS_IOCTL_CREATEFILE:
-    return CreateFile(it->second, request);
+    return MeasureLatency("CreateFile", [&] { return CreateFile(it->second, request); });
   case ISFS_IOCTL_SETFILEVERCTRL:
-    return SetFileVersionControl(it->second, request);
+    return MeasureLatency("SetFileVersionControl",
+                          [&] { return SetFileVersionControl(it->second, request); });
   case ISFS_IOCTL_GETFILESTATS:
-    return GetFileStats(it->second, request);
+    return MeasureLatency("GetFileStats", [&] { return GetFileStats(it->second, request); });
   case ISFS_IOCTL_SHUTDOWN:
-    return Shutdown(it->second, request);
+    return MeasureLatency("Shutdown", [&] { return Shutdown(it->second, request); });
   default:
     return GetFSReply(ConvertResult(ResultCode::Invalid));
   }
@@ -488,9 +555,9 @@ std::optional<IPCReply> FSDevice::IOCtlV(const IOCtlVRequest& request)
   switch (request.request)
   {
   case ISFS_IOCTLV_READDIR:
-    return ReadDirectory(it->second, request);
+    return MeasureLatency("ReadDirectory", [&] { return ReadDirectory(it->second, request); });
   case ISFS_IOCTLV_GETUSAGE:
-    return GetUsage(it->second, request);
+    return MeasureLatency("GetUsage", [&] { return GetUsage(it->second, request); });
   default:
     return GetFSReply(ConvertResult(ResultCode::Invalid));
   }
@@ -780,6 +847,7 @@ IPCReply FSDevice::GetUsage(const Handle& handle, const IOCtlVRequest& request)
 IPCReply FSDevice::Shutdown(const Handle& handle, const IOCtlRequest& request)
 {
   INFO_LOG_FMT(IOS_FS, "Shutdown");
+  m_ios.GetFS()->Flush();
   return GetFSReply(IPC_SUCCESS);
 }
 }  // namespace IOS::HLE
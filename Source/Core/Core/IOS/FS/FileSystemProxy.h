@@ -7,6 +7,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "Common/CommonTypes.h"
@@ -129,6 +130,11 @@ public:
   std::optional<IPCReply> IOCtl(const IOCtlRequest& request) override;
   std::optional<IPCReply> IOCtlV(const IOCtlVRequest& request) override;
 
+  void Update() override;
+  // IOS modules use the FS directly, so the backend needs to be flushed even when no emulated
+  // software has opened /dev/fs.
+  bool IsOpened() const override { return true; }
+
 private:
   enum
   {
@@ -163,6 +169,25 @@ private:
   IPCReply GetUsage(const Handle& handle, const IOCtlVRequest& request);
   IPCReply Shutdown(const Handle& handle, const IOCtlRequest& request);
 
+  /// How much host time requests took, in buckets of powers of two microseconds.
+  struct LatencyHistogram
+  {
+    static constexpr size_t NUM_BUCKETS = 24;
+
+    void Add(u64 us);
+
+    std::array<u64, NUM_BUCKETS> counts{};
+    u64 total_us = 0;
+    u64 max_us = 0;
+  };
+
+  template <typename Function>
+  std::optional<IPCReply> MeasureLatency(std::string_view operation, Function function);
+  void LogLatencyHistograms() const;
+
   FSCore& m_core;
+  u64 m_last_flush_ms = 0;
+  // Not savestated, as this only describes the host.
+  std::map<std::string_view, LatencyHistogram> m_latency_histograms;
 };
 }  // namespace IOS::HLE
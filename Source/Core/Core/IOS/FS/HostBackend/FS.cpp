@@ -169,7 +169,16 @@ HostFileSystem::HostFileSystem(const std::string& root_path,
   LoadFst();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  Flush();
+}
+
+void HostFileSystem::Flush()
+{
+  FlushOpenFiles();
+  FlushFst();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
@@ -222,8 +231,12 @@ void HostFileSystem::LoadFst()
   m_root_entry = *root_entry;
 }
 
-void HostFileSystem::SaveFst()
+void HostFileSystem::FlushFst()
 {
+  if (!m_fst_dirty)
+    return;
+  m_fst_dirty = false;
+
   std::vector<SerializedFstEntry> to_write;
   auto collect_entries = [&to_write](const auto& collect, const FstEntry& entry) -> void {
     SerializedFstEntry& serialized = to_write.emplace_back();
@@ -390,6 +403,7 @@ void HostFileSystem::DoState(PointerWrap& p)
   // Temporarily close the file, to prevent any issues with the savestating of files/folders.
   for (Handle& handle : m_handles)
     handle.host_file.reset();
+  FlushFst();
 
   // The format for the next part of the save state is follows:
   // 1. bool Movie::WasMovieActiveWhenStateSaved() &&
@@ -457,6 +471,7 @@ void HostFileSystem::DoState(PointerWrap& p)
 
 ResultCode HostFileSystem::Format(Uid uid)
 {
+  FlushOpenFiles();
   if (uid != 0)
     return ResultCode::AccessDenied;
   if (m_root_path.empty())
@@ -465,7 +480,7 @@ ResultCode HostFileSystem::Format(Uid uid)
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   ResetFst();
-  SaveFst();
+  MarkFstDirty();
   // Reset and close all handles.
   m_handles = {};
   return ResultCode::Success;
@@ -511,7 +526,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.uid = uid;
   child->data.gid = gid;
   child->data.attribute = attr;
-  SaveFst();
+  MarkFstDirty();
   return ResultCode::Success;
 }
 
@@ -543,6 +558,7 @@ bool HostFileSystem::IsDirectoryInUse(const std::string& path) const
 
 ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
 {
+  FlushOpenFiles();
   if (!IsValidNonRootPath(path))
     return ResultCode::Invalid;
 
@@ -570,7 +586,7 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
                                GetNamePredicate(split_path.file_name));
   if (it != parent->children.end())
     parent->children.erase(it);
-  SaveFst();
+  MarkFstDirty();
 
   return ResultCode::Success;
 }
@@ -578,6 +594,7 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
 ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
                                   const std::string& new_path)
 {
+  FlushOpenFiles();
   if (!IsValidNonRootPath(old_path) || !IsValidNonRootPath(new_path))
     return ResultCode::Invalid;
 
@@ -666,7 +683,7 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
     old_parent->children.erase(it);
   }
 
-  SaveFst();
+  MarkFstDirty();
 
   return ResultCode::Success;
 }
@@ -727,6 +744,7 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid uid, Gid gid,
 
 Result<Metadata> HostFileSystem::GetMetadata(Uid uid, Gid gid, const std::string& path)
 {
+  FlushOpenFiles();
   const FstEntry* entry = nullptr;
   if (path == "/")
   {
@@ -757,6 +775,7 @@ Result<Metadata> HostFileSystem::GetMetadata(Uid uid, Gid gid, const std::string
 ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path, Uid uid, Gid gid,
                                        FileAttribute attr, Modes modes)
 {
+  FlushOpenFiles();
   if (!IsValidPath(path))
     return ResultCode::Invalid;
 
@@ -780,7 +799,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
     entry->data.uid = uid;
     entry->data.attribute = attr;
     entry->data.modes = modes;
-    SaveFst();
+    MarkFstDirty();
   }
 
   return ResultCode::Success;
@@ -819,6 +838,7 @@ Result<NandStats> HostFileSystem::GetNandStats()
 
 Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_path)
 {
+  FlushOpenFiles();
   if (!IsValidPath(wii_path))
     return ResultCode::Invalid;
 
@@ -6,6 +6,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,7 @@ public:
   ~HostFileSystem();
 
   void DoState(PointerWrap& p) override;
+  void Flush() override;
 
   ResultCode Format(Uid uid) override;
 
@@ -75,12 +77,24 @@ private:
     std::vector<FstEntry> children;
   };
 
+  struct HostFile
+  {
+    u64 GetSize() const { return cached_data ? cached_data->size() : file.GetSize(); }
+
+    std::string host_path;
+    File::IOFile file;
+    /// Small files are read into memory when they are opened. Reads and writes only use this
+    /// copy, which is written back to the host file when the file is closed or flushed.
+    std::optional<std::vector<u8>> cached_data;
+    bool dirty = false;
+  };
+
   struct Handle
   {
     bool opened = false;
     Mode mode = Mode::None;
     std::string wii_path;
-    std::shared_ptr<File::IOFile> host_file;
+    std::shared_ptr<HostFile> host_file;
     u32 file_offset = 0;
   };
   Handle* AssignFreeHandle();
@@ -93,7 +107,10 @@ private:
     bool is_redirect;
   };
   HostFilename BuildFilename(const std::string& wii_path) const;
-  std::shared_ptr<File::IOFile> OpenHostFile(const std::string& host_path);
+  std::shared_ptr<HostFile> OpenHostFile(const std::string& host_path);
+  static bool WriteBackHostFile(HostFile* host_file);
+  /// Must be called before anything accesses the host files by path.
+  void FlushOpenFiles();
 
   ResultCode CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
                                    FileAttribute attribute, Modes modes, bool is_file);
@@ -103,7 +120,10 @@ private:
   std::string GetFstFilePath() const;
   void ResetFst();
   void LoadFst();
-  void SaveFst();
+  /// The FST is only written to the host by FlushFst, so that a sequence of operations
+  /// (such as a game deleting, creating and renaming its save file) only writes it once.
+  void MarkFstDirty() { m_fst_dirty = true; }
+  void FlushFst();
   /// Get the FST entry for a file (or directory).
   /// Automatically creates fallback entries for parents if they do not exist.
   /// Returns nullptr if the path is invalid or the file does not exist.
@@ -118,8 +138,9 @@ private:
   /// and we do not want FS to break if the user adds or removes files in their
   /// filesystem root manually.
   FstEntry m_root_entry{};
+  bool m_fst_dirty = false;
   std::string m_root_path;
-  std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
+  std::map<std::string, std::weak_ptr<HostFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
 
   FstEntry m_redirect_fst{};
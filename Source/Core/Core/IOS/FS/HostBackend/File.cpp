@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
@@ -13,8 +15,13 @@
 
 namespace IOS::HLE::FS
 {
+// Save files are usually small and accessed with many small reads and writes, each of which would
+// otherwise be a host file operation. Larger files (such as channel contents) use the host file.
+constexpr u64 MAX_CACHED_FILE_SIZE = 0x100000;
+
 // This isn't theadsafe, but it's only called from the CPU thread.
-std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
+std::shared_ptr<HostFileSystem::HostFile>
+HostFileSystem::OpenHostFile(const std::string& host_path)
 {
   // On the wii, all file operations are strongly ordered.
   // If a game opens the same file twice (or 8 times, looking at you PokePark Wii)
@@ -60,20 +67,55 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   }
 
   // This code will be called when all references to the shared pointer below have been removed.
-  auto deleter = [this, host_path](File::IOFile* ptr) {
+  auto deleter = [this, host_path](HostFile* ptr) {
+    WriteBackHostFile(ptr);
     delete ptr;                     // IOFile's deconstructor closes the file.
     m_open_files.erase(host_path);  // erase the weak pointer from the list of open files.
   };
 
   // Use the custom deleter from above.
-  std::shared_ptr<File::IOFile> file_ptr(new File::IOFile(std::move(file)), deleter);
+  std::shared_ptr<HostFile> file_ptr(new HostFile{host_path, std::move(file)}, deleter);
+
+  const u64 size = file_ptr->file.GetSize();
+  if (size <= MAX_CACHED_FILE_SIZE)
+  {
+    std::vector<u8> data(size);
+    if (file_ptr->file.ReadBytes(data.data(), data.size()))
+      file_ptr->cached_data = std::move(data);
+  }
 
   // Store a weak pointer to our newly opened file in the cache.
-  m_open_files[host_path] = std::weak_ptr<File::IOFile>(file_ptr);
+  m_open_files[host_path] = std::weak_ptr<HostFile>(file_ptr);
 
   return file_ptr;
 }
 
+bool HostFileSystem::WriteBackHostFile(HostFile* host_file)
+{
+  if (!host_file->dirty)
+    return true;
+
+  const std::vector<u8>& data = *host_file->cached_data;
+  if (!host_file->file.Seek(0, File::SeekOrigin::Begin) ||
+      !host_file->file.WriteBytes(data.data(), data.size()) || !host_file->file.Flush())
+  {
+    ERROR_LOG_FMT(IOS_FS, "Failed to write back {}", host_file->host_path);
+    return false;
+  }
+
+  host_file->dirty = false;
+  return true;
+}
+
+void HostFileSystem::FlushOpenFiles()
+{
+  for (const auto& entry : m_open_files)
+  {
+    if (const std::shared_ptr<HostFile> host_file = entry.second.lock())
+      WriteBackHostFile(host_file.get());
+  }
+}
+
 Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
 {
   Handle* handle = AssignFreeHandle();
@@ -115,7 +157,7 @@ ResultCode HostFileSystem::Close(Fd fd)
 Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Read)) == 0)
@@ -126,11 +168,19 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
   if (count + handle->file_offset > file_size)
     count = file_size - handle->file_offset;
 
+  if (const std::optional<std::vector<u8>>& data = handle->host_file->cached_data)
+  {
+    std::copy_n(data->begin() + handle->file_offset, count, ptr);
+    handle->file_offset += count;
+    return count;
+  }
+
   // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, handle->host_file->GetHandle()));
+  File::IOFile& file = handle->host_file->file;
+  file.Seek(handle->file_offset, File::SeekOrigin::Begin);
+  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, file.GetHandle()));
 
-  if (actually_read != count && ferror(handle->host_file->GetHandle()))
+  if (actually_read != count && ferror(file.GetHandle()))
     return ResultCode::AccessDenied;
 
   // IOS returns the number of bytes read and adds that value to the seek position,
@@ -142,15 +192,36 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
+  HostFile& host_file = *handle->host_file;
+  if (host_file.cached_data)
+  {
+    std::vector<u8>& data = *host_file.cached_data;
+    const u64 end = u64(handle->file_offset) + count;
+    if (end <= MAX_CACHED_FILE_SIZE)
+    {
+      if (end > data.size())
+        data.resize(end);
+      std::copy_n(ptr, count, data.begin() + handle->file_offset);
+      host_file.dirty = true;
+      handle->file_offset += count;
+      return count;
+    }
+
+    // The file has become too large to be kept in memory
+    if (!WriteBackHostFile(&host_file))
+      return ResultCode::AccessDenied;
+    host_file.cached_data.reset();
+  }
+
   // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  if (!handle->host_file->WriteBytes(ptr, count))
+  host_file.file.Seek(handle->file_offset, File::SeekOrigin::Begin);
+  if (!host_file.file.WriteBytes(ptr, count))
     return ResultCode::AccessDenied;
 
   handle->file_offset += count;
@@ -160,7 +231,7 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   u32 new_position = 0;
@@ -190,7 +261,7 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 Result<FileStatus> HostFileSystem::GetFileStatus(Fd fd)
 {
   const Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   FileStatus status;
@@ -125,6 +125,8 @@ static std::string s_InputDisplay[8];
 
 static std::string s_current_file_name;
 
+static std::function<void()> s_playback_ended_callback;
+
 static void GetSettings();
 static bool IsMovieHeader(const std::array<u8, 4>& magic)
 {
@@ -1377,9 +1379,17 @@ void EndPlayInput(bool cont)
     // tmpInput = nullptr;
 
     Core::QueueHostJob([=] { Core::UpdateWantDeterminism(); });
+
+    if (s_playback_ended_callback)
+      s_playback_ended_callback();
   }
 }
 
+void SetPlaybackEndedCallback(std::function<void()> callback)
+{
+  s_playback_ended_callback = std::move(callback);
+}
+
 // NOTE: Save State + Host Thread
 void SaveRecording(const std::string& filename)
 {
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <cstring>
+#include <functional>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -188,6 +189,8 @@ void PlayController(GCPadStatus* PadStatus, int controllerID);
 bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
                  const WiimoteEmu::EncryptionKey& key);
 void EndPlayInput(bool cont);
+// The callback is run when playback ends, on the thread which ended it.
+void SetPlaybackEndedCallback(std::function<void()> callback);
 void SaveRecording(const std::string& filename);
 void DoState(PointerWrap& p);
 void Shutdown();
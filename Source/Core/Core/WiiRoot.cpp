@@ -388,6 +388,11 @@ void CleanUpWiiFileSystemContents(const BootSessionData& boot_session_data)
 
   INFO_LOG_FMT(CORE, "Wii FS Cleanup: Copying from temporary FS to configured_fs.");
 
+  IOS::HLE::EmulationKernel* ios = IOS::HLE::GetIOS();
+
+  // The redirected files are moved on the host, so they must be up to date
+  ios->GetFS()->Flush();
+
   // copy back the temp nand redirected files to where they should normally be redirected to
   for (const auto& redirect : s_temp_nand_redirects)
   {
@@ -395,8 +400,6 @@ void CleanUpWiiFileSystemContents(const BootSessionData& boot_session_data)
     File::MoveWithOverwrite(redirect.temp_path, redirect.real_path);
   }
 
-  IOS::HLE::EmulationKernel* ios = IOS::HLE::GetIOS();
-
   // clear the redirects in the session FS, otherwise the back-copy might grab redirected files
   s_nand_redirects.clear();
   ios->GetFS()->SetNandRedirects({});
@@ -42,6 +42,7 @@ enum class BlobType
   MOD_DESCRIPTOR,
   NFS,
   SPLIT_PLAIN,
+  DEDUP,
 };
 
 // If you convert an ISO file to another format and then call GetDataSize on it, what is the result?
@@ -198,9 +199,14 @@ bool ConvertToGCZ(BlobReader* infile, const std::string& infile_path,
                   CompressCB callback);
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
                     const std::string& outfile_path, CompressCB callback);
+// memory_budget is how many bytes the compression threads may use, or 0 for one thread per core.
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback);
+                       int chunk_size, u64 memory_budget, CompressCB callback);
+// store_path may be relative to the directory of outfile_path, and is stored as given.
+bool ConvertToDedup(BlobReader* infile, const std::string& infile_path,
+                    const std::string& outfile_path, const std::string& store_path,
+                    int chunk_size, CompressCB callback);
 
 }  // namespace DiscIO
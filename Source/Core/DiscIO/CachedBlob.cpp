@@ -0,0 +1,326 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/CachedBlob.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/WorkQueueThread.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/VolumeWii.h"
+
+namespace DiscIO
+{
+// Decompressed data to keep around, and how much of it to decompress ahead of the current read.
+constexpr u64 CACHE_SIZE = 64 * 1024 * 1024;
+constexpr u64 READ_AHEAD_SIZE = 16 * 1024 * 1024;
+constexpr u64 MIN_READ_AHEAD_BLOCKS = 2;
+constexpr u64 MAX_READ_AHEAD_BLOCKS = 64;
+constexpr u32 MAX_READ_AHEAD_THREADS = 4;
+
+CachedBlobReader::CachedBlobReader(std::unique_ptr<BlobReader> reader,
+                                   std::vector<std::unique_ptr<BlobReader>> read_ahead_readers)
+    : m_reader(std::move(reader)), m_read_ahead_readers(std::move(read_ahead_readers))
+{
+  m_block_size = m_reader->GetBlockSize();
+  m_data_size = m_reader->GetDataSize();
+
+  // Reads from Wii partitions skip the hashes, so a block of encrypted data holds less data.
+  m_decrypted_block_size =
+      m_block_size >= VolumeWii::BLOCK_TOTAL_SIZE ?
+          m_block_size / VolumeWii::BLOCK_TOTAL_SIZE * VolumeWii::BLOCK_DATA_SIZE :
+          VolumeWii::BLOCK_DATA_SIZE;
+
+  m_read_ahead_blocks =
+      std::clamp(READ_AHEAD_SIZE / m_block_size, MIN_READ_AHEAD_BLOCKS, MAX_READ_AHEAD_BLOCKS);
+  m_max_blocks =
+      static_cast<size_t>(std::max(CACHE_SIZE / m_block_size, m_read_ahead_blocks * 2));
+
+  for (size_t i = 0; i < m_read_ahead_readers.size(); ++i)
+  {
+    BlobReader* const read_ahead_reader = m_read_ahead_readers[i].get();
+    m_read_ahead_threads.push_back(std::make_unique<Common::WorkQueueThread<ReadAheadRequest>>(
+        fmt::format("Disc read-ahead {}", i), [this, read_ahead_reader](ReadAheadRequest request) {
+          LoadQueuedBlock(read_ahead_reader, request.key, request.size);
+        }));
+  }
+}
+
+CachedBlobReader::~CachedBlobReader()
+{
+  // The worker threads use the readers and the cache, so stop them first.
+  for (auto& thread : m_read_ahead_threads)
+    thread->Shutdown(true);
+}
+
+std::unique_ptr<CachedBlobReader>
+CachedBlobReader::Create(std::unique_ptr<BlobReader> reader,
+                         std::vector<std::unique_ptr<BlobReader>> read_ahead_readers)
+{
+  if (!reader || reader->GetBlockSize() == 0)
+    return nullptr;
+
+  return std::unique_ptr<CachedBlobReader>(
+      new CachedBlobReader(std::move(reader), std::move(read_ahead_readers)));
+}
+
+bool CachedBlobReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  return ReadCached(offset, size, out_ptr, NO_PARTITION);
+}
+
+bool CachedBlobReader::SupportsReadWiiDecrypted(u64 offset, u64 size,
+                                                u64 partition_data_offset) const
+{
+  return m_reader->SupportsReadWiiDecrypted(offset, size, partition_data_offset);
+}
+
+bool CachedBlobReader::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
+                                        u64 partition_data_offset)
+{
+  return ReadCached(offset, size, out_ptr, partition_data_offset);
+}
+
+u64 CachedBlobReader::GetCacheBlockSize(u64 partition_data_offset) const
+{
+  return partition_data_offset == NO_PARTITION ? m_block_size : m_decrypted_block_size;
+}
+
+// Returns the size of the block, or nothing if it can't be read as a whole, e.g. because it
+// crosses the end of the disc or the end of a partition.
+std::optional<u64> CachedBlobReader::GetCacheableBlockSize(const BlockKey& key) const
+{
+  const u64 block_size = GetCacheBlockSize(key.partition_data_offset);
+  const u64 offset = key.index * block_size;
+
+  if (key.partition_data_offset == NO_PARTITION)
+  {
+    if (offset >= m_data_size)
+      return std::nullopt;
+    return std::min(block_size, m_data_size - offset);
+  }
+
+  if (!m_reader->SupportsReadWiiDecrypted(offset, block_size, key.partition_data_offset))
+    return std::nullopt;
+  return block_size;
+}
+
+bool CachedBlobReader::ReadCached(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset)
+{
+  const u64 block_size = GetCacheBlockSize(partition_data_offset);
+
+  while (size > 0)
+  {
+    const BlockKey key{partition_data_offset, offset / block_size};
+    const u64 offset_in_block = offset % block_size;
+    const u64 bytes_to_read = std::min(block_size - offset_in_block, size);
+
+    const std::optional<u64> cacheable_size = GetCacheableBlockSize(key);
+    if (cacheable_size && offset_in_block + bytes_to_read <= *cacheable_size)
+    {
+      const std::shared_ptr<const std::vector<u8>> block = GetBlock(key, *cacheable_size);
+      if (!block)
+        return false;
+
+      std::memcpy(out_ptr, block->data() + offset_in_block, bytes_to_read);
+      QueueReadAhead(key);
+    }
+    else
+    {
+      if (!ReadUncached(offset, bytes_to_read, out_ptr, partition_data_offset))
+        return false;
+    }
+
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+    out_ptr += bytes_to_read;
+  }
+
+  return true;
+}
+
+bool CachedBlobReader::ReadUncached(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset)
+{
+  if (partition_data_offset == NO_PARTITION)
+    return m_reader->Read(offset, size, out_ptr);
+  return m_reader->ReadWiiDecrypted(offset, size, out_ptr, partition_data_offset);
+}
+
+bool CachedBlobReader::ReadBlock(BlobReader* reader, const BlockKey& key, u64 size,
+                                 std::vector<u8>* out) const
+{
+  out->resize(size);
+
+  const u64 offset = key.index * GetCacheBlockSize(key.partition_data_offset);
+  if (key.partition_data_offset == NO_PARTITION)
+    return reader->Read(offset, size, out->data());
+  return reader->ReadWiiDecrypted(offset, size, out->data(), key.partition_data_offset);
+}
+
+std::shared_ptr<const std::vector<u8>> CachedBlobReader::GetBlock(const BlockKey& key, u64 size)
+{
+  std::unique_lock lock(m_mutex);
+
+  while (true)
+  {
+    auto it = m_blocks.find(key);
+    if (it != m_blocks.end() && it->second.state == BlockState::Ready)
+    {
+      MarkUsed(&it->second);
+      return it->second.data;
+    }
+
+    if (it != m_blocks.end() && it->second.state == BlockState::Loading)
+    {
+      // A worker thread is already decompressing this block
+      m_block_loaded.wait(lock);
+      continue;
+    }
+
+    if (it == m_blocks.end())
+    {
+      m_lru.push_front(key);
+      it = m_blocks.emplace(key, Block{BlockState::Loading, nullptr, m_lru.begin()}).first;
+    }
+    it->second.state = BlockState::Loading;
+    lock.unlock();
+
+    auto data = std::make_shared<std::vector<u8>>();
+    const bool success = ReadBlock(m_reader.get(), key, size, data.get());
+
+    lock.lock();
+    // Blocks are never evicted while they are loading
+    it = m_blocks.find(key);
+    if (!success)
+    {
+      m_lru.erase(it->second.lru_position);
+      m_blocks.erase(it);
+      m_block_loaded.notify_all();
+      return nullptr;
+    }
+
+    it->second.state = BlockState::Ready;
+    it->second.data = data;
+    MarkUsed(&it->second);
+    m_block_loaded.notify_all();
+    EvictBlocks();
+    return data;
+  }
+}
+
+void CachedBlobReader::QueueReadAhead(const BlockKey& key)
+{
+  // Only read ahead once the reads have moved on to the next block, which tells sequential
+  // reads apart from random accesses.
+  const bool sequential = m_last_key &&
+                          m_last_key->partition_data_offset == key.partition_data_offset &&
+                          m_last_key->index + 1 == key.index;
+  m_last_key = key;
+  if (!sequential || m_read_ahead_threads.empty())
+    return;
+
+  for (u64 i = 1; i <= m_read_ahead_blocks; ++i)
+  {
+    const BlockKey next_key{key.partition_data_offset, key.index + i};
+    const std::optional<u64> size = GetCacheableBlockSize(next_key);
+    if (!size)
+      break;
+
+    {
+      std::lock_guard lock(m_mutex);
+      if (m_blocks.contains(next_key))
+        continue;
+
+      m_lru.push_front(next_key);
+      m_blocks.emplace(next_key, Block{BlockState::Queued, nullptr, m_lru.begin()});
+    }
+
+    m_read_ahead_threads[m_next_read_ahead_thread]->Push(ReadAheadRequest{next_key, *size});
+    m_next_read_ahead_thread = (m_next_read_ahead_thread + 1) % m_read_ahead_threads.size();
+  }
+}
+
+void CachedBlobReader::LoadQueuedBlock(BlobReader* reader, const BlockKey& key, u64 size)
+{
+  {
+    std::lock_guard lock(m_mutex);
+    const auto it = m_blocks.find(key);
+    if (it == m_blocks.end() || it->second.state != BlockState::Queued)
+      return;
+    it->second.state = BlockState::Loading;
+  }
+
+  auto data = std::make_shared<std::vector<u8>>();
+  const bool success = ReadBlock(reader, key, size, data.get());
+
+  std::lock_guard lock(m_mutex);
+  const auto it = m_blocks.find(key);
+  if (success)
+  {
+    it->second.state = BlockState::Ready;
+    it->second.data = std::move(data);
+  }
+  else
+  {
+    // Leave it to the reading thread to report the error, if the block is needed at all
+    WARN_LOG_FMT(DISCIO, "Failed to read ahead block {} of partition {:#x}", key.index,
+                 key.partition_data_offset);
+    m_lru.erase(it->second.lru_position);
+    m_blocks.erase(it);
+  }
+  m_block_loaded.notify_all();
+  EvictBlocks();
+}
+
+void CachedBlobReader::MarkUsed(Block* block)
+{
+  m_lru.splice(m_lru.begin(), m_lru, block->lru_position);
+}
+
+void CachedBlobReader::EvictBlocks()
+{
+  auto it = m_lru.end();
+  while (m_blocks.size() > m_max_blocks && it != m_lru.begin())
+  {
+    --it;
+    const auto block = m_blocks.find(*it);
+    if (block->second.state != BlockState::Ready)
+      continue;
+
+    m_blocks.erase(block);
+    it = m_lru.erase(it);
+  }
+}
+
+std::unique_ptr<BlobReader> CreateCachedBlobReader(const std::string& path)
+{
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(path);
+  if (!reader || reader->GetBlockSize() == 0 || reader->HasFastRandomAccessInBlock())
+    return reader;
+
+  const u32 thread_count =
+      std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_READ_AHEAD_THREADS);
+  std::vector<std::unique_ptr<BlobReader>> read_ahead_readers;
+  for (u32 i = 0; i < thread_count; ++i)
+  {
+    std::unique_ptr<BlobReader> read_ahead_reader = CreateBlobReader(path);
+    if (!read_ahead_reader)
+      break;
+    read_ahead_readers.push_back(std::move(read_ahead_reader));
+  }
+
+  return CachedBlobReader::Create(std::move(reader), std::move(read_ahead_readers));
+}
+
+}  // namespace DiscIO
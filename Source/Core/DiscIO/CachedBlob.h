@@ -0,0 +1,130 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <compare>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+// This class wraps a BlobReader for a format which has to decompress a whole block to read any
+// part of it. Decompressed blocks are kept in an LRU cache, and while the disc is being read
+// sequentially, the blocks that follow are decompressed ahead of time on worker threads.
+// Each worker thread has its own BlobReader for the same file, as BlobReaders aren't thread-safe.
+class CachedBlobReader final : public BlobReader
+{
+public:
+  static std::unique_ptr<CachedBlobReader>
+  Create(std::unique_ptr<BlobReader> reader,
+         std::vector<std::unique_ptr<BlobReader>> read_ahead_readers);
+  ~CachedBlobReader() override;
+
+  BlobType GetBlobType() const override { return m_reader->GetBlobType(); }
+
+  u64 GetRawSize() const override { return m_reader->GetRawSize(); }
+  u64 GetDataSize() const override { return m_reader->GetDataSize(); }
+  DataSizeType GetDataSizeType() const override { return m_reader->GetDataSizeType(); }
+
+  u64 GetBlockSize() const override { return m_reader->GetBlockSize(); }
+  bool HasFastRandomAccessInBlock() const override
+  {
+    return m_reader->HasFastRandomAccessInBlock();
+  }
+  std::string GetCompressionMethod() const override { return m_reader->GetCompressionMethod(); }
+  std::optional<int> GetCompressionLevel() const override
+  {
+    return m_reader->GetCompressionLevel();
+  }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+  bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override;
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
+
+private:
+  // Used as the partition data offset of blocks read with Read.
+  static constexpr u64 NO_PARTITION = ~u64(0);
+
+  struct BlockKey
+  {
+    u64 partition_data_offset;
+    u64 index;
+
+    auto operator<=>(const BlockKey&) const = default;
+  };
+
+  enum class BlockState
+  {
+    // Waiting for a worker thread. The first thread that needs it claims it.
+    Queued,
+    Loading,
+    Ready,
+  };
+
+  struct Block
+  {
+    BlockState state;
+    std::shared_ptr<const std::vector<u8>> data;
+    std::list<BlockKey>::iterator lru_position;
+  };
+
+  CachedBlobReader(std::unique_ptr<BlobReader> reader,
+                   std::vector<std::unique_ptr<BlobReader>> read_ahead_readers);
+
+  u64 GetCacheBlockSize(u64 partition_data_offset) const;
+  std::optional<u64> GetCacheableBlockSize(const BlockKey& key) const;
+
+  bool ReadCached(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset);
+  bool ReadUncached(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset);
+  std::shared_ptr<const std::vector<u8>> GetBlock(const BlockKey& key, u64 size);
+  bool ReadBlock(BlobReader* reader, const BlockKey& key, u64 size, std::vector<u8>* out) const;
+
+  void QueueReadAhead(const BlockKey& key);
+  void LoadQueuedBlock(BlobReader* reader, const BlockKey& key, u64 size);
+
+  // These must be called with m_mutex held.
+  void MarkUsed(Block* block);
+  void EvictBlocks();
+
+  struct ReadAheadRequest
+  {
+    BlockKey key;
+    u64 size;
+  };
+
+  std::unique_ptr<BlobReader> m_reader;
+  std::vector<std::unique_ptr<BlobReader>> m_read_ahead_readers;
+  std::vector<std::unique_ptr<Common::WorkQueueThread<ReadAheadRequest>>> m_read_ahead_threads;
+  size_t m_next_read_ahead_thread = 0;
+
+  u64 m_block_size;
+  u64 m_decrypted_block_size;
+  u64 m_data_size;
+  size_t m_max_blocks;
+  u64 m_read_ahead_blocks;
+  std::optional<BlockKey> m_last_key;
+
+  std::mutex m_mutex;
+  std::condition_variable m_block_loaded;
+  std::map<BlockKey, Block> m_blocks;
+  // Most recently used first
+  std::list<BlockKey> m_lru;
+};
+
+// Opens a disc image like CreateBlobReader. If reads from the format have to decompress whole
+// blocks, the reader is wrapped in a CachedBlobReader.
+std::unique_ptr<BlobReader> CreateCachedBlobReader(const std::string& path);
+
+}  // namespace DiscIO
@@ -0,0 +1,274 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/DedupBlob.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Align.h"
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/DiscUtils.h"
+
+namespace DiscIO
+{
+// Mapping a chunk is cheap, but not free, so keep the most recently used ones mapped
+constexpr size_t MAX_MAPPED_CHUNKS = 64;
+
+static std::string GetStorePath(const std::string& manifest_path, const std::string& store_path)
+{
+  const std::filesystem::path path = StringToPath(store_path);
+  if (path.is_absolute())
+    return store_path;
+
+  return PathToString(StringToPath(manifest_path).parent_path() / path);
+}
+
+std::string GetDedupChunkPath(const std::string& store_path, const Common::SHA1::Digest& digest)
+{
+  std::string hex;
+  for (const u8 byte : digest)
+    hex += fmt::format("{:02x}", byte);
+
+  // Spread the chunks over subdirectories, as some file systems get slow with huge directories
+  return fmt::format("{}/{}/{}", store_path, hex.substr(0, 2), hex.substr(2));
+}
+
+DedupBlobReader::DedupBlobReader(Common::MappedFile manifest, std::string store_path,
+                                 u64 data_size, u32 chunk_size, u64 digests_offset)
+    : m_manifest(std::move(manifest)), m_store_path(std::move(store_path)),
+      m_data_size(data_size), m_chunk_size(chunk_size), m_digests_offset(digests_offset)
+{
+}
+
+std::unique_ptr<DedupBlobReader> DedupBlobReader::Create(const std::string& path)
+{
+  Common::MappedFile manifest(path);
+  if (!manifest.IsOpen() || manifest.GetSize() < sizeof(DedupHeader))
+    return nullptr;
+
+  DedupHeader header;
+  std::memcpy(&header, manifest.GetData(), sizeof(header));
+  if (header.magic != DEDUP_MAGIC || header.version != DEDUP_VERSION ||
+      !IsDiscImageBlockSizeValid(static_cast<int>(header.chunk_size), BlobType::DEDUP))
+  {
+    ERROR_LOG_FMT(DISCIO, "{} is not a supported deduplicated disc image", path);
+    return nullptr;
+  }
+
+  // The header comes from the file, so avoid anything that could overflow
+  const u64 digests_offset = Common::AlignUp(sizeof(header) + header.store_path_size, 4);
+  const u64 chunks = header.data_size / header.chunk_size +
+                     (header.data_size % header.chunk_size != 0 ? 1 : 0);
+  if (manifest.GetSize() < digests_offset ||
+      chunks > (manifest.GetSize() - digests_offset) / Common::SHA1::DIGEST_LEN)
+  {
+    ERROR_LOG_FMT(DISCIO, "The manifest {} is truncated", path);
+    return nullptr;
+  }
+
+  const std::string store_path(
+      reinterpret_cast<const char*>(manifest.GetData() + sizeof(header)), header.store_path_size);
+
+  return std::unique_ptr<DedupBlobReader>(
+      new DedupBlobReader(std::move(manifest), GetStorePath(path, store_path), header.data_size,
+                          header.chunk_size, digests_offset));
+}
+
+const u8* DedupBlobReader::GetChunk(u64 index)
+{
+  const auto it = std::find_if(m_mapped_chunks.begin(), m_mapped_chunks.end(),
+                               [index](const MappedChunk& chunk) { return chunk.index == index; });
+  if (it != m_mapped_chunks.end())
+  {
+    m_mapped_chunks.splice(m_mapped_chunks.begin(), m_mapped_chunks, it);
+    return it->file.GetData();
+  }
+
+  Common::SHA1::Digest digest;
+  std::memcpy(digest.data(),
+              m_manifest.GetData() + m_digests_offset + index * Common::SHA1::DIGEST_LEN,
+              digest.size());
+
+  const std::string chunk_path = GetDedupChunkPath(m_store_path, digest);
+  Common::MappedFile file(chunk_path);
+  const u64 expected_size = std::min<u64>(m_chunk_size, m_data_size - index * m_chunk_size);
+  if (!file.IsOpen() || file.GetSize() != expected_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "Chunk {} is missing from the store: {}", index, chunk_path);
+    return nullptr;
+  }
+
+  if (m_mapped_chunks.size() >= MAX_MAPPED_CHUNKS)
+    m_mapped_chunks.pop_back();
+  m_mapped_chunks.push_front(MappedChunk{index, std::move(file)});
+  return m_mapped_chunks.front().file.GetData();
+}
+
+bool DedupBlobReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (offset + size > m_data_size || offset + size < offset)
+    return false;
+
+  while (size > 0)
+  {
+    const u64 index = offset / m_chunk_size;
+    const u64 offset_in_chunk = offset % m_chunk_size;
+    const u64 bytes_to_copy = std::min<u64>(m_chunk_size - offset_in_chunk, size);
+
+    const u8* chunk = GetChunk(index);
+    if (!chunk)
+      return false;
+    std::memcpy(out_ptr, chunk + offset_in_chunk, bytes_to_copy);
+
+    offset += bytes_to_copy;
+    size -= bytes_to_copy;
+    out_ptr += bytes_to_copy;
+  }
+
+  return true;
+}
+
+// Writes a chunk to the store unless it's already there. Returns false on failure.
+static bool AddChunkToStore(const std::string& store_path, const Common::SHA1::Digest& digest,
+                            const u8* data, size_t size, bool* already_stored)
+{
+  const std::string chunk_path = GetDedupChunkPath(store_path, digest);
+
+  *already_stored = File::Exists(chunk_path);
+  if (*already_stored)
+    return true;
+
+  // Write to a temporary file first, so that other readers of the store never see a partially
+  // written chunk
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(chunk_path);
+  if (!File::CreateFullPath(chunk_path))
+    return false;
+
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file.WriteBytes(data, size))
+    {
+      file.Close();
+      File::Delete(temp_path);
+      return false;
+    }
+  }
+
+  // If another process added the same chunk in the meantime, its copy is just as good
+  return File::Rename(temp_path, chunk_path) || File::Exists(chunk_path);
+}
+
+bool ConvertToDedup(BlobReader* infile, const std::string& infile_path,
+                    const std::string& outfile_path, const std::string& store_path,
+                    int chunk_size, CompressCB callback)
+{
+  ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
+  ASSERT(chunk_size > 0);
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertFmtT(
+        "Failed to open the output file \"{0}\".\n"
+        "Check that you have permissions to write the target folder and that the media can "
+        "be written.",
+        outfile_path);
+    return false;
+  }
+
+  const u64 data_size = infile->GetDataSize();
+  const DedupHeader header{DEDUP_MAGIC, DEDUP_VERSION, data_size, static_cast<u32>(chunk_size),
+                           static_cast<u32>(store_path.size())};
+  std::vector<u8> header_data(Common::AlignUp(sizeof(header) + store_path.size(), 4));
+  std::memcpy(header_data.data(), &header, sizeof(header));
+  std::memcpy(header_data.data() + sizeof(header), store_path.data(), store_path.size());
+
+  const std::string resolved_store_path = GetStorePath(outfile_path, store_path);
+  const u64 chunks = Common::AlignUp(data_size, chunk_size) / chunk_size;
+  const u64 progress_monitor = std::max<u64>(1, chunks / 100);
+  std::vector<u8> buffer(chunk_size);
+  u64 chunks_already_stored = 0;
+  bool success = outfile.WriteBytes(header_data.data(), header_data.size());
+  if (!success)
+  {
+    PanicAlertFmtT("Failed to write the output file \"{0}\".\n"
+                   "Check that you have enough space available on the target drive.",
+                   outfile_path);
+  }
+
+  for (u64 i = 0; success && i < chunks; ++i)
+  {
+    if (i % progress_monitor == 0)
+    {
+      const std::string text = Common::FmtFormatT(
+          "{0} of {1} chunks. {2} were already stored.", i, chunks, chunks_already_stored);
+      if (!callback(text, static_cast<float>(i) / chunks))
+      {
+        success = false;
+        break;
+      }
+    }
+
+    const u64 offset = i * chunk_size;
+    const size_t size = static_cast<size_t>(std::min<u64>(chunk_size, data_size - offset));
+    if (!infile->Read(offset, size, buffer.data()))
+    {
+      PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
+      success = false;
+      break;
+    }
+
+    const Common::SHA1::Digest digest = Common::SHA1::CalculateDigest(buffer.data(), size);
+    bool already_stored;
+    if (!AddChunkToStore(resolved_store_path, digest, buffer.data(), size, &already_stored))
+    {
+      PanicAlertFmtT("Failed to write to the store \"{0}\".\n"
+                     "Check that you have enough space available on the target drive.",
+                     resolved_store_path);
+      success = false;
+      break;
+    }
+    if (already_stored)
+      ++chunks_already_stored;
+
+    if (!outfile.WriteBytes(digest.data(), digest.size()))
+    {
+      PanicAlertFmtT("Failed to write the output file \"{0}\".\n"
+                     "Check that you have enough space available on the target drive.",
+                     outfile_path);
+      success = false;
+      break;
+    }
+  }
+
+  if (!success)
+  {
+    // Remove the incomplete manifest. Chunks that were added to the store are left there,
+    // since other disc images may use them.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+
+  INFO_LOG_FMT(DISCIO, "Deduplicated {}: {} of {} chunks were already stored", infile_path,
+               chunks_already_stored, chunks);
+  return true;
+}
+
+}  // namespace DiscIO
@@ -0,0 +1,86 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/MappedFile.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+static constexpr u32 DEDUP_MAGIC = 0x50554444;  // "DDUP" (byteswapped to little endian)
+static constexpr u32 DEDUP_VERSION = 1;
+
+// A deduplicated disc image is a small manifest file which lists the SHA-1 digest of every chunk
+// of the disc. The chunks themselves are files in a store directory, named after their digests,
+// so a chunk that several disc images have in common (such as a game and modded or regional
+// copies of it) is only stored once on disk and only cached once by the OS.
+//
+// The manifest is laid out like this, in little endian:
+// - DedupHeader
+// - The path of the store (store_path_size bytes, not null-terminated). A relative path is
+//   relative to the directory that the manifest is in.
+// - Padding to a multiple of 4 bytes
+// - The SHA-1 digest of each chunk
+struct DedupHeader
+{
+  u32 magic;
+  u32 version;
+  u64 data_size;
+  u32 chunk_size;
+  u32 store_path_size;
+};
+static_assert(sizeof(DedupHeader) == 24);
+
+class DedupBlobReader final : public BlobReader
+{
+public:
+  static std::unique_ptr<DedupBlobReader> Create(const std::string& path);
+
+  BlobType GetBlobType() const override { return BlobType::DEDUP; }
+
+  // Only counts the manifest, since the chunks may be shared with other disc images
+  u64 GetRawSize() const override { return m_manifest.GetSize(); }
+  u64 GetDataSize() const override { return m_data_size; }
+  DataSizeType GetDataSizeType() const override { return DataSizeType::Accurate; }
+
+  u64 GetBlockSize() const override { return m_chunk_size; }
+  bool HasFastRandomAccessInBlock() const override { return true; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+private:
+  struct MappedChunk
+  {
+    u64 index;
+    Common::MappedFile file;
+  };
+
+  DedupBlobReader(Common::MappedFile manifest, std::string store_path, u64 data_size,
+                  u32 chunk_size, u64 digests_offset);
+
+  const u8* GetChunk(u64 index);
+
+  Common::MappedFile m_manifest;
+  std::string m_store_path;
+  u64 m_data_size;
+  u32 m_chunk_size;
+  u64 m_digests_offset;
+
+  // Most recently used first
+  std::list<MappedChunk> m_mapped_chunks;
+};
+
+// Returns the path of the file in the store that holds the chunk with the given digest.
+std::string GetDedupChunkPath(const std::string& store_path, const Common::SHA1::Digest& digest);
+
+}  // namespace DiscIO
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdio>
 #include <cstring>
 #include <locale>
 #include <map>
@@ -82,7 +83,40 @@ u64 DiscContent::GetSize() const
   return m_size;
 }
 
-bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
+constexpr size_t MAX_OPEN_CONTENT_FILES = 64;
+
+bool ContentFileCache::Read(const std::string& path, u64 offset, u64 length, u8* buffer)
+{
+  auto it = std::find_if(m_files.begin(), m_files.end(),
+                         [&path](const OpenContentFile& file) { return file.path == path; });
+  if (it != m_files.end())
+  {
+    m_files.splice(m_files.begin(), m_files, it);
+  }
+  else
+  {
+    // Don't stop the user from editing the file while we keep it open
+    File::IOFile file(path, "rb", File::SharedAccess::ReadWrite);
+    if (!file.IsOpen())
+      return false;
+
+    // Every read seeks first, so stdio buffering would only add a copy, and could return stale
+    // data if the file is rewritten while it's open
+    std::setvbuf(file.GetHandle(), nullptr, _IONBF, 0);
+
+    if (m_files.size() >= MAX_OPEN_CONTENT_FILES)
+      m_files.pop_back();
+    m_files.push_front(OpenContentFile{path, std::move(file)});
+  }
+
+  // Reads past the end of a file that has been truncated since it was opened fail here, and the
+  // next read tries again
+  File::IOFile& file = m_files.front().file;
+  file.ClearError();
+  return file.Seek(offset, File::SeekOrigin::Begin) && file.ReadBytes(buffer, length);
+}
+
+bool DiscContent::Read(u64* offset, u64* length, u8** buffer, ContentFileCache* file_cache) const
 {
   if (m_size == 0)
     return true;
@@ -97,9 +131,8 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
     if (std::holds_alternative<ContentFile>(m_content_source))
     {
       const auto& content = std::get<ContentFile>(m_content_source);
-      File::IOFile file(content.m_filename, "rb");
-      if (!file.Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
-          !file.ReadBytes(*buffer, bytes_to_read))
+      if (!file_cache->Read(content.m_filename, content.m_offset + offset_in_content,
+                            bytes_to_read, *buffer))
       {
         return false;
       }
@@ -187,7 +220,7 @@ bool DiscContentContainer::Read(u64 offset, u64 length, u8* buffer) const
     if (length == 0)
       return true;
 
-    if (!it->Read(&offset, &length, &buffer))
+    if (!it->Read(&offset, &length, &buffer, &m_file_cache))
       return false;
 
     ++it;
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -16,6 +17,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/WiiEncryptionCache.h"
@@ -136,6 +138,24 @@ struct FSTBuilderNode
   }
 };
 
+// Keeps the most recently read files open, so that reading from a file doesn't mean opening it
+// again.
+class ContentFileCache
+{
+public:
+  bool Read(const std::string& path, u64 offset, u64 length, u8* buffer);
+
+private:
+  struct OpenContentFile
+  {
+    std::string path;
+    File::IOFile file;
+  };
+
+  // Most recently used first
+  std::list<OpenContentFile> m_files;
+};
+
 class DiscContent
 {
 public:
@@ -147,7 +167,7 @@ public:
   u64 GetOffset() const;
   u64 GetEndOffset() const;
   u64 GetSize() const;
-  bool Read(u64* offset, u64* length, u8** buffer) const;
+  bool Read(u64* offset, u64* length, u8** buffer, ContentFileCache* file_cache) const;
 
   bool operator==(const DiscContent& other) const { return GetEndOffset() == other.GetEndOffset(); }
   bool operator!=(const DiscContent& other) const { return !(*this == other); }
@@ -183,6 +203,7 @@ public:
 
 private:
   std::set<DiscContent> m_contents;
+  mutable ContentFileCache m_file_cache;
 };
 
 class DirectoryBlobPartition
@@ -236,6 +236,12 @@ bool IsDiscImageBlockSizeValid(int block_size, DiscIO::BlobType format)
       return false;
     }
 
+    break;
+  case DiscIO::BlobType::DEDUP:
+    // Block size must be a power of 2, so that chunks line up with disc sectors
+    if (block_size < DEDUP_MIN_BLOCK_SIZE || !MathUtil::IsPow2(block_size))
+      return false;
+
     break;
   default:
     ASSERT(false);
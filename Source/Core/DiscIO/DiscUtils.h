@@ -75,6 +75,10 @@ constexpr int RVZ_MIN_BLOCK_SIZE = 0x8000;
 // 2 MiB (0x200000): for RVZ, block sizes larger than 2 MiB must be an integer multiple of 2 MiB.
 constexpr int RVZ_BIG_BLOCK_SIZE_LCM = 0x200000;
 
+// 32 KiB (0x8000), the size of a disc sector, is the smallest block size supported for
+// deduplicated disc images. Smaller chunks would mostly cost file system overhead.
+constexpr int DEDUP_MIN_BLOCK_SIZE = 0x8000;
+
 std::string NameForPartitionType(u32 partition_type, bool include_prefix);
 
 std::optional<u64> GetApploaderSize(const Volume& volume, const Partition& partition);
@@ -29,7 +29,8 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = Common::Result<ConversionResultCode, T>;
 
-// This class starts a number of compression threads and one output thread.
+// This class starts a number of compression threads (by default one per CPU core) and one output
+// thread.
 // The set_up_compress_thread_state function is called at the start of each compression thread.
 // When CompressAndWrite is called, the compress function will be called on one of the
 // compression threads, and then the output function will be called on the output thread.
@@ -45,10 +46,11 @@ public:
       std::function<ConversionResultCode(CompressThreadState*)> set_up_compress_thread_state,
       std::function<ConversionResult<OutputParameters>(CompressThreadState*, CompressParameters)>
           compress,
-      std::function<ConversionResultCode(OutputParameters)> output)
+      std::function<ConversionResultCode(OutputParameters)> output,
+      unsigned int threads = std::thread::hardware_concurrency())
       : m_set_up_compress_thread_state(std::move(set_up_compress_thread_state)),
         m_compress(std::move(compress)), m_output(std::move(output)),
-        m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency()))
+        m_threads(std::max<unsigned int>(1, threads))
   {
     m_compress_threads = std::make_unique<CompressThread[]>(m_threads);
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -23,12 +24,23 @@ public:
   NANDImporter();
   ~NANDImporter();
 
+  // Where the time went while importing. Reading includes finding the superblock.
+  struct Throughput
+  {
+    u64 files = 0;
+    u64 bytes_extracted = 0;
+    std::chrono::duration<double> total{};
+    std::chrono::duration<double> reading{};
+    std::chrono::duration<double> extracting{};
+  };
+
   // Extract a NAND image to the configured NAND root.
   // If the associated OTP/SEEPROM dump (keys.bin) is not included in the image,
   // get_otp_dump_path will be called to get a path to it.
-  void ImportNANDBin(const std::string& path_to_bin, std::function<void()> update_callback,
+  bool ImportNANDBin(const std::string& path_to_bin, std::function<void()> update_callback,
                      std::function<std::string()> get_otp_dump_path);
   bool ExtractCertificates();
+  const Throughput& GetThroughput() const { return m_throughput; }
 
   enum class Type
   {
@@ -64,12 +76,20 @@ public:
 #pragma pack(pop)
 
 private:
+  struct FileToExtract
+  {
+    NANDFSTEntry entry;
+    std::string path;
+  };
+
   bool ReadNANDBin(const std::string& path_to_bin, std::function<std::string()> get_otp_dump_path);
   bool FindSuperblock();
   std::string GetPath(const NANDFSTEntry& entry, const std::string& parent_path);
   std::string FormatDebugString(const NANDFSTEntry& entry);
-  void ProcessEntry(u16 entry_number, const std::string& parent_path);
-  std::vector<u8> GetEntryData(const NANDFSTEntry& entry);
+  void ProcessEntry(u16 entry_number, const std::string& parent_path,
+                    std::vector<FileToExtract>* files);
+  void ExtractFiles(const std::vector<FileToExtract>& files);
+  std::vector<u8> GetEntryData(const NANDFSTEntry& entry) const;
   void ExportKeys();
 
   std::string m_nand_root;
@@ -78,6 +98,7 @@ private:
   std::unique_ptr<Common::AES::Context> m_aes_ctx;
   std::unique_ptr<NANDSuperblock> m_superblock;
   std::function<void()> m_update_callback;
+  Throughput m_throughput;
 };
 }  // namespace DiscIO
 
@@ -7,6 +7,8 @@
 #include <locale>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -348,73 +350,147 @@ static void ApplyPatchToFile(const Patch& patch, const File& file_patch,
                    file_patch.m_fileoffset, file_patch.m_length, file_patch.m_resize);
 }
 
-static FSTBuilderNode* FindFileNodeInFST(std::string_view path, std::vector<FSTBuilderNode>* fst,
-                                         bool create_if_not_exists)
+namespace
 {
-  const size_t path_separator = path.find('/');
-  const bool is_file = path_separator == std::string_view::npos;
-  const std::string_view name = is_file ? path : path.substr(0, path_separator);
-  const auto it = std::find_if(fst->begin(), fst->end(), [&](const FSTBuilderNode& node) {
-    return Common::CaseInsensitiveEquals(node.m_filename, name);
-  });
-
-  if (it == fst->end())
+// Finds nodes of an FST by path or by filename without walking the FST for every patch.
+// Patches only ever append nodes to folders, so a node is identified by the indices that lead
+// to it from the root, which stay valid even when appending moves the nodes in memory.
+class FSTIndex
+{
+public:
+  explicit FSTIndex(std::vector<FSTBuilderNode>* fst) : m_fst(fst)
   {
-    if (!create_if_not_exists)
-      return nullptr;
+    IndexPath index_path;
+    AddNodes(*m_fst, "", true, &index_path);
+  }
 
-    if (is_file)
+  // Finds the file at the given path, which uses / as separator and has no leading /.
+  FSTBuilderNode* FindPath(std::string_view path, bool create_if_not_exists)
+  {
+    std::vector<FSTBuilderNode>* folder = m_fst;
+    IndexPath index_path;
+    size_t name_start = 0;
+    while (true)
     {
-      return &fst->emplace_back(
-          DiscIO::FSTBuilderNode{std::string(name), 0, std::vector<BuilderContentSource>()});
+      const size_t path_separator = path.find('/', name_start);
+      const bool is_file = path_separator == std::string_view::npos;
+      const std::string key = GetKey(path.substr(0, path_separator));
+      const std::string_view name = path.substr(name_start, path_separator - name_start);
+
+      FSTBuilderNode* node;
+      const auto it = m_paths.find(key);
+      if (it != m_paths.end())
+      {
+        index_path = it->second;
+        node = Resolve(index_path);
+        if (node->IsFile() != is_file)
+          return nullptr;
+      }
+      else
+      {
+        if (!create_if_not_exists)
+          return nullptr;
+
+        index_path.push_back(static_cast<u32>(folder->size()));
+        if (is_file)
+        {
+          node = &folder->emplace_back(
+              FSTBuilderNode{std::string(name), 0, std::vector<BuilderContentSource>()});
+        }
+        else
+        {
+          node = &folder->emplace_back(
+              FSTBuilderNode{std::string(name), 0, std::vector<FSTBuilderNode>()});
+        }
+        AddNode(*node, key, true, index_path);
+      }
+
+      if (is_file)
+        return node;
+      folder = &node->GetFolderContent();
+      name_start = path_separator + 1;
     }
+  }
 
-    auto& new_folder = fst->emplace_back(
-        DiscIO::FSTBuilderNode{std::string(name), 0, std::vector<FSTBuilderNode>()});
-    return FindFileNodeInFST(path.substr(path_separator + 1),
-                             &std::get<std::vector<FSTBuilderNode>>(new_folder.m_content), true);
+  // Finds the first file with the given name, in the order of a depth-first walk of the FST.
+  FSTBuilderNode* FindFilename(std::string_view filename)
+  {
+    const auto it = m_filenames.find(GetKey(filename));
+    return it != m_filenames.end() ? Resolve(it->second) : nullptr;
   }
 
-  const bool is_existing_node_file = it->IsFile();
-  if (is_file != is_existing_node_file)
-    return nullptr;
-  if (is_file)
-    return &*it;
+private:
+  using IndexPath = std::vector<u32>;
 
-  return FindFileNodeInFST(path.substr(path_separator + 1),
-                           &std::get<std::vector<FSTBuilderNode>>(it->m_content),
-                           create_if_not_exists);
-}
+  static std::string GetKey(std::string_view path)
+  {
+    std::string key(path);
+    Common::ToLower(&key);
+    return key;
+  }
 
-static DiscIO::FSTBuilderNode* FindFilenameNodeInFST(std::string_view filename,
-                                                     std::vector<FSTBuilderNode>& fst)
-{
-  for (FSTBuilderNode& node : fst)
+  void AddNodes(const std::vector<FSTBuilderNode>& nodes, const std::string& parent_key,
+                bool reachable_by_path, IndexPath* index_path)
   {
-    if (node.IsFolder())
+    for (u32 i = 0; i < nodes.size(); ++i)
     {
-      DiscIO::FSTBuilderNode* result = FindFilenameNodeInFST(filename, node.GetFolderContent());
-      if (result)
-        return result;
+      const std::string key =
+          parent_key.empty() ? GetKey(nodes[i].m_filename) :
+                               fmt::format("{}/{}", parent_key, GetKey(nodes[i].m_filename));
+      index_path->push_back(i);
+      const bool added = AddNode(nodes[i], key, reachable_by_path, *index_path);
+      if (nodes[i].IsFolder())
+        AddNodes(nodes[i].GetFolderContent(), key, added, index_path);
+      index_path->pop_back();
     }
-    else if (Common::CaseInsensitiveEquals(node.m_filename, filename))
+  }
+
+  // Returns whether the node can be found by its path.
+  bool AddNode(const FSTBuilderNode& node, const std::string& key, bool reachable_by_path,
+               const IndexPath& index_path)
+  {
+    // If names are only unique when case is taken into account, paths lead to the first node.
+    // The contents of the other nodes can then only be found by filename.
+    const bool added = reachable_by_path && m_paths.emplace(key, index_path).second;
+    if (!node.IsFile())
+      return added;
+
+    // Comparing index paths lexicographically gives the order of a depth-first walk
+    const auto [it, inserted] = m_filenames.emplace(GetKey(node.m_filename), index_path);
+    if (!inserted && index_path < it->second)
+      it->second = index_path;
+    return added;
+  }
+
+  FSTBuilderNode* Resolve(const IndexPath& index_path)
+  {
+    std::vector<FSTBuilderNode>* folder = m_fst;
+    FSTBuilderNode* node = nullptr;
+    for (const u32 index : index_path)
     {
-      return &node;
+      node = &(*folder)[index];
+      if (node->IsFolder())
+        folder = &node->GetFolderContent();
     }
+    return node;
   }
 
-  return nullptr;
-}
+  std::vector<FSTBuilderNode>* m_fst;
+  // Keyed by lowercase path
+  std::unordered_map<std::string, IndexPath> m_paths;
+  // Keyed by lowercase filename
+  std::unordered_map<std::string, IndexPath> m_filenames;
+};
+}  // namespace
 
-static void ApplyFilePatchToFST(const Patch& patch, const File& file,
-                                std::vector<DiscIO::FSTBuilderNode>* fst,
+static void ApplyFilePatchToFST(const Patch& patch, const File& file, FSTIndex* fst,
                                 DiscIO::FSTBuilderNode* dol_node)
 {
   if (!file.m_disc.empty() && file.m_disc[0] == '/')
   {
     // If the disc path starts with a / then we should patch that specific disc path.
     DiscIO::FSTBuilderNode* node =
-        FindFileNodeInFST(std::string_view(file.m_disc).substr(1), fst, file.m_create);
+        fst->FindPath(std::string_view(file.m_disc).substr(1), file.m_create);
     if (node)
       ApplyPatchToFile(patch, file, node);
   }
@@ -426,14 +502,13 @@ static void ApplyFilePatchToFST(const Patch& patch, const File& file,
   else
   {
     // Otherwise we want to patch the first file in the FST that matches that filename.
-    DiscIO::FSTBuilderNode* node = FindFilenameNodeInFST(file.m_disc, *fst);
+    DiscIO::FSTBuilderNode* node = fst->FindFilename(file.m_disc);
     if (node)
       ApplyPatchToFile(patch, file, node);
   }
 }
 
-static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
-                                  std::vector<DiscIO::FSTBuilderNode>* fst,
+static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder, FSTIndex* fst,
                                   DiscIO::FSTBuilderNode* dol_node, std::string_view disc_path,
                                   std::string_view external_path)
 {
@@ -472,8 +547,7 @@ static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
   }
 }
 
-static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
-                                  std::vector<DiscIO::FSTBuilderNode>* fst,
+static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder, FSTIndex* fst,
                                   DiscIO::FSTBuilderNode* dol_node)
 {
   ApplyFolderPatchToFST(patch, folder, fst, dol_node, folder.m_disc, folder.m_external);
@@ -482,6 +556,7 @@ static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
 void ApplyPatchesToFiles(const std::vector<Patch>& patches, PatchIndex index,
                          std::vector<DiscIO::FSTBuilderNode>* fst, DiscIO::FSTBuilderNode* dol_node)
 {
+  FSTIndex fst_index(fst);
   for (const auto& patch : patches)
   {
     const auto& file_patches =
@@ -490,10 +565,10 @@ void ApplyPatchesToFiles(const std::vector<Patch>& patches, PatchIndex index,
         index == PatchIndex::DolphinSysFiles ? patch.m_sys_folder_patches : patch.m_folder_patches;
 
     for (const auto& file : file_patches)
-      ApplyFilePatchToFST(patch, file, fst, dol_node);
+      ApplyFilePatchToFST(patch, file, &fst_index, dol_node);
 
     for (const auto& folder : folder_patches)
-      ApplyFolderPatchToFST(patch, folder, fst, dol_node);
+      ApplyFolderPatchToFST(patch, folder, &fst_index, dol_node);
   }
 }
 
@@ -4,14 +4,19 @@
 #include "DiscIO/VolumeVerifier.h"
 
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <future>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
+#include <fmt/format.h>
 #include <mbedtls/md5.h>
 #include <mz_compat.h>
 #include <pugixml.hpp>
@@ -358,6 +363,9 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
 }
 
 constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
+// How much data may be waiting for the worker threads before reading has to wait for them
+constexpr u64 MAX_BYTES_IN_FLIGHT = 64 * 1024 * 1024;
+constexpr u32 MAX_CHECK_THREADS = 8;
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -373,7 +381,9 @@ VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
 
 VolumeVerifier::~VolumeVerifier()
 {
-  WaitForAsyncOperations();
+  // The worker threads use the members of this object, so stop them before anything is destroyed.
+  // If verification was cancelled, the work they still have queued up is dropped.
+  ShutDownWorkerThreads();
 }
 
 Hashes<bool> VolumeVerifier::GetDefaultHashesToCalculate()
@@ -398,6 +408,7 @@ void VolumeVerifier::Start()
 {
   ASSERT(!m_started);
   m_started = true;
+  m_start_time = Clock::now();
 
   if (m_redump_verification)
     m_redump_verifier.Start(m_volume);
@@ -1078,43 +1089,170 @@ void VolumeVerifier::SetUpHashing()
   {
     m_sha1_context = Common::SHA1::CreateContext();
   }
+
+  // The partition keys and H3 tables are loaded lazily, which isn't thread-safe. Get them loaded
+  // by checking a dummy block before the worker threads start checking blocks in parallel.
+  const std::vector<u8> dummy_block(VolumeWii::BLOCK_TOTAL_SIZE);
+  for (const Partition& partition : m_volume.GetPartitions())
+    m_volume.CheckBlockIntegrity(0, dummy_block.data(), partition);
+
+  StartWorkerThreads();
+}
+
+void VolumeVerifier::StartWorkerThreads()
+{
+  const auto timed = [](Clock::duration* time, auto work) {
+    const Clock::time_point start = Clock::now();
+    work();
+    *time += Clock::now() - start;
+  };
+
+  if (m_hashes_to_calculate.crc32)
+  {
+    m_crc32_thread.Reset("Verifier CRC32", [this, timed](HashWork work) {
+      timed(&m_crc32_time, [&] {
+        m_crc32_context = Common::UpdateCRC32(m_crc32_context, work.data->data(), work.size);
+      });
+    });
+  }
+
+  if (m_hashes_to_calculate.md5)
+  {
+    m_md5_thread.Reset("Verifier MD5", [this, timed](HashWork work) {
+      timed(&m_md5_time,
+            [&] { mbedtls_md5_update_ret(&m_md5_context, work.data->data(), work.size); });
+    });
+  }
+
+  if (m_hashes_to_calculate.sha1)
+  {
+    m_sha1_thread.Reset("Verifier SHA1", [this, timed](HashWork work) {
+      timed(&m_sha1_time, [&] { m_sha1_context->Update(work.data->data(), work.size); });
+    });
+  }
+
+  if (m_groups.empty() && m_content_offsets.empty())
+    return;
+
+  // Checking Wii blocks (decrypting them and calculating all the SHA-1 hashes in them) is the
+  // slowest part of verifying a Wii disc, so it gets split over several threads
+  const u32 thread_count =
+      std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_CHECK_THREADS);
+  m_check_times.resize(thread_count);
+  for (u32 i = 0; i < thread_count; ++i)
+  {
+    auto thread = std::make_unique<Common::WorkQueueThread<std::function<void()>>>();
+    const auto check_function = [this, timed, i](std::function<void()> check) {
+      timed(&m_check_times[i], check);
+    };
+    thread->Reset(fmt::format("Verifier check {}", i), check_function);
+    m_check_threads.push_back(std::move(thread));
+  }
 }
 
-void VolumeVerifier::WaitForAsyncOperations() const
+void VolumeVerifier::WaitForWorkerThreads()
 {
-  if (m_crc32_future.valid())
-    m_crc32_future.wait();
-  if (m_md5_future.valid())
-    m_md5_future.wait();
-  if (m_sha1_future.valid())
-    m_sha1_future.wait();
-  if (m_content_future.valid())
-    m_content_future.wait();
-  if (m_group_future.valid())
-    m_group_future.wait();
+  m_crc32_thread.WaitForCompletion();
+  m_md5_thread.WaitForCompletion();
+  m_sha1_thread.WaitForCompletion();
+  for (auto& thread : m_check_threads)
+    thread->WaitForCompletion();
 }
 
-bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
+void VolumeVerifier::ShutDownWorkerThreads()
 {
-  std::vector<u8> data(bytes_to_read);
+  m_crc32_thread.Shutdown(true);
+  m_md5_thread.Shutdown(true);
+  m_sha1_thread.Shutdown(true);
+  for (auto& thread : m_check_threads)
+    thread->Shutdown(true);
+}
 
-  const u64 bytes_to_copy = std::min(m_excess_bytes, bytes_to_read);
-  if (bytes_to_copy > 0)
-    std::memcpy(data.data(), m_data.data() + m_data.size() - m_excess_bytes, bytes_to_copy);
+VolumeVerifier::Chunk VolumeVerifier::ReadChunk(u64 bytes_to_read)
+{
+  // Don't let the reading get too far ahead of the worker threads
+  const Clock::time_point wait_start = Clock::now();
+  {
+    std::unique_lock lock(m_bytes_in_flight_lock);
+    m_bytes_in_flight_cv.wait(lock, [this] { return m_bytes_in_flight < MAX_BYTES_IN_FLIGHT; });
+    m_bytes_in_flight += bytes_to_read;
+  }
+  const Clock::time_point read_start = Clock::now();
+  m_wait_time += read_start - wait_start;
+
+  // The chunk is freed when the last worker thread using it is done with it
+  std::shared_ptr<std::vector<u8>> data(new std::vector<u8>(bytes_to_read),
+                                        [this](std::vector<u8>* chunk) {
+                                          {
+                                            std::lock_guard lock(m_bytes_in_flight_lock);
+                                            m_bytes_in_flight -= chunk->size();
+                                          }
+                                          m_bytes_in_flight_cv.notify_all();
+                                          delete chunk;
+                                        });
+
+  const u64 bytes_to_copy = std::min<u64>(m_excess_data.size(), bytes_to_read);
+  std::copy_n(m_excess_data.begin(), bytes_to_copy, data->begin());
   bytes_to_read -= bytes_to_copy;
 
+  bool success = true;
   if (bytes_to_read > 0)
   {
-    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, data.data() + bytes_to_copy,
-                       PARTITION_NONE))
+    success = m_volume.Read(m_progress + bytes_to_copy, bytes_to_read,
+                            data->data() + bytes_to_copy, PARTITION_NONE);
+  }
+
+  m_read_time += Clock::now() - read_start;
+  return success ? data : nullptr;
+}
+
+void VolumeVerifier::PushCheck(std::function<void()> check)
+{
+  m_check_threads[m_next_check_thread]->Push(std::move(check));
+  m_next_check_thread = (m_next_check_thread + 1) % m_check_threads.size();
+}
+
+void VolumeVerifier::CheckContent(const Chunk& data, const IOS::ES::Content& content)
+{
+  if (!data || !m_volume.CheckContentIntegrity(content, *data, m_ticket))
+  {
+    std::lock_guard lock(m_check_results_lock);
+    m_corrupt_contents.emplace(content.index, content.id);
+  }
+}
+
+void VolumeVerifier::CheckGroup(const Chunk& data, size_t group_index)
+{
+  const GroupToVerify& group = m_groups[group_index];
+  u64 offset_in_group = 0;
+  for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
+       ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
+  {
+    const u64 block_offset = group.offset + offset_in_group;
+
+    if (data && m_volume.CheckBlockIntegrity(block_index, data->data() + offset_in_group,
+                                             group.partition))
     {
-      return false;
+      std::lock_guard lock(m_check_results_lock);
+      m_biggest_verified_offset =
+          std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+    }
+    else
+    {
+      const bool can_be_scrubbed = m_scrubber.CanBlockBeScrubbed(block_offset);
+      std::lock_guard lock(m_check_results_lock);
+      if (can_be_scrubbed)
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+        m_unused_block_errors[group.partition]++;
+      }
+      else
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+        m_block_errors[group.partition]++;
+      }
     }
   }
-
-  WaitForAsyncOperations();
-  m_data = std::move(data);
-  return true;
 }
 
 void VolumeVerifier::Process()
@@ -1188,7 +1326,8 @@ void VolumeVerifier::Process()
   }
 
   const bool is_data_needed = m_calculating_any_hash || content_read || group_read;
-  const bool read_failed = is_data_needed && !ReadChunkAndWaitForAsyncOperations(bytes_to_read);
+  const Chunk data = is_data_needed ? ReadChunk(bytes_to_read) : nullptr;
+  const bool read_failed = is_data_needed && !data;
 
   if (read_failed)
   {
@@ -1198,79 +1337,36 @@ void VolumeVerifier::Process()
     m_calculating_any_hash = false;
   }
 
-  m_excess_bytes = excess_bytes;
+  // Only keep the excess bytes rather than the whole chunk, so that a big chunk can be freed as
+  // soon as the worker threads are done with it
+  if (data)
+    m_excess_data.assign(data->end() - excess_bytes, data->end());
+  else
+    m_excess_data.clear();
+
   const u64 byte_increment = bytes_to_read - excess_bytes;
 
   if (m_calculating_any_hash)
   {
+    const HashWork work{data, static_cast<size_t>(byte_increment)};
     if (m_hashes_to_calculate.crc32)
-    {
-      m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
-        m_crc32_context = Common::UpdateCRC32(m_crc32_context, m_data.data(),
-                                              static_cast<size_t>(byte_increment));
-      });
-    }
-
+      m_crc32_thread.Push(work);
     if (m_hashes_to_calculate.md5)
-    {
-      m_md5_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_md5_update_ret(&m_md5_context, m_data.data(), byte_increment);
-      });
-    }
-
+      m_md5_thread.Push(work);
     if (m_hashes_to_calculate.sha1)
-    {
-      m_sha1_future = std::async(std::launch::async, [this, byte_increment] {
-        m_sha1_context->Update(m_data.data(), byte_increment);
-      });
-    }
+      m_sha1_thread.Push(work);
   }
 
+  // If the read failed, the checks get a null chunk and report the data as corrupt
   if (content_read)
   {
-    m_content_future = std::async(std::launch::async, [this, read_failed, content] {
-      if (read_failed || !m_volume.CheckContentIntegrity(content, m_data, m_ticket))
-      {
-        AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content.id));
-      }
-    });
-
+    PushCheck([this, data, content] { CheckContent(data, content); });
     m_content_index++;
   }
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
-
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
-        }
-      }
-    });
-
+    PushCheck([this, data, group_index = m_group_index] { CheckGroup(data, group_index); });
     m_group_index++;
   }
 
@@ -1293,7 +1389,30 @@ void VolumeVerifier::Finish()
     return;
   m_done = true;
 
-  WaitForAsyncOperations();
+  const Clock::time_point wait_start = Clock::now();
+  WaitForWorkerThreads();
+  m_wait_time += Clock::now() - wait_start;
+
+  Throughput& throughput = m_result.throughput;
+  throughput.bytes = m_progress;
+  throughput.total = Clock::now() - m_start_time;
+  throughput.reading = m_read_time;
+  throughput.waiting_for_workers = m_wait_time;
+  throughput.crc32 = m_crc32_time;
+  throughput.md5 = m_md5_time;
+  throughput.sha1 = m_sha1_time;
+  for (const Clock::duration time : m_check_times)
+    throughput.integrity_checks += time;
+
+  INFO_LOG_FMT(DISCIO,
+               "Verified {} MiB in {:.2f} s ({:.1f} MiB/s). Reading took {:.2f} s, waiting for "
+               "the worker threads took {:.2f} s",
+               throughput.bytes / (1024 * 1024), throughput.total.count(),
+               throughput.bytes / (1024 * 1024) / std::max(throughput.total.count(), 0.001),
+               throughput.reading.count(), throughput.waiting_for_workers.count());
+
+  for (const auto& [index, id] : m_corrupt_contents)
+    AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", id));
 
   if (m_calculating_any_hash)
   {
@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -14,6 +18,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/Volume.h"
@@ -30,6 +35,10 @@
 // Start, Process and Finish may take some time to run.
 //
 // GetResult() can be called before the processing is finished, but the result will be incomplete.
+//
+// Process reads the data on the calling thread. Each hash is calculated on a worker thread of its
+// own, and the integrity checks (which decrypt Wii data) are spread over a pool of worker threads,
+// so reading never has to wait for hashing unless the workers fall too far behind.
 
 namespace DiscIO
 {
@@ -116,12 +125,28 @@ public:
     std::string text;
   };
 
+  // Where the time went while verifying. If the reading thread spent a lot of time waiting for
+  // the worker threads, verification was limited by the CPU rather than by I/O.
+  struct Throughput
+  {
+    u64 bytes = 0;
+    std::chrono::duration<double> total{};
+    std::chrono::duration<double> reading{};
+    std::chrono::duration<double> waiting_for_workers{};
+    std::chrono::duration<double> crc32{};
+    std::chrono::duration<double> md5{};
+    std::chrono::duration<double> sha1{};
+    // Summed over all of the threads doing integrity checks
+    std::chrono::duration<double> integrity_checks{};
+  };
+
   struct Result
   {
     Hashes<std::vector<u8>> hashes;
     std::string summary_text;
     std::vector<Problem> problems;
     RedumpVerifier::Result redump;
+    Throughput throughput;
   };
 
   VolumeVerifier(const Volume& volume, bool redump_verification, Hashes<bool> hashes_to_calculate);
@@ -155,9 +180,23 @@ private:
   void CheckVolumeSize();
   void CheckMisc();
   void CheckSuperPaperMario();
+  using Chunk = std::shared_ptr<const std::vector<u8>>;
+  using Clock = std::chrono::steady_clock;
+
+  struct HashWork
+  {
+    Chunk data;
+    size_t size;
+  };
+
   void SetUpHashing();
-  void WaitForAsyncOperations() const;
-  bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  void StartWorkerThreads();
+  void WaitForWorkerThreads();
+  void ShutDownWorkerThreads();
+  Chunk ReadChunk(u64 bytes_to_read);
+  void PushCheck(std::function<void()> check);
+  void CheckContent(const Chunk& data, const IOS::ES::Content& content);
+  void CheckGroup(const Chunk& data, size_t group_index);
 
   void AddProblem(Severity severity, std::string text);
 
@@ -178,13 +217,26 @@ private:
   mbedtls_md5_context m_md5_context{};
   std::unique_ptr<Common::SHA1::Context> m_sha1_context;
 
-  u64 m_excess_bytes = 0;
-  std::vector<u8> m_data;
-  std::future<void> m_crc32_future;
-  std::future<void> m_md5_future;
-  std::future<void> m_sha1_future;
-  std::future<void> m_content_future;
-  std::future<void> m_group_future;
+  // The end of the last chunk, which gets read again as the start of the next chunk
+  std::vector<u8> m_excess_data;
+  std::mutex m_bytes_in_flight_lock;
+  std::condition_variable m_bytes_in_flight_cv;
+  u64 m_bytes_in_flight = 0;
+
+  Common::WorkQueueThread<HashWork> m_crc32_thread;
+  Common::WorkQueueThread<HashWork> m_md5_thread;
+  Common::WorkQueueThread<HashWork> m_sha1_thread;
+  std::vector<std::unique_ptr<Common::WorkQueueThread<std::function<void()>>>> m_check_threads;
+  size_t m_next_check_thread = 0;
+
+  // Each of these is only written by the thread doing the work it measures
+  Clock::time_point m_start_time;
+  Clock::duration m_read_time{};
+  Clock::duration m_wait_time{};
+  Clock::duration m_crc32_time{};
+  Clock::duration m_md5_time{};
+  Clock::duration m_sha1_time{};
+  std::vector<Clock::duration> m_check_times;
 
   DiscScrubber m_scrubber;
   IOS::ES::TicketReader m_ticket;
@@ -192,8 +244,12 @@ private:
   u16 m_content_index = 0;
   std::vector<GroupToVerify> m_groups;
   size_t m_group_index = 0;  // Index in m_groups, not index in a specific partition
+
+  // Guards the results of the integrity checks, which are written by the worker threads
+  std::mutex m_check_results_lock;
   std::map<Partition, size_t> m_block_errors;
   std::map<Partition, size_t> m_unused_block_errors;
+  std::map<u16, u32> m_corrupt_contents;  // Content index to content ID
 
   u64 m_biggest_referenced_offset = 0;
   u64 m_biggest_verified_offset = 0;
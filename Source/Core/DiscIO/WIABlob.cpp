@@ -11,6 +11,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -1725,11 +1726,40 @@ bool WIARVZFileReader<RVZ>::WriteHeader(File::IOFile* file, const u8* data, size
   return PadTo4(file, bytes_written);
 }
 
+// Roughly how much memory each compression thread uses. Besides the compressor itself, a thread
+// holds the data it's compressing, the decrypted data, and the output it's waiting to hand over.
+static u64 GetCompressThreadMemoryUsage(WIARVZCompressionType compression_type,
+                                        int compression_level, int chunk_size)
+{
+  u64 compressor_usage = 0;
+  switch (compression_type)
+  {
+  case WIARVZCompressionType::None:
+  case WIARVZCompressionType::Purge:
+    break;
+  case WIARVZCompressionType::Bzip2:
+    compressor_usage = Bzip2Compressor::GetMemoryUsage(compression_level);
+    break;
+  case WIARVZCompressionType::LZMA:
+  case WIARVZCompressionType::LZMA2:
+    compressor_usage = LZMACompressor::GetMemoryUsage(
+        compression_type == WIARVZCompressionType::LZMA2, compression_level);
+    break;
+  case WIARVZCompressionType::Zstd:
+    compressor_usage = ZstdCompressor::GetMemoryUsage(compression_level, chunk_size);
+    break;
+  }
+
+  const u64 data_size = std::max<u64>(chunk_size, VolumeWii::GROUP_TOTAL_SIZE);
+  return data_size * 4 + compressor_usage;
+}
+
 template <bool RVZ>
 ConversionResultCode
 WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                File::IOFile* outfile, WIARVZCompressionType compression_type,
-                               int compression_level, int chunk_size, CompressCB callback)
+                               int compression_level, int chunk_size, u64 memory_budget,
+                               CompressCB callback)
 {
   ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
   ASSERT(chunk_size > 0);
@@ -1835,8 +1865,21 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
                        bytes_written, total_groups, iso_size, callback);
   };
 
+  // High compression levels of LZMA and Zstd can use a lot of memory per thread,
+  // so only use as many threads as fit in the memory budget.
+  const unsigned int cpu_threads = std::max(1u, std::thread::hardware_concurrency());
+  unsigned int compress_threads = cpu_threads;
+  if (memory_budget != 0)
+  {
+    const u64 thread_memory_usage =
+        GetCompressThreadMemoryUsage(compression_type, compression_level, chunk_size);
+    compress_threads = static_cast<unsigned int>(
+        std::clamp<u64>(memory_budget / thread_memory_usage, 1, cpu_threads));
+  }
+  INFO_LOG_FMT(DISCIO, "Converting using {} compression threads", compress_threads);
+
   MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> mt_compressor(
-      set_up_compress_thread_state, process_and_compress, output);
+      set_up_compress_thread_state, process_and_compress, output, compress_threads);
 
   for (const DataEntry& data_entry : data_entries)
   {
@@ -2028,7 +2071,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback)
+                       int chunk_size, u64 memory_budget, CompressCB callback)
 {
   File::IOFile outfile(outfile_path, "wb");
   if (!outfile)
@@ -2046,7 +2089,7 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
   const auto convert = rvz ? RVZFileReader::Convert : WIAFileReader::Convert;
   const ConversionResultCode result =
       convert(infile, infile_volume.get(), &outfile, compression_type, compression_level,
-              chunk_size, callback);
+              chunk_size, memory_budget, callback);
 
   if (result == ConversionResultCode::ReadFailed)
     PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
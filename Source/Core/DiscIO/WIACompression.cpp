@@ -4,6 +4,7 @@
 #include "DiscIO/WIACompression.h"
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstring>
 #include <limits>
@@ -542,6 +543,13 @@ Bzip2Compressor::~Bzip2Compressor()
   BZ2_bzCompressEnd(&m_stream);
 }
 
+u64 Bzip2Compressor::GetMemoryUsage(int compression_level)
+{
+  // According to the bzip2 documentation, compressing takes 400 KB plus 8 times the block size,
+  // and the block size is the compression level times 100 KB
+  return 400000 + 8 * 100000 * static_cast<u64>(compression_level);
+}
+
 bool Bzip2Compressor::Start(std::optional<u64> size)
 {
   ASSERT_MSG(DISCIO, m_stream.state == nullptr,
@@ -733,6 +741,18 @@ size_t LZMACompressor::GetSize() const
   return static_cast<size_t>(m_stream.next_out - m_buffer.data());
 }
 
+u64 LZMACompressor::GetMemoryUsage(bool lzma2, int compression_level)
+{
+  lzma_options_lzma options = {};
+  if (lzma_lzma_preset(&options, static_cast<uint32_t>(compression_level)))
+    return 0;
+
+  const lzma_filter filters[2] = {{lzma2 ? LZMA_FILTER_LZMA2 : LZMA_FILTER_LZMA1, &options},
+                                  {LZMA_VLI_UNKNOWN, nullptr}};
+  const u64 usage = lzma_raw_encoder_memusage(filters);
+  return usage == std::numeric_limits<u64>::max() ? 0 : usage;
+}
+
 ZstdCompressor::ZstdCompressor(int compression_level)
 {
   m_stream = ZSTD_createCStream();
@@ -749,6 +769,17 @@ ZstdCompressor::~ZstdCompressor()
   ZSTD_freeCStream(m_stream);
 }
 
+u64 ZstdCompressor::GetMemoryUsage(int compression_level, u64 size)
+{
+  // The size estimation functions of zstd are only available when linking statically, so this
+  // is an upper bound instead. Since the size is pledged in Start, zstd shrinks its window to
+  // the size, and its hash and chain tables never hold more than two entries per window byte.
+  // The optimal parser used by the highest levels needs some more memory on top of that.
+  const u64 window_size = std::bit_ceil(std::max<u64>(size, 1024));
+  const u64 optimal_parser_size = compression_level >= 16 ? 1024 * 1024 : 0;
+  return window_size * 18 + optimal_parser_size;
+}
+
 bool ZstdCompressor::Start(std::optional<u64> size)
 {
   if (!m_stream)
@@ -186,6 +186,9 @@ public:
   Bzip2Compressor(int compression_level);
   ~Bzip2Compressor();
 
+  // Roughly how much memory a compressor uses, not counting the compressed data
+  static u64 GetMemoryUsage(int compression_level);
+
   bool Start(std::optional<u64> size) override;
   bool Compress(const u8* data, size_t size) override;
   bool End() override;
@@ -208,6 +211,9 @@ public:
                  u8* compressor_data_size_out);
   ~LZMACompressor();
 
+  // Roughly how much memory a compressor uses, not counting the compressed data
+  static u64 GetMemoryUsage(bool lzma2, int compression_level);
+
   bool Start(std::optional<u64> size) override;
   bool Compress(const u8* data, size_t size) override;
   bool End() override;
@@ -231,6 +237,10 @@ public:
   ZstdCompressor(int compression_level);
   ~ZstdCompressor();
 
+  // Roughly how much memory a compressor uses when compressing size bytes at a time,
+  // not counting the compressed data
+  static u64 GetMemoryUsage(int compression_level, u64 size);
+
   bool Start(std::optional<u64> size) override;
   bool Compress(const u8* data, size_t size) override;
   bool End() override;
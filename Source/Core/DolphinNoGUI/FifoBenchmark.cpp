@@ -0,0 +1,113 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/FifoBenchmark.h"
+
+#include <utility>
+
+#include <picojson.h>
+
+#include "Common/Config/Config.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/System.h"
+#include "VideoCommon/Fifo.h"
+
+FifoBenchmark::FifoBenchmark(u32 loops, std::function<void()> finished_callback)
+    : m_loops(loops), m_finished_callback(std::move(finished_callback))
+{
+  m_loop_seconds.reserve(loops);
+}
+
+void FifoBenchmark::Start()
+{
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+
+  g_gpu_stage_timers.Reset();
+  g_gpu_stage_timers.SetEnabled(true);
+
+  FifoPlayer::GetInstance().SetFrameWrittenCallback([this] { OnFrameWritten(); });
+}
+
+// Called on the CPU thread, before each frame of the log is written to the FIFO.
+void FifoBenchmark::OnFrameWritten()
+{
+  if (IsFinished())
+    return;
+
+  const FifoPlayer& player = FifoPlayer::GetInstance();
+  if (player.GetCurrentFrameNum() == player.GetFrameRangeStart())
+  {
+    if (m_frames == 0)
+    {
+      // Setup work done while booting is not part of the measurement.
+      g_gpu_stage_timers.Reset();
+      m_start_time = Clock::now();
+      m_loop_start_time = m_start_time;
+    }
+    else
+    {
+      // Wait for the GPU thread, so that each loop is charged for its own rendering.
+      auto& system = Core::System::GetInstance();
+      system.GetFifo().FlushGpu(system);
+
+      const Clock::time_point now = Clock::now();
+      m_loop_seconds.push_back(std::chrono::duration<double>(now - m_loop_start_time).count());
+      m_loop_start_time = now;
+
+      if (m_loop_seconds.size() == m_loops)
+      {
+        Finish();
+        return;
+      }
+    }
+  }
+
+  m_frames++;
+}
+
+void FifoBenchmark::Finish()
+{
+  m_total_seconds = std::chrono::duration<double>(m_loop_start_time - m_start_time).count();
+
+  for (size_t i = 0; i < NUM_STAGES; i++)
+  {
+    m_stage_nanoseconds[i] = g_gpu_stage_timers.GetTotalNanoseconds(static_cast<GPUStage>(i));
+    m_stage_samples[i] = g_gpu_stage_timers.GetSampleCount(static_cast<GPUStage>(i));
+  }
+  g_gpu_stage_timers.SetEnabled(false);
+
+  m_finished.store(true, std::memory_order_release);
+  if (m_finished_callback)
+    m_finished_callback();
+}
+
+std::string FifoBenchmark::GetResultsJSON(const std::string& fifo_path) const
+{
+  picojson::object stages;
+  for (size_t i = 0; i < NUM_STAGES; i++)
+  {
+    picojson::object stage;
+    stage["seconds"] = picojson::value(static_cast<double>(m_stage_nanoseconds[i]) / 1e9);
+    stage["calls"] = picojson::value(static_cast<double>(m_stage_samples[i]));
+    stages[GPUStageTimers::GetStageName(static_cast<GPUStage>(i))] = picojson::value(stage);
+  }
+
+  picojson::array loop_seconds;
+  for (double seconds : m_loop_seconds)
+    loop_seconds.emplace_back(seconds);
+
+  picojson::object results;
+  results["file"] = picojson::value(fifo_path);
+  results["video_backend"] = picojson::value(Config::Get(Config::MAIN_GFX_BACKEND));
+  results["dual_core"] = picojson::value(Config::Get(Config::MAIN_CPU_THREAD));
+  results["loops"] = picojson::value(static_cast<double>(m_loops));
+  results["frames"] = picojson::value(static_cast<double>(m_frames));
+  results["seconds"] = picojson::value(m_total_seconds);
+  results["fps"] = picojson::value(m_total_seconds > 0.0 ? m_frames / m_total_seconds : 0.0);
+  results["loop_seconds"] = picojson::value(loop_seconds);
+  results["stages"] = picojson::value(stages);
+
+  return picojson::value(results).serialize(true);
+}
@@ -0,0 +1,50 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/GPUStageTimers.h"
+
+// Replays the frame range of a FIFO log a fixed number of times and measures how long the GPU
+// thread takes for it, for tracking video performance without user interaction.
+class FifoBenchmark
+{
+public:
+  FifoBenchmark(u32 loops, std::function<void()> finished_callback);
+
+  // Forces looping, unthrottled playback and installs the frame callback. Call before booting.
+  void Start();
+
+  bool IsFinished() const { return m_finished.load(std::memory_order_acquire); }
+
+  // Only valid once the benchmark has finished.
+  std::string GetResultsJSON(const std::string& fifo_path) const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  void OnFrameWritten();
+  void Finish();
+
+  u32 m_loops;
+  std::function<void()> m_finished_callback;
+  std::atomic<bool> m_finished{false};
+
+  u32 m_frames = 0;
+  Clock::time_point m_start_time;
+  Clock::time_point m_loop_start_time;
+  std::vector<double> m_loop_seconds;
+  double m_total_seconds = 0.0;
+
+  static constexpr size_t NUM_STAGES = static_cast<size_t>(GPUStage::Count);
+  std::array<u64, NUM_STAGES> m_stage_nanoseconds{};
+  std::array<u64, NUM_STAGES> m_stage_samples{};
+};
@@ -7,8 +7,11 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <memory>
+#include <optional>
 #include <signal.h>
 #include <string>
+#include <variant>
 #include <vector>
 
 #ifndef _WIN32
@@ -17,6 +20,7 @@
 #include <Windows.h>
 #endif
 
+#include "Common/FileUtil.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
@@ -24,6 +28,8 @@
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/Host.h"
+#include "DolphinNoGUI/FifoBenchmark.h"
+#include "DolphinNoGUI/MovieRenderer.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -154,6 +160,10 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
 {
   std::string platform_name = static_cast<const char*>(options.get("platform"));
 
+  // Rendering movies must work without a display.
+  if (platform_name.empty() && options.is_set("render_output"))
+    platform_name = "headless";
+
 #if HAVE_X11
   if (platform_name == "x11" || platform_name.empty())
     return Platform::CreateX11Platform();
@@ -210,6 +220,20 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("--benchmark_loops")
+      .type("int")
+      .action("store")
+      .help("Play the given FIFO log back this many times, then quit and report GPU timings");
+  parser->add_option("--benchmark_output")
+      .type("string")
+      .action("store")
+      .help("Write the benchmark results to this JSON file instead of standard output");
+  parser->add_option("--render_output")
+      .type("string")
+      .action("store")
+      .help("Play the movie back as fast as possible, dump its frames to this video file, then "
+            "quit. Uses the software renderer and the headless platform unless a video backend "
+            "or platform is given. Give concurrent jobs separate user folders");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -256,6 +280,34 @@ int main(int argc, char* argv[])
     return 0;
   }
 
+  std::unique_ptr<FifoBenchmark> benchmark;
+  std::string benchmark_file;
+  if (options.is_set("benchmark_loops"))
+  {
+    const int loops = static_cast<int>(options.get("benchmark_loops"));
+    if (loops < 1 || !boot || !std::holds_alternative<BootParameters::DFF>(boot->parameters))
+    {
+      fprintf(stderr, "Benchmarking requires a FIFO log and a loop count of at least 1.\n");
+      return 1;
+    }
+    benchmark_file = std::get<BootParameters::DFF>(boot->parameters).dff_path;
+    benchmark =
+        std::make_unique<FifoBenchmark>(static_cast<u32>(loops), [] { s_platform->Stop(); });
+  }
+
+  std::unique_ptr<MovieRenderer> renderer;
+  if (options.is_set("render_output"))
+  {
+    if (!game_specified || !options.is_set("movie"))
+    {
+      fprintf(stderr, "Rendering requires a game and a movie.\n");
+      return 1;
+    }
+    renderer = std::make_unique<MovieRenderer>(
+        static_cast<const char*>(options.get("movie")),
+        static_cast<const char*>(options.get("render_output")), [] { s_platform->Stop(); });
+  }
+
   std::string user_directory;
   if (options.is_set("user"))
     user_directory = static_cast<const char*>(options.get("user"));
@@ -304,6 +356,15 @@ int main(int argc, char* argv[])
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
+  if (benchmark)
+    benchmark->Start();
+
+  if (renderer && !renderer->Start(*boot, !options.is_set_by_user("video_backend")))
+  {
+    fprintf(stderr, "Could not play the specified movie\n");
+    return 1;
+  }
+
   if (!BootManager::BootCore(std::move(boot), wsi))
   {
     fprintf(stderr, "Could not boot the specified file\n");
@@ -320,6 +381,42 @@ int main(int argc, char* argv[])
   Core::Shutdown();
   s_platform.reset();
 
+  if (benchmark)
+  {
+    if (!benchmark->IsFinished())
+    {
+      fprintf(stderr, "The benchmark was stopped before all loops were played back.\n");
+      return 1;
+    }
+
+    const std::string results = benchmark->GetResultsJSON(benchmark_file);
+    if (!options.is_set("benchmark_output"))
+    {
+      printf("%s\n", results.c_str());
+    }
+    else if (!File::WriteStringToFile(static_cast<const char*>(options.get("benchmark_output")),
+                                      results))
+    {
+      fprintf(stderr, "Could not write the benchmark results.\n");
+      return 1;
+    }
+  }
+
+  if (renderer)
+  {
+    if (!renderer->IsFinished())
+    {
+      fprintf(stderr, "Rendering was stopped before the end of the movie.\n");
+      return 1;
+    }
+    if (!renderer->WroteOutput())
+    {
+      fprintf(stderr, "No frames were dumped. Frame dumping requires FFmpeg support.\n");
+      return 1;
+    }
+    printf("%s\n", renderer->GetSummary().c_str());
+  }
+
   return 0;
 }
 
@@ -0,0 +1,90 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/MovieRenderer.h"
+
+#include <optional>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/MsgHandler.h"
+#include "Core/Boot/Boot.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Movie.h"
+
+MovieRenderer::MovieRenderer(std::string movie_path, std::string output_path,
+                             std::function<void()> finished_callback)
+    : m_movie_path(std::move(movie_path)), m_output_path(std::move(output_path)),
+      m_finished_callback(std::move(finished_callback))
+{
+}
+
+MovieRenderer::~MovieRenderer()
+{
+  Movie::SetPlaybackEndedCallback(nullptr);
+}
+
+bool MovieRenderer::Start(BootParameters& boot, bool use_software_renderer)
+{
+  // Nobody is around to answer questions, so log them instead of waiting for an answer.
+  Common::SetEnableAlert(false);
+
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, BACKEND_NULLSOUND);
+  Config::SetCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, true);
+  Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, true);
+  Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES_SILENT, true);
+  Config::SetCurrent(Config::GFX_DUMP_FRAMES_AS_IMAGES, false);
+  Config::SetCurrent(Config::GFX_FRAME_DUMPS_DROP_FRAMES, false);
+  Config::SetCurrent(Config::GFX_DUMP_PATH, m_output_path);
+  Config::SetCurrent(Config::GFX_VSYNC, false);
+  if (use_software_renderer)
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, "Software Renderer");
+
+  // Playback of a read-only movie ends at the end of the input instead of resuming recording.
+  Movie::SetReadOnly(true);
+
+  std::optional<std::string> savestate_path;
+  if (!Movie::PlayInput(m_movie_path, &savestate_path))
+    return false;
+
+  boot.boot_session_data.SetSavestateData(std::move(savestate_path),
+                                          DeleteSavestateAfterBoot::No);
+  Movie::SetPlaybackEndedCallback([this] { OnPlaybackEnded(); });
+
+  // The output is only written once the emulated game starts, so an old file would look like a
+  // successful render.
+  File::Delete(m_output_path, File::IfAbsentBehavior::NoConsoleWarning);
+
+  m_start_time = Clock::now();
+  return true;
+}
+
+void MovieRenderer::OnPlaybackEnded()
+{
+  if (IsFinished())
+    return;
+
+  m_seconds = std::chrono::duration<double>(Clock::now() - m_start_time).count();
+  m_frames = Movie::GetCurrentFrame();
+
+  m_finished.store(true, std::memory_order_release);
+  if (m_finished_callback)
+    m_finished_callback();
+}
+
+bool MovieRenderer::WroteOutput() const
+{
+  return File::Exists(m_output_path);
+}
+
+std::string MovieRenderer::GetSummary() const
+{
+  return fmt::format("Rendered {} frames of {} to {} in {:.1f} seconds ({:.1f} FPS)", m_frames,
+                     m_movie_path, m_output_path, m_seconds,
+                     m_seconds > 0.0 ? m_frames / m_seconds : 0.0);
+}
@@ -0,0 +1,52 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+struct BootParameters;
+
+// Plays an input recording back at unthrottled speed and dumps the rendered frames to a video
+// file, so that replays can be turned into videos on machines without a display or GPU.
+class MovieRenderer
+{
+public:
+  MovieRenderer(std::string movie_path, std::string output_path,
+                std::function<void()> finished_callback);
+  ~MovieRenderer();
+
+  MovieRenderer(const MovieRenderer&) = delete;
+  MovieRenderer& operator=(const MovieRenderer&) = delete;
+
+  // Overrides the settings needed for rendering for the current run and starts playback of the
+  // movie, adding its save state to the boot parameters if it has one. Call before booting.
+  // Unless use_software_renderer is false, the configured video backend is replaced by the
+  // software renderer.
+  bool Start(BootParameters& boot, bool use_software_renderer);
+
+  bool IsFinished() const { return m_finished.load(std::memory_order_acquire); }
+
+  // Only valid once rendering has finished.
+  bool WroteOutput() const;
+  std::string GetSummary() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  void OnPlaybackEnded();
+
+  std::string m_movie_path;
+  std::string m_output_path;
+  std::function<void()> m_finished_callback;
+  std::atomic<bool> m_finished{false};
+
+  Clock::time_point m_start_time;
+  double m_seconds = 0.0;
+  u64 m_frames = 0;
+};
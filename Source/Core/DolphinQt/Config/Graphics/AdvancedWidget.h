@@ -42,6 +42,7 @@ private:
   ConfigBool* m_show_graphs;
   ConfigBool* m_show_speed;
   ConfigBool* m_show_speed_colors;
+  ConfigBool* m_show_audio_latency;
   ConfigInteger* m_perf_samp_window;
   ConfigBool* m_log_render_time;
 
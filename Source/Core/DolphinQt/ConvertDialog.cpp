@@ -25,6 +25,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/CachedBlob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/ScrubbedBlob.h"
 #include "DiscIO/WIABlob.h"
@@ -462,8 +463,9 @@ void ConvertDialog::Convert()
       }
     }
 
+    // Reading compressed input with read-ahead lets it be decompressed on several threads
     if (!scrub_current_file)
-      blob_reader = DiscIO::CreateBlobReader(original_path);
+      blob_reader = DiscIO::CreateCachedBlobReader(original_path);
 
     if (!blob_reader)
     {
@@ -508,7 +510,7 @@ void ConvertDialog::Convert()
           const bool good =
               DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), original_path, dst_path.toStdString(),
                                         format == DiscIO::BlobType::RVZ, compression,
-                                        compression_level, block_size, callback);
+                                        compression_level, block_size, 0, callback);
           progress_dialog.Reset();
           return good;
         });
@@ -226,15 +226,18 @@ void FIFOPlayerWindow::LoadRecording()
 
 void FIFOPlayerWindow::SaveRecording()
 {
-  QString path = DolphinFileDialog::getSaveFileName(this, tr("Save FIFO log"), QString(),
-                                                    tr("Dolphin FIFO Log (*.dff)"));
+  const QString compressed_filter = tr("Compressed Dolphin FIFO Log (*.dff)");
+  QString selected_filter;
+  QString path = DolphinFileDialog::getSaveFileName(
+      this, tr("Save FIFO log"), QString(),
+      tr("Dolphin FIFO Log (*.dff)") + QStringLiteral(";;") + compressed_filter, &selected_filter);
 
   if (path.isEmpty())
     return;
 
   FifoDataFile* file = FifoRecorder::GetInstance().GetRecordedFile();
 
-  bool result = file->Save(path.toStdString());
+  bool result = file->Save(path.toStdString(), selected_filter == compressed_filter);
 
   if (!result)
   {
@@ -309,8 +312,9 @@ void FIFOPlayerWindow::UpdateInfo()
 
     for (u32 i = 0; i < file->GetFrameCount(); ++i)
     {
-      fifo_bytes += file->GetFrame(i).fifoData.size();
-      for (const auto& mem_update : file->GetFrame(i).memoryUpdates)
+      const auto frame = file->GetFrame(i);
+      fifo_bytes += frame->fifoData.size();
+      for (const auto& mem_update : frame->memoryUpdates)
         mem_bytes += mem_update.data.size();
     }
 
@@ -96,6 +96,26 @@ void AudioPane::CreateWidgets()
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
+  m_low_latency = new QCheckBox(tr("Low Latency Mode"));
+  m_low_latency->setToolTip(
+      tr("Keeps as little audio buffered as possible, and only buffers more when audio output "
+         "runs out of samples. If audio stretching is enabled, it is only used while emulation "
+         "runs below full speed. Cubeb, ALSA and PulseAudio backends also shrink their own "
+         "buffers."));
+  m_target_latency_label = new QLabel(tr("Target Latency:"));
+  m_target_latency_spin = new QSpinBox();
+  m_target_latency_spin->setMinimum(5);
+  m_target_latency_spin->setMaximum(200);
+  m_target_latency_spin->setSuffix(tr(" ms"));
+  m_target_latency_spin->setToolTip(
+      tr("Total audio latency low latency mode aims for, in milliseconds. Lower values may cause "
+         "audio crackling."));
+
+  m_cubic_resampling = new QCheckBox(tr("High Quality Resampling"));
+  m_cubic_resampling->setToolTip(
+      tr("Uses cubic instead of linear interpolation when converting audio to the output sample "
+         "rate. Reduces muffling and aliasing at a small CPU cost."));
+
   auto* dolby_quality_layout = new QHBoxLayout;
 
   m_dolby_quality_label = new QLabel(tr("Decoding Quality:"));
@@ -132,6 +152,9 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_wasapi_device_label, m_wasapi_device_combo);
 #endif
 
+  backend_layout->addRow(m_low_latency);
+  backend_layout->addRow(m_target_latency_label, m_target_latency_spin);
+  backend_layout->addRow(m_cubic_resampling);
   backend_layout->addRow(m_dolby_pro_logic);
   backend_layout->addRow(m_dolby_quality_label);
   backend_layout->addRow(dolby_quality_layout);
@@ -183,6 +206,10 @@ void AudioPane::ConnectWidgets()
             &AudioPane::SaveSettings);
   }
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
+  connect(m_low_latency, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
+  connect(m_target_latency_spin, qOverload<int>(&QSpinBox::valueChanged), this,
+          &AudioPane::SaveSettings);
+  connect(m_cubic_resampling, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_stretching_enable, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
@@ -231,6 +258,15 @@ void AudioPane::LoadSettings()
   // Volume
   OnVolumeChanged(settings.GetVolume());
 
+  // Low latency
+  m_low_latency->setChecked(Config::Get(Config::MAIN_AUDIO_LOW_LATENCY));
+  m_target_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_TARGET_LATENCY));
+  m_target_latency_label->setEnabled(m_low_latency->isChecked());
+  m_target_latency_spin->setEnabled(m_low_latency->isChecked());
+
+  // Resampling
+  m_cubic_resampling->setChecked(Config::Get(Config::MAIN_AUDIO_CUBIC_RESAMPLING));
+
   // DPL2
   m_dolby_pro_logic->setChecked(Config::Get(Config::MAIN_DPL2_DECODER));
   m_dolby_quality_slider->setValue(int(Config::Get(Config::MAIN_DPL2_QUALITY)));
@@ -298,6 +334,15 @@ void AudioPane::SaveSettings()
     OnVolumeChanged(settings.GetVolume());
   }
 
+  // Low latency
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LOW_LATENCY, m_low_latency->isChecked());
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_TARGET_LATENCY, m_target_latency_spin->value());
+  m_target_latency_label->setEnabled(m_low_latency->isChecked());
+  m_target_latency_spin->setEnabled(m_low_latency->isChecked());
+
+  // Resampling
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_CUBIC_RESAMPLING, m_cubic_resampling->isChecked());
+
   // DPL2
   Config::SetBaseOrCurrent(Config::MAIN_DPL2_DECODER, m_dolby_pro_logic->isChecked());
   Config::SetBase(Config::MAIN_DPL2_QUALITY,
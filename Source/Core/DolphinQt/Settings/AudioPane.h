@@ -66,6 +66,10 @@ private:
   QLabel* m_dolby_quality_latency_label;
   QLabel* m_latency_label;
   QSpinBox* m_latency_spin;
+  QCheckBox* m_low_latency;
+  QLabel* m_target_latency_label;
+  QSpinBox* m_target_latency_spin;
+  QCheckBox* m_cubic_resampling;
 #ifdef _WIN32
   QLabel* m_wasapi_device_label;
   QComboBox* m_wasapi_device_combo;
@@ -3,6 +3,7 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
@@ -15,7 +16,9 @@
 #include <fmt/ostream.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/CachedBlob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/ScrubbedBlob.h"
 #include "DiscIO/Volume.h"
@@ -53,6 +56,8 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
     return DiscIO::BlobType::WIA;
   else if (format_str == "rvz")
     return DiscIO::BlobType::RVZ;
+  else if (format_str == "dedup")
+    return DiscIO::BlobType::DEDUP;
   return std::nullopt;
 }
 
@@ -85,7 +90,7 @@ int ConvertCommand(const std::vector<std::string>& args)
       .type("string")
       .action("store")
       .help("Container format to use. Default is RVZ. [%choices]")
-      .choices({"iso", "gcz", "wia", "rvz"});
+      .choices({"iso", "gcz", "wia", "rvz", "dedup"});
 
   parser.add_option("-s", "--scrub")
       .action("store_true")
@@ -94,8 +99,8 @@ int ConvertCommand(const std::vector<std::string>& args)
   parser.add_option("-b", "--block_size")
       .type("int")
       .action("store")
-      .help("Block size for GCZ/WIA/RVZ formats, as an integer. Suggested value for RVZ: 131072 "
-            "(128 KiB)");
+      .help("Block size for GCZ/WIA/RVZ/dedup formats, as an integer. Suggested value for RVZ: "
+            "131072 (128 KiB). Suggested value for dedup: 1048576 (1 MiB)");
 
   parser.add_option("-c", "--compression")
       .type("string")
@@ -110,6 +115,25 @@ int ConvertCommand(const std::vector<std::string>& args)
       .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
             "zstd: 5");
 
+  parser.add_option("-m", "--memory_budget")
+      .type("int")
+      .action("store")
+      .help("Optional. How much memory in MiB the compression threads of WIA/RVZ may use. "
+            "Fewer threads are used if one per CPU core wouldn't fit. Useful for high LZMA or "
+            "zstd compression levels.");
+
+  parser.add_option("--store")
+      .type("string")
+      .action("store")
+      .help("Optional. Store directory to put the chunks of a dedup disc image in. A relative "
+            "path is relative to the directory of the output file. Default: DedupStore")
+      .metavar("DIR")
+      .set_default("DedupStore");
+
+  parser.add_option("-p", "--progress")
+      .action("store_true")
+      .help("Optional. Print the progress and throughput while converting.");
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -144,8 +168,9 @@ int ConvertCommand(const std::vector<std::string>& args)
   }
   const DiscIO::BlobType format = format_o.value();
 
-  // Open the blob reader
-  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
+  // Open the blob reader. Reading compressed input with read-ahead lets it be decompressed on
+  // several threads, so that reading keeps up with the compression threads.
+  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateCachedBlobReader(input_file_path);
   if (!blob_reader)
   {
     fmt::print(std::cerr, "Error: The input file could not be opened.\n");
@@ -217,11 +242,11 @@ int ConvertCommand(const std::vector<std::string>& args)
     block_size_o = static_cast<int>(options.get("block_size"));
 
   if (format == DiscIO::BlobType::GCZ || format == DiscIO::BlobType::WIA ||
-      format == DiscIO::BlobType::RVZ)
+      format == DiscIO::BlobType::RVZ || format == DiscIO::BlobType::DEDUP)
   {
     if (!block_size_o.has_value())
     {
-      fmt::print(std::cerr, "Error: Block size must be set for GCZ/RVZ/WIA\n");
+      fmt::print(std::cerr, "Error: Block size must be set for GCZ/RVZ/WIA/dedup\n");
       return EXIT_FAILURE;
     }
 
@@ -296,8 +321,41 @@ int ConvertCommand(const std::vector<std::string>& args)
     }
   }
 
+  // --memory_budget
+  u64 memory_budget = 0;
+  if (options.is_set("memory_budget"))
+  {
+    const int memory_budget_mib = static_cast<int>(options.get("memory_budget"));
+    if (memory_budget_mib <= 0)
+    {
+      fmt::print(std::cerr, "Error: Memory budget must be a positive number of MiB\n");
+      return EXIT_FAILURE;
+    }
+    memory_budget = static_cast<u64>(memory_budget_mib) * 1024 * 1024;
+  }
+
+  // --progress
+  const bool show_progress = static_cast<bool>(options.get("progress"));
+  const u64 input_size = blob_reader->GetDataSize();
+  const auto start_time = std::chrono::steady_clock::now();
+  auto last_progress_time = start_time;
+
+  const auto get_mib_per_second = [&start_time](double bytes) {
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+    return bytes / (1024 * 1024) / std::max(elapsed.count(), 0.001);
+  };
+
   // Perform the conversion
-  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
+  const auto status_callback = [&](const std::string& text, float completion) {
+    const auto now = std::chrono::steady_clock::now();
+    if (!show_progress || now - last_progress_time < std::chrono::seconds(1))
+      return true;
+
+    last_progress_time = now;
+    fmt::print(std::cerr, "{:5.1f}% {} ({:.1f} MiB/s)\n", completion * 100, text,
+               get_mib_per_second(completion * input_size));
+    return true;
+  };
 
   bool success = false;
 
@@ -306,7 +364,7 @@ int ConvertCommand(const std::vector<std::string>& args)
   case DiscIO::BlobType::PLAIN:
   {
     success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
-                                     NOOP_STATUS_CALLBACK);
+                                     status_callback);
     break;
   }
 
@@ -321,7 +379,7 @@ int ConvertCommand(const std::vector<std::string>& args)
         sub_type = 1;
     }
     success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
+                                   block_size_o.value(), status_callback);
     break;
   }
 
@@ -331,7 +389,14 @@ int ConvertCommand(const std::vector<std::string>& args)
     success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
                                         format == DiscIO::BlobType::RVZ, compression_o.value(),
                                         compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
+                                        memory_budget, status_callback);
+    break;
+  }
+
+  case DiscIO::BlobType::DEDUP:
+  {
+    success = DiscIO::ConvertToDedup(blob_reader.get(), input_file_path, output_file_path,
+                                     options["store"], block_size_o.value(), status_callback);
     break;
   }
 
@@ -348,6 +413,14 @@ int ConvertCommand(const std::vector<std::string>& args)
     return EXIT_FAILURE;
   }
 
+  if (show_progress)
+  {
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+    fmt::print(std::cerr, "Converted {:.1f} MiB to {:.1f} MiB in {:.1f} s ({:.1f} MiB/s)\n",
+               input_size / (1024.0 * 1024.0), File::GetSize(output_file_path) / (1024.0 * 1024.0),
+               elapsed.count(), get_mib_per_second(static_cast<double>(input_size)));
+  }
+
   return EXIT_SUCCESS;
 }
 }  // namespace DolphinTool
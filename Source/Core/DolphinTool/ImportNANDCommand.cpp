@@ -0,0 +1,92 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ImportNANDCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "DiscIO/NANDImporter.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+static void PrintThroughput(const DiscIO::NANDImporter::Throughput& throughput)
+{
+  const double mib = throughput.bytes_extracted / (1024.0 * 1024.0);
+  fmt::print(std::cout, "Extracted {} files ({:.1f} MiB) in {:.2f} s\n", throughput.files, mib,
+             throughput.total.count());
+  fmt::print(std::cout, "Reading: {:.2f} s\n", throughput.reading.count());
+  fmt::print(std::cout, "Extracting: {:.2f} s ({:.1f} MiB/s)\n", throughput.extracting.count(),
+             mib / std::max(throughput.extracting.count(), 0.001));
+}
+
+int ImportNANDCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: import-nand [options]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path. The NAND backup replaces the Wii NAND of this user folder. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to BootMii NAND backup FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-k", "--keys")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to the OTP/SEEPROM dump FILE, if it is not appended to the backup.")
+      .metavar("FILE");
+
+  parser.add_option("-t", "--throughput")
+      .action("store_true")
+      .help("Optional. Print how long reading the backup and extracting the files took.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  // Validate options
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& input_file_path = options["input"];
+  const std::string keys_file_path = options.is_set("keys") ? options["keys"] : "";
+
+  DiscIO::NANDImporter importer;
+  const bool success = importer.ImportNANDBin(
+      input_file_path, [] {},
+      [&keys_file_path] {
+        if (keys_file_path.empty())
+          fmt::print(std::cerr, "Error: The backup doesn't include keys and no keys file is set\n");
+        return keys_file_path;
+      });
+  if (!success)
+  {
+    fmt::print(std::cerr, "Error: Unable to import NAND backup\n");
+    return EXIT_FAILURE;
+  }
+
+  if (static_cast<bool>(options.get("throughput")))
+    PrintThroughput(importer.GetThroughput());
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
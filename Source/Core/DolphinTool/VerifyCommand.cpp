@@ -3,6 +3,7 @@
 
 #include "DolphinTool/VerifyCommand.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <string>
 #include <vector>
@@ -73,6 +74,26 @@ static void PrintFullReport(const DiscIO::VolumeVerifier::Result& result)
   }
 }
 
+static void PrintThroughput(const DiscIO::VolumeVerifier::Throughput& throughput)
+{
+  const double mib = throughput.bytes / (1024.0 * 1024.0);
+  fmt::print(std::cout, "Processed {:.1f} MiB in {:.2f} s ({:.1f} MiB/s)\n", mib,
+             throughput.total.count(), mib / std::max(throughput.total.count(), 0.001));
+  fmt::print(std::cout, "Reading: {:.2f} s\n", throughput.reading.count());
+  fmt::print(std::cout, "Waiting for hashing: {:.2f} s\n", throughput.waiting_for_workers.count());
+  if (throughput.crc32.count() > 0)
+    fmt::print(std::cout, "CRC32 thread busy: {:.2f} s\n", throughput.crc32.count());
+  if (throughput.md5.count() > 0)
+    fmt::print(std::cout, "MD5 thread busy: {:.2f} s\n", throughput.md5.count());
+  if (throughput.sha1.count() > 0)
+    fmt::print(std::cout, "SHA1 thread busy: {:.2f} s\n", throughput.sha1.count());
+  if (throughput.integrity_checks.count() > 0)
+  {
+    fmt::print(std::cout, "Integrity check threads busy: {:.2f} s\n",
+               throughput.integrity_checks.count());
+  }
+}
+
 int VerifyCommand(const std::vector<std::string>& args)
 {
   optparse::OptionParser parser;
@@ -92,6 +113,11 @@ int VerifyCommand(const std::vector<std::string>& args)
       .help("Path to disc image FILE.")
       .metavar("FILE");
 
+  parser.add_option("-t", "--throughput")
+      .action("store_true")
+      .help("Optional. Print how fast the data was processed, and whether reading or hashing "
+            "was the bottleneck.");
+
   parser.add_option("-a", "--algorithm")
       .type("string")
       .action("store")
@@ -176,6 +202,9 @@ int VerifyCommand(const std::vector<std::string>& args)
     }
   }
 
+  if (static_cast<bool>(options.get("throughput")))
+    PrintThroughput(result.throughput);
+
   return EXIT_SUCCESS;
 }
 }  // namespace DolphinTool
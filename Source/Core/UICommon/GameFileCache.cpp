@@ -4,12 +4,17 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <functional>
+#include <future>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -19,6 +24,7 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -26,17 +32,79 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 24;  // Last changed in PR 11557
+static constexpr u32 CACHE_REVISION = 26;  // Last changed for the record table format
+
+constexpr u32 MAX_THREADS = 8;
+
+// The cache file starts with a CacheHeader, followed by a CacheRecord for each game, followed by
+// the state of each game. Since every game is stored separately, the games can be read and
+// written on several threads at once.
+struct CacheHeader
+{
+  u32 revision;
+  u32 game_count;
+  u64 file_size;
+};
+
+struct CacheRecord
+{
+  u64 offset;
+  u64 size;
+};
+
+// Calls function(i) for every i in [0, count), split into contiguous ranges over several threads.
+template <typename Function>
+static void ParallelFor(size_t count, Function function)
+{
+  const size_t thread_count =
+      std::min<size_t>(count, std::clamp(std::thread::hardware_concurrency(), 1u, MAX_THREADS));
+  if (thread_count <= 1)
+  {
+    for (size_t i = 0; i < count; ++i)
+      function(i);
+    return;
+  }
+
+  std::vector<std::future<void>> futures;
+  for (size_t thread = 0; thread < thread_count; ++thread)
+  {
+    const size_t begin = count * thread / thread_count;
+    const size_t end = count * (thread + 1) / thread_count;
+    futures.push_back(std::async(std::launch::async, [begin, end, &function] {
+      for (size_t i = begin; i < end; ++i)
+        function(i);
+    }));
+  }
+  for (std::future<void>& future : futures)
+    future.wait();
+}
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
 {
   static const std::vector<std::string> search_extensions = {
       ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia",
-      ".rvz", ".nfs", ".wad", ".dol",  ".elf", ".json"};
+      ".rvz", ".dedup", ".nfs", ".wad", ".dol", ".elf", ".json"};
 
+  // Scanning is mostly waiting for the file system, so scan the directories in parallel.
   // TODO: We could process paths iteratively as they are found
-  return Common::DoFileSearch(directories_to_scan, search_extensions, recursive_scan);
+  std::vector<std::vector<std::string>> results(directories_to_scan.size());
+  ParallelFor(directories_to_scan.size(), [&](size_t i) {
+    results[i] =
+        Common::DoFileSearch({directories_to_scan[i]}, search_extensions, recursive_scan);
+  });
+
+  std::vector<std::string> paths;
+  for (std::vector<std::string>& result : results)
+  {
+    paths.insert(paths.end(), std::make_move_iterator(result.begin()),
+                 std::make_move_iterator(result.end()));
+  }
+
+  // Overlapping directories would otherwise give duplicates, like with a single DoFileSearch call
+  std::sort(paths.begin(), paths.end());
+  paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+  return paths;
 }
 
 GameFileCache::GameFileCache() : m_path(File::GetUserPath(D_CACHE_IDX) + "gamelist.cache")
@@ -155,43 +223,100 @@ bool GameFileCache::UpdateAdditionalMetadata(
     std::function<void(const std::shared_ptr<const GameFile>&)> game_updated,
     const std::atomic_bool& processing_halted)
 {
+  // Checking for changes means looking at several files on disk for each game, so check the
+  // games in parallel. The callback is still only called from this thread, as soon as each game
+  // has been checked rather than once all of them have.
+  std::mutex mutex;
+  std::condition_variable checked_cv;
+  std::vector<std::pair<size_t, std::shared_ptr<GameFile>>> updated_files;
+  bool all_checked = false;
+
+  std::future<void> checking = std::async(std::launch::async, [&] {
+    ParallelFor(m_cached_files.size(), [&](size_t i) {
+      if (processing_halted)
+        return;
+
+      std::shared_ptr<GameFile> updated_file =
+          GetUpdatedAdditionalMetadata(m_cached_files[i].get());
+      if (!updated_file)
+        return;
+
+      std::lock_guard lk(mutex);
+      updated_files.emplace_back(i, std::move(updated_file));
+      checked_cv.notify_one();
+    });
+
+    std::lock_guard lk(mutex);
+    all_checked = true;
+    checked_cv.notify_one();
+  });
+
   bool cache_changed = false;
 
-  for (std::shared_ptr<GameFile>& file : m_cached_files)
+  std::unique_lock lk(mutex);
+  while (true)
   {
-    if (processing_halted)
-      break;
+    checked_cv.wait(lk, [&] { return !updated_files.empty() || all_checked; });
+    const bool done = all_checked;
+    auto ready_files = std::move(updated_files);
+    updated_files.clear();
+    lk.unlock();
+
+    // Only the thread checking game i reads m_cached_files[i], and it's done with it by now
+    for (auto& [i, updated_file] : ready_files)
+    {
+      m_cached_files[i] = std::move(updated_file);
+      cache_changed = true;
+      if (game_updated)
+        game_updated(m_cached_files[i]);
+    }
 
-    const bool updated = UpdateAdditionalMetadata(&file);
-    cache_changed |= updated;
-    if (game_updated && updated)
-      game_updated(file);
+    if (done)
+      break;
+    lk.lock();
   }
 
+  checking.wait();
   return cache_changed;
 }
 
 bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file)
 {
-  const bool xml_metadata_changed = (*game_file)->XMLMetadataChanged();
-  const bool wii_banner_changed = (*game_file)->WiiBannerChanged();
-  const bool custom_banner_changed = (*game_file)->CustomBannerChanged();
+  std::shared_ptr<GameFile> updated_file = GetUpdatedAdditionalMetadata(game_file->get());
+  if (!updated_file)
+    return false;
 
-  (*game_file)->DownloadDefaultCover();
+  *game_file = std::move(updated_file);
+  return true;
+}
 
-  const bool default_cover_changed = (*game_file)->DefaultCoverChanged();
-  const bool custom_cover_changed = (*game_file)->CustomCoverChanged();
+std::shared_ptr<GameFile> GameFileCache::GetUpdatedAdditionalMetadata(GameFile* game_file)
+{
+  const bool xml_metadata_changed = game_file->XMLMetadataChanged();
+  const bool wii_banner_changed = game_file->WiiBannerChanged();
+  const bool custom_banner_changed = game_file->CustomBannerChanged();
+
+  // Games are checked on several threads, and different files of the same game share a cover.
+  // Handling one cover at a time avoids writing a cover file that's being read or written.
+  bool default_cover_changed;
+  {
+    static std::mutex s_cover_mutex;
+    std::lock_guard lk(s_cover_mutex);
+    game_file->DownloadDefaultCover();
+    default_cover_changed = game_file->DefaultCoverChanged();
+  }
+  const bool custom_cover_changed = game_file->CustomCoverChanged();
 
   if (!xml_metadata_changed && !wii_banner_changed && !custom_banner_changed &&
       !default_cover_changed && !custom_cover_changed)
   {
-    return false;
+    return nullptr;
   }
 
   // If a cached file needs an update, apply the updates to a copy and delete the original.
   // This makes the usage of cached files in other threads safe.
 
-  std::shared_ptr<GameFile> copy = std::make_shared<GameFile>(**game_file);
+  std::shared_ptr<GameFile> copy = std::make_shared<GameFile>(*game_file);
   if (xml_metadata_changed)
     copy->XMLMetadataCommit();
   if (wii_banner_changed)
@@ -203,86 +328,113 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
   if (custom_cover_changed)
     copy->CustomCoverCommit();
 
-  *game_file = std::move(copy);
-
-  return true;
+  return copy;
 }
 
 bool GameFileCache::Load()
 {
-  return SyncCacheFile(false);
+  if (LoadCacheFile())
+    return true;
+
+  // The cache is probably corrupted or from another revision, or it doesn't exist yet
+  File::Delete(m_path, File::IfAbsentBehavior::NoConsoleWarning);
+  return false;
 }
 
 bool GameFileCache::Save()
 {
-  return SyncCacheFile(true);
+  if (SaveCacheFile())
+    return true;
+
+  // If some file operation failed, try to delete the probably-corrupted cache
+  File::Delete(m_path);
+  return false;
 }
 
-bool GameFileCache::SyncCacheFile(bool save)
+bool GameFileCache::LoadCacheFile()
 {
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
-  if (!f)
+  Common::MappedFile file;
+  if (!file.Open(m_path) || file.GetSize() < sizeof(CacheHeader))
+    return false;
+
+  CacheHeader header;
+  std::memcpy(&header, file.GetData(), sizeof(header));
+  const u64 records_end = sizeof(header) + u64(header.game_count) * sizeof(CacheRecord);
+  if (header.revision != CACHE_REVISION || header.file_size != file.GetSize() ||
+      records_end > file.GetSize())
+  {
     return false;
-  bool success = false;
-  if (save)
+  }
+
+  std::vector<CacheRecord> records(header.game_count);
+  std::memcpy(records.data(), file.GetData() + sizeof(header),
+              records.size() * sizeof(CacheRecord));
+  for (const CacheRecord& record : records)
   {
+    if (record.offset < records_end || record.offset > file.GetSize() ||
+        record.size > file.GetSize() - record.offset)
+    {
+      return false;
+    }
+  }
+
+  std::vector<std::shared_ptr<GameFile>> cached_files(records.size());
+  std::vector<u8> valid(records.size());
+  ParallelFor(records.size(), [&](size_t i) {
+    // PointerWrap only reads from the buffer in read mode
+    u8* ptr = const_cast<u8*>(file.GetData()) + records[i].offset;
+    const u8* const end = ptr + records[i].size;
+    PointerWrap p(&ptr, records[i].size, PointerWrap::Mode::Read);
+
+    cached_files[i] = std::make_shared<GameFile>();
+    cached_files[i]->DoState(p);
+    valid[i] = p.IsReadMode() && ptr == end;
+  });
+
+  if (std::find(valid.begin(), valid.end(), 0) != valid.end())
+    return false;
+
+  m_cached_files = std::move(cached_files);
+  return true;
+}
+
+bool GameFileCache::SaveCacheFile()
+{
+  std::vector<std::vector<u8>> states(m_cached_files.size());
+  ParallelFor(m_cached_files.size(), [&](size_t i) {
     // Measure the size of the buffer.
     u8* ptr = nullptr;
     PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
+    m_cached_files[i]->DoState(p_measure);
     const size_t buffer_size = reinterpret_cast<size_t>(ptr);
 
     // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
+    states[i].resize(buffer_size);
+    ptr = states[i].data();
     PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
-  }
-  else
-  {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
-    {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
-    }
-  }
-  if (!success)
+    m_cached_files[i]->DoState(p);
+  });
+
+  std::vector<CacheRecord> records(states.size());
+  u64 offset = sizeof(CacheHeader) + records.size() * sizeof(CacheRecord);
+  for (size_t i = 0; i < states.size(); ++i)
   {
-    // If some file operation failed, try to delete the probably-corrupted cache
-    f.Close();
-    File::Delete(m_path);
+    records[i] = {offset, states[i].size()};
+    offset += states[i].size();
   }
-  return success;
-}
+  const CacheHeader header{CACHE_REVISION, static_cast<u32>(records.size()), offset};
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
-{
-  struct
-  {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+  File::IOFile f(m_path, "wb");
+  if (!f || !f.WriteArray(&header, 1) || !f.WriteArray(records.data(), records.size()))
+    return false;
+
+  for (const std::vector<u8>& state : states)
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
-    {
-      p->SetMeasureMode();
-      return;
-    }
+    if (!f.WriteBytes(state.data(), state.size()))
+      return false;
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
-  });
+
+  return true;
 }
 
 }  // namespace UICommon
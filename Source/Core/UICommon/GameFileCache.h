@@ -12,8 +12,6 @@
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
-
 namespace UICommon
 {
 class GameFile;
@@ -53,10 +51,12 @@ public:
   bool Save();
 
 private:
+  // Returns an updated copy of the game file, or nullptr if nothing changed.
+  static std::shared_ptr<GameFile> GetUpdatedAdditionalMetadata(GameFile* game_file);
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  bool LoadCacheFile();
+  bool SaveCacheFile();
 
   std::string m_path;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
@@ -4,11 +4,23 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <thread>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Event.h"
+#include "Common/Thread.h"
+
+#include "Core/Config/GraphicsSettings.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
@@ -25,6 +37,13 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// Size of the EFB regions handed out to the rasterizer threads. This must be a multiple of
+// BLOCK_SIZE, so that the 2x2 blocks used for the LOD calculation never straddle two tiles.
+static constexpr s32 TILE_SIZE = 64;
+static constexpr s32 NUM_TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr s32 NUM_TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0);
+
 struct SlopeContext
 {
   SlopeContext(const OutputVertexData* v0, const OutputVertexData* v1, const OutputVertexData* v2,
@@ -96,21 +115,132 @@ struct Slope
   }
 };
 
-static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
+// Everything needed to rasterize a triangle once it has been set up. Within a batch bpmem is
+// constant, so the per-pixel state can be read from it directly while drawing.
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Bounding rectangle, already clipped to the scissor
+  s32 minx;
+  s32 maxx;
+  s32 miny;
+  s32 maxy;
+
+  // Half-edge constants and deltas, in 28.4 fixed point
+  s32 C1;
+  s32 C2;
+  s32 C3;
+  s32 DX12;
+  s32 DX23;
+  s32 DX31;
+  s32 DY12;
+  s32 DY23;
+  s32 DY31;
+};
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// State owned by a single rasterizer thread.
+struct RasterContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  u32 rasterized_pixels = 0;
+};
+
+struct RasterWorker
+{
+  RasterContext context;
+  Common::Event start_event;
+  std::thread thread;
+};
+
+// The z slope is kept across primitives for zfreeze, even when they are culled.
+static Slope ZSlope;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
+// Context used by the video thread, both when drawing directly and when helping out the workers.
+static RasterContext s_main_context;
+static TriangleSetup s_immediate_triangle;
+
+// When running multi-threaded, triangles are set up on the video thread and binned by tile. The
+// tiles are rasterized in parallel once the batch ends; each tile draws its triangles in
+// submission order, so the result is identical to drawing them one after another.
+static std::vector<std::unique_ptr<RasterWorker>> s_workers;
+static std::vector<TriangleSetup> s_triangles;
+static std::array<std::vector<u32>, NUM_TILES_X * NUM_TILES_Y> s_bins;
+static std::vector<u32> s_active_tiles;
+static std::atomic<u32> s_next_tile;
+static std::atomic<u32> s_busy_workers;
+static Common::Event s_done_event;
+static std::atomic<bool> s_exit_workers;
+
+static void RasterizeTiles(RasterContext& context);
+
+static void WorkerThread(RasterWorker* worker, u32 index)
+{
+  Common::SetCurrentThreadName(fmt::format("SW Rasterizer {}", index).c_str());
+
+  while (true)
+  {
+    worker->start_event.Wait();
+    if (s_exit_workers.load(std::memory_order_relaxed))
+      return;
+
+    RasterizeTiles(worker->context);
+
+    if (s_busy_workers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      s_done_event.Set();
+  }
+}
+
+static u32 GetNumRasterizerThreads()
+{
+  const int setting = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
+  if (setting >= 0)
+    return static_cast<u32>(std::max(setting, 1));
+
+  // Automatic number. Leave one core for the emulated CPU.
+  return static_cast<u32>(std::max(cpu_info.num_cores - 1, 1));
+}
+
 void Init()
 {
+  Shutdown();
+
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
   ZSlope = Slope();
+
+  // The video thread rasterizes tiles too, so it counts towards the thread count.
+  const u32 num_threads =
+      std::min<u32>(GetNumRasterizerThreads(), static_cast<u32>(NUM_TILES_X * NUM_TILES_Y));
+  s_exit_workers.store(false, std::memory_order_relaxed);
+  for (u32 i = 1; i < num_threads; i++)
+  {
+    auto worker = std::make_unique<RasterWorker>();
+    worker->thread = std::thread(WorkerThread, worker.get(), i);
+    s_workers.push_back(std::move(worker));
+  }
+}
+
+void Shutdown()
+{
+  s_exit_workers.store(true, std::memory_order_relaxed);
+  for (auto& worker : s_workers)
+  {
+    worker->start_event.Set();
+    worker->thread.join();
+  }
+  s_workers.clear();
+
+  s_triangles.clear();
+  for (auto& bin : s_bins)
+    bin.clear();
+  s_active_tiles.clear();
 }
 
 void ScissorChanged()
@@ -142,14 +272,16 @@ static inline int iround(float x)
 
 void SetTevKonstColors()
 {
-  tev.SetKonstColors();
+  s_main_context.tev.SetKonstColors();
+  for (auto& worker : s_workers)
+    worker->context.tev.SetKonstColors();
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(RasterContext& context, const TriangleSetup& tri, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  context.rasterized_pixels++;
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(tri.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
@@ -164,7 +296,9 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -175,7 +309,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      u16 color = (u16)tri.ColorSlopes[i][comp].GetValue(x, y);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -207,7 +341,8 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -218,9 +353,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -258,7 +393,7 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const TriangleSetup& tri, s32 blockX, s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -269,19 +404,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / tri.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = tri.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = tri.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = tri.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -291,7 +426,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -303,7 +439,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -320,9 +457,10 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
   }
 }
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
+// Returns false if the triangle is rejected by the scissor test.
+static bool SetupTriangle(TriangleSetup* tri, const OutputVertexData* v0,
+                          const OutputVertexData* v1, const OutputVertexData* v2,
+                          const BPFunctions::ScissorRect& scissor)
 {
   // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
   // zfreeze depends on it
@@ -349,15 +487,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -376,7 +505,15 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   maxy = std::min(maxy, scissor.rect.bottom);
 
   if (minx >= maxx || miny >= maxy)
-    return;
+    return false;
+
+  tri->minx = minx;
+  tri->maxx = maxx;
+  tri->miny = miny;
+  tri->maxy = maxy;
+
+  // Capture the z slope as it is now, since later primitives may change it
+  tri->ZSlope = ZSlope;
 
   // Set up the remaining slopes
   const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
@@ -384,20 +521,24 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
 
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
+  tri->WSlope = Slope(w[0], w[1], w[2], ctx);
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    {
+      tri->ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
     {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
+      tri->TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0],
+                                      v1->texCoords[i][comp] * w[1],
+                                      v2->texCoords[i][comp] * w[2], ctx);
     }
   }
 
@@ -414,6 +555,49 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
     C3++;
 
+  tri->C1 = C1;
+  tri->C2 = C2;
+  tri->C3 = C3;
+  tri->DX12 = DX12;
+  tri->DX23 = DX23;
+  tri->DX31 = DX31;
+  tri->DY12 = DY12;
+  tri->DY23 = DY23;
+  tri->DY31 = DY31;
+  return true;
+}
+
+// Rasterizes the part of the triangle that lies within the given rectangle. The rectangle must be
+// aligned to BLOCK_SIZE, so that the blocks visited match those of an unclipped draw.
+static void RasterizeTriangle(RasterContext& context, const TriangleSetup& tri, s32 clip_minx,
+                              s32 clip_maxx, s32 clip_miny, s32 clip_maxy)
+{
+  const s32 minx = std::max(tri.minx, clip_minx);
+  const s32 maxx = std::min(tri.maxx, clip_maxx);
+  const s32 miny = std::max(tri.miny, clip_miny);
+  const s32 maxy = std::min(tri.maxy, clip_maxy);
+
+  const s32 C1 = tri.C1;
+  const s32 C2 = tri.C2;
+  const s32 C3 = tri.C3;
+
+  const s32 DX12 = tri.DX12;
+  const s32 DX23 = tri.DX23;
+  const s32 DX31 = tri.DX31;
+
+  const s32 DY12 = tri.DY12;
+  const s32 DY23 = tri.DY23;
+  const s32 DY31 = tri.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
@@ -455,7 +639,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context.rasterBlock, tri, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -465,7 +649,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(context, tri, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -488,7 +672,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(context, tri, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -505,12 +689,107 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+static void RasterizeTiles(RasterContext& context)
+{
+  const u32 num_tiles = static_cast<u32>(s_active_tiles.size());
+  for (u32 i = s_next_tile.fetch_add(1, std::memory_order_relaxed); i < num_tiles;
+       i = s_next_tile.fetch_add(1, std::memory_order_relaxed))
+  {
+    const u32 tile = s_active_tiles[i];
+    const s32 tile_minx = static_cast<s32>(tile % NUM_TILES_X) * TILE_SIZE;
+    const s32 tile_miny = static_cast<s32>(tile / NUM_TILES_X) * TILE_SIZE;
+
+    for (const u32 index : s_bins[tile])
+    {
+      RasterizeTriangle(context, s_triangles[index], tile_minx, tile_minx + TILE_SIZE, tile_miny,
+                        tile_miny + TILE_SIZE);
+    }
+  }
+}
+
+static void BinTriangle(const TriangleSetup& tri, u32 index)
+{
+  const s32 first_x = tri.minx / TILE_SIZE;
+  const s32 last_x = (tri.maxx - 1) / TILE_SIZE;
+  const s32 first_y = tri.miny / TILE_SIZE;
+  const s32 last_y = (tri.maxy - 1) / TILE_SIZE;
+
+  for (s32 tile_y = first_y; tile_y <= last_y; tile_y++)
+  {
+    for (s32 tile_x = first_x; tile_x <= last_x; tile_x++)
+    {
+      const u32 tile = static_cast<u32>(tile_y * NUM_TILES_X + tile_x);
+      if (s_bins[tile].empty())
+        s_active_tiles.push_back(tile);
+      s_bins[tile].push_back(index);
+    }
+  }
+}
+
+static void FlushStatistics(RasterContext& context)
+{
+  ADDSTAT(g_stats.this_frame.rasterized_pixels, context.rasterized_pixels);
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, context.tev.PixelsIn);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, context.tev.PixelsOut);
+  context.rasterized_pixels = 0;
+  context.tev.PixelsIn = 0;
+  context.tev.PixelsOut = 0;
+}
+
+void Flush()
+{
+  if (!s_active_tiles.empty())
+  {
+    s_next_tile.store(0, std::memory_order_relaxed);
+
+    // Waking the workers isn't worth it if everything falls into a single tile.
+    if (s_active_tiles.size() > 1)
+    {
+      s_busy_workers.store(static_cast<u32>(s_workers.size()), std::memory_order_relaxed);
+      for (auto& worker : s_workers)
+        worker->start_event.Set();
+
+      RasterizeTiles(s_main_context);
+      s_done_event.Wait();
+    }
+    else
+    {
+      RasterizeTiles(s_main_context);
+    }
+
+    for (const u32 tile : s_active_tiles)
+      s_bins[tile].clear();
+    s_active_tiles.clear();
+    s_triangles.clear();
+  }
+
+  FlushStatistics(s_main_context);
+  for (auto& worker : s_workers)
+    FlushStatistics(worker->context);
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
   INCSTAT(g_stats.this_frame.num_triangles_drawn);
 
   for (const auto& scissor : scissors)
-    DrawTriangleFrontFace(v0, v1, v2, scissor);
+  {
+    if (s_workers.empty())
+    {
+      if (SetupTriangle(&s_immediate_triangle, v0, v1, v2, scissor))
+      {
+        RasterizeTriangle(s_main_context, s_immediate_triangle, 0, EFB_WIDTH, 0, EFB_HEIGHT);
+      }
+    }
+    else
+    {
+      TriangleSetup& tri = s_triangles.emplace_back();
+      if (SetupTriangle(&tri, v0, v1, v2, scissor))
+        BinTriangle(tri, static_cast<u32>(s_triangles.size() - 1));
+      else
+        s_triangles.pop_back();
+    }
+  }
 }
 }  // namespace Rasterizer
@@ -6,6 +6,7 @@
 #include <array>
 
 #include "Common/EnumMap.h"
+#include "VideoBackends/Software/TevCombiner.h"
 #include "VideoCommon/BPMemory.h"
 
 class Tev
@@ -90,14 +91,6 @@ class Tev
     }
   };
 
-  struct InputRegType
-  {
-    unsigned a : 8;
-    unsigned b : 8;
-    unsigned c : 8;
-    signed d : 11;
-  };
-
   struct TextureCoordinateType
   {
     signed s : 24;
@@ -192,9 +185,6 @@ class Tev
       TevKonstRef::Value(KonstantColors[2].a),  // Konst 2 Alpha
       TevKonstRef::Value(KonstantColors[3].a),  // Konst 3 Alpha
   };
-  static constexpr Common::EnumMap<s16, TevBias::Compare> s_BiasLUT{0, 128, -128, 0};
-  static constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleLShiftLUT{0, 1, 2, 0};
-  static constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleRShiftLUT{0, 0, 0, 1};
 
   enum BufferBase
   {
@@ -205,10 +195,14 @@ class Tev
 
   void SetRasColor(RasColorChan colorChan, u32 swaptable);
 
-  void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
-  void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+  void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc,
+                        const TevCombiner::Inputs& inputs);
+  void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc,
+                        const TevCombiner::Inputs& inputs);
+  void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac,
+                        const TevCombiner::Inputs& inputs);
+  void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac,
+                        const TevCombiner::Inputs& inputs);
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
@@ -221,6 +215,11 @@ public:
   s32 TextureLod[16]{};
   bool TextureLinear[16]{};
 
+  // Pixel counts for the statistics overlay. They are kept per instance instead of being added to
+  // g_stats directly, since every rasterizer thread owns its own Tev.
+  u32 PixelsIn = 0;
+  u32 PixelsOut = 0;
+
   enum
   {
     ALP_C,
@@ -0,0 +1,150 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Software/TevCombiner.h"
+
+#include <algorithm>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/EnumMap.h"
+#include "Common/Intrinsics.h"
+
+namespace TevCombiner
+{
+namespace
+{
+enum
+{
+  ALP_C,
+  BLU_C,
+  GRN_C,
+  RED_C
+};
+
+constexpr Common::EnumMap<s16, TevBias::Compare> s_BiasLUT{0, 128, -128, 0};
+constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleLShiftLUT{0, 1, 2, 0};
+constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleRShiftLUT{0, 0, 0, 1};
+
+s32 GetRounding(TevScale scale, TevOp op)
+{
+  return (scale == TevScale::Divide2) ? 0 : (op == TevOp::Sub) ? 127 : 128;
+}
+
+// The result is stored in an s16 register before it is clamped.
+s16 Clamp(s32 value, bool clamp)
+{
+  const s16 reg = static_cast<s16>(value);
+  return clamp ? std::clamp<s16>(reg, 0, 255) : std::clamp<s16>(reg, -1024, 1023);
+}
+}  // namespace
+
+s32 ColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType& input)
+{
+  const u16 c = input.c + (input.c >> 7);
+
+  s32 temp = input.a * (256 - c) + (input.b * c);
+  temp <<= s_ScaleLShiftLUT[cc.scale];
+  temp += GetRounding(cc.scale, cc.op);
+  temp >>= 8;
+  temp = cc.op == TevOp::Sub ? -temp : temp;
+
+  s32 result = ((input.d + s_BiasLUT[cc.bias]) << s_ScaleLShiftLUT[cc.scale]) + temp;
+  return result >> s_ScaleRShiftLUT[cc.scale];
+}
+
+s32 AlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType& input)
+{
+  const u16 c = input.c + (input.c >> 7);
+
+  s32 temp = input.a * (256 - c) + (input.b * c);
+  temp <<= s_ScaleLShiftLUT[ac.scale];
+  temp += GetRounding(ac.scale, ac.op);
+  temp = ac.op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
+
+  s32 result = ((input.d + s_BiasLUT[ac.bias]) << s_ScaleLShiftLUT[ac.scale]) + temp;
+  return result >> s_ScaleRShiftLUT[ac.scale];
+}
+
+Output CombineRegularScalar(const TevStageCombiner::ColorCombiner& cc,
+                            const TevStageCombiner::AlphaCombiner& ac, const Inputs& inputs)
+{
+  Output output;
+  output[ALP_C] = Clamp(AlphaRegular(ac, inputs[ALP_C]), ac.clamp);
+  for (int i = BLU_C; i <= RED_C; i++)
+    output[i] = Clamp(ColorRegular(cc, inputs[i]), cc.clamp);
+  return output;
+}
+
+#ifdef _M_X86_64
+FUNCTION_TARGET_SSR41
+Output CombineRegularSSE41(const TevStageCombiner::ColorCombiner& cc,
+                           const TevStageCombiner::AlphaCombiner& ac, const Inputs& inputs)
+{
+  // Lane 0 holds alpha, lanes 1-3 hold blue, green and red.
+  const __m128i a = _mm_setr_epi32(inputs[0].a, inputs[1].a, inputs[2].a, inputs[3].a);
+  const __m128i b = _mm_setr_epi32(inputs[0].b, inputs[1].b, inputs[2].b, inputs[3].b);
+  __m128i c = _mm_setr_epi32(inputs[0].c, inputs[1].c, inputs[2].c, inputs[3].c);
+  const __m128i d = _mm_setr_epi32(inputs[0].d, inputs[1].d, inputs[2].d, inputs[3].d);
+
+  // Per-lane combiner state. Left shifts are done as multiplications, since SSE4.1 has no
+  // per-lane shifts.
+  const s32 color_scale = 1 << s_ScaleLShiftLUT[cc.scale];
+  const s32 alpha_scale = 1 << s_ScaleLShiftLUT[ac.scale];
+  const __m128i scale = _mm_setr_epi32(alpha_scale, color_scale, color_scale, color_scale);
+  const s32 color_round = GetRounding(cc.scale, cc.op);
+  const s32 alpha_round = GetRounding(ac.scale, ac.op);
+  const __m128i round = _mm_setr_epi32(alpha_round, color_round, color_round, color_round);
+  const s32 color_bias = s_BiasLUT[cc.bias];
+  const s32 alpha_bias = s_BiasLUT[ac.bias];
+  const __m128i bias = _mm_setr_epi32(alpha_bias, color_bias, color_bias, color_bias);
+
+  // Alpha negates before the shift and color after it, which rounds differently.
+  const s32 alpha_sub = ac.op == TevOp::Sub ? -1 : 0;
+  const s32 color_sub = cc.op == TevOp::Sub ? -1 : 0;
+  const __m128i negate_before = _mm_setr_epi32(alpha_sub, 0, 0, 0);
+  const __m128i negate_after = _mm_setr_epi32(0, color_sub, color_sub, color_sub);
+
+  const s32 color_divide = cc.scale == TevScale::Divide2 ? -1 : 0;
+  const s32 alpha_divide = ac.scale == TevScale::Divide2 ? -1 : 0;
+  const __m128i divide = _mm_setr_epi32(alpha_divide, color_divide, color_divide, color_divide);
+
+  const s16 color_min = cc.clamp ? 0 : -1024;
+  const s16 color_max = cc.clamp ? 255 : 1023;
+  const s16 alpha_min = ac.clamp ? 0 : -1024;
+  const s16 alpha_max = ac.clamp ? 255 : 1023;
+  const __m128i clamp_min = _mm_setr_epi32(alpha_min, color_min, color_min, color_min);
+  const __m128i clamp_max = _mm_setr_epi32(alpha_max, color_max, color_max, color_max);
+
+  // temp = a * (256 - c) + b * c, with c expanded from 0..255 to 0..256
+  c = _mm_add_epi32(c, _mm_srli_epi32(c, 7));
+  __m128i temp = _mm_add_epi32(_mm_mullo_epi32(a, _mm_sub_epi32(_mm_set1_epi32(256), c)),
+                               _mm_mullo_epi32(b, c));
+  temp = _mm_add_epi32(_mm_mullo_epi32(temp, scale), round);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_before), negate_before);
+  temp = _mm_srai_epi32(temp, 8);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_after), negate_after);
+
+  __m128i result = _mm_add_epi32(_mm_mullo_epi32(_mm_add_epi32(d, bias), scale), temp);
+  result = _mm_blendv_epi8(result, _mm_srai_epi32(result, 1), divide);
+
+  // Store to s16 (truncating), then clamp
+  result = _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+  result = _mm_min_epi32(_mm_max_epi32(result, clamp_min), clamp_max);
+
+  Output output;
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(output.data()), _mm_packs_epi32(result, result));
+  return output;
+}
+#endif
+
+Output CombineRegular(const TevStageCombiner::ColorCombiner& cc,
+                      const TevStageCombiner::AlphaCombiner& ac, const Inputs& inputs)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bSSE4_1)
+    return CombineRegularSSE41(cc, ac, inputs);
+#endif
+  return CombineRegularScalar(cc, ac, inputs);
+}
+}  // namespace TevCombiner
@@ -0,0 +1,45 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
+
+// Arithmetic of a single TEV stage in its regular (non-compare) mode.
+// Channels are indexed in the same ABGR order as the color registers of Tev.
+namespace TevCombiner
+{
+struct InputRegType
+{
+  unsigned a : 8;
+  unsigned b : 8;
+  unsigned c : 8;
+  signed d : 11;
+};
+
+using Inputs = std::array<InputRegType, 4>;
+
+// Stage output, after the s16 register store and the clamp selected by the combiner.
+using Output = std::array<s16, 4>;
+
+// Unclamped result of a single channel.
+s32 ColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType& input);
+s32 AlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType& input);
+
+// Both combiners must be in regular mode, i.e. their bias must not be TevBias::Compare.
+Output CombineRegular(const TevStageCombiner::ColorCombiner& cc,
+                      const TevStageCombiner::AlphaCombiner& ac, const Inputs& inputs);
+
+// Reference implementation, also used when SSE4.1 is not available.
+Output CombineRegularScalar(const TevStageCombiner::ColorCombiner& cc,
+                            const TevStageCombiner::AlphaCombiner& ac, const Inputs& inputs);
+
+#ifdef _M_X86_64
+// Evaluates all four channels at once. Only call this if the CPU supports SSE4.1.
+Output CombineRegularSSE41(const TevStageCombiner::ColorCombiner& cc,
+                           const TevStageCombiner::AlphaCombiner& ac, const Inputs& inputs);
+#endif
+}  // namespace TevCombiner
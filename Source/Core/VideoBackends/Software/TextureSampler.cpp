@@ -5,8 +5,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
@@ -68,6 +70,53 @@ static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
   outTexel[3] += inTexel[3] * fract;
 }
 
+// Blends the 2x2 texel footprint of a bilinear sample, ordered (s, t), (s + 1, t), (s, t + 1),
+// (s + 1, t + 1). The fractions are in 0..127.
+static void BilinearFilter(const u8 (&texels)[4][4], int fractS, int fractT, u8* sample)
+{
+  const u32 weight0 = (128 - fractS) * (128 - fractT);
+  const u32 weight1 = fractS * (128 - fractT);
+  const u32 weight2 = (128 - fractS) * fractT;
+  const u32 weight3 = fractS * fractT;
+
+#ifdef _M_X86_64
+  // The weights are at most 128 * 128 and the texels are 8 bits, so interleaving two texels per
+  // 16-bit lane pair lets pmaddwd compute two terms of every channel at once.
+  u32 texel0, texel1, texel2, texel3;
+  std::memcpy(&texel0, texels[0], sizeof(u32));
+  std::memcpy(&texel1, texels[1], sizeof(u32));
+  std::memcpy(&texel2, texels[2], sizeof(u32));
+  std::memcpy(&texel3, texels[3], sizeof(u32));
+
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i texels01 = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(texel0), _mm_cvtsi32_si128(texel1)), zero);
+  const __m128i texels23 = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(texel2), _mm_cvtsi32_si128(texel3)), zero);
+  const __m128i weights01 = _mm_set1_epi32(static_cast<s32>(weight1 << 16 | weight0));
+  const __m128i weights23 = _mm_set1_epi32(static_cast<s32>(weight3 << 16 | weight2));
+
+  __m128i sum = _mm_add_epi32(_mm_madd_epi16(texels01, weights01),
+                              _mm_madd_epi16(texels23, weights23));
+  sum = _mm_srli_epi32(sum, 14);
+  sum = _mm_packus_epi16(_mm_packs_epi32(sum, zero), zero);
+
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(sum));
+  std::memcpy(sample, &result, sizeof(u32));
+#else
+  u32 texel[4];
+  SetTexel(texels[0], texel, weight0);
+  AddTexel(texels[1], texel, weight1);
+  AddTexel(texels[2], texel, weight2);
+  AddTexel(texels[3], texel, weight3);
+
+  sample[0] = (u8)(texel[0] >> 14);
+  sample[1] = (u8)(texel[1] >> 14);
+  sample[2] = (u8)(texel[2] >> 14);
+  sample[3] = (u8)(texel[3] >> 14);
+#endif
+}
+
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 {
   int baseMip = 0;
@@ -192,55 +241,36 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
-
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
     WrapCoord(&imageSPlus1, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageTPlus1, tm0.wrap_t, image_height_minus_1 + 1);
 
+    u8 texels[4][4];
     if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
     {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, image_width_minus_1, texfmt,
+      TexDecoder_DecodeTexel(texels[0], imageSrc, imageS, imageT, image_width_minus_1, texfmt,
                              tlut, tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, image_width_minus_1, texfmt,
+      TexDecoder_DecodeTexel(texels[1], imageSrc, imageSPlus1, imageT, image_width_minus_1, texfmt,
                              tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, image_width_minus_1, texfmt,
+      TexDecoder_DecodeTexel(texels[2], imageSrc, imageS, imageTPlus1, image_width_minus_1, texfmt,
                              tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, image_width_minus_1,
+      TexDecoder_DecodeTexel(texels[3], imageSrc, imageSPlus1, imageTPlus1, image_width_minus_1,
                              texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
     else
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(texels[0], imageSrc, imageSrcOdd, imageS, imageT,
                                           image_width_minus_1);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(texels[1], imageSrc, imageSrcOdd, imageSPlus1, imageT,
                                           image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(texels[2], imageSrc, imageSrcOdd, imageS, imageTPlus1,
                                           image_width_minus_1);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(texels[3], imageSrc, imageSrcOdd, imageSPlus1,
                                           imageTPlus1, image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
 
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    BilinearFilter(texels, fractS, fractT, sample);
   }
   else
   {
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/CPUCull.h"
 
+#include <cmath>
+
 #include "Common/Assert.h"
 #include "Common/CPUDetect.h"
 #include "Common/MathUtil.h"
@@ -120,6 +122,21 @@ static Common::EnumMap<CPUCull::CullFunction, CullMode::All> GetCullFunction1()
   };
 }
 
+template <OpcodeDecoder::Primitive Primitive>
+static CPUCull::LinePointCullFunction GetLinePointCullFunction()
+{
+#if defined(USE_SSE)
+  if (MIN_SSE >= 50 || cpu_info.bAVX)
+    return CPUCull_AVX::AreAllLinesOrPointsCulled<Primitive>;
+  else
+    return CPUCull_SSE::AreAllLinesOrPointsCulled<Primitive>;
+#elif defined(USE_NEON)
+  return CPUCull_NEON::AreAllLinesOrPointsCulled<Primitive>;
+#else
+  return CPUCull_Scalar::AreAllLinesOrPointsCulled<Primitive>;
+#endif
+}
+
 CPUCull::~CPUCull() = default;
 
 void CPUCull::Init()
@@ -134,13 +151,20 @@ void CPUCull::Init()
   m_cull_table[Prim::GX_DRAW_TRIANGLES] = GetCullFunction1<Prim::GX_DRAW_TRIANGLES>();
   m_cull_table[Prim::GX_DRAW_TRIANGLE_STRIP] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_STRIP>();
   m_cull_table[Prim::GX_DRAW_TRIANGLE_FAN] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_FAN>();
+  m_line_point_cull_table[0] = GetLinePointCullFunction<Prim::GX_DRAW_LINES>();
+  m_line_point_cull_table[1] = GetLinePointCullFunction<Prim::GX_DRAW_LINE_STRIP>();
+  m_line_point_cull_table[2] = GetLinePointCullFunction<Prim::GX_DRAW_POINTS>();
 }
 
 bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                                    const u8* src, u32 count)
 {
-  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
-             "CPUCull should not be called on lines or points");
+  const bool is_line_or_point = primitive >= OpcodeDecoder::Primitive::GX_DRAW_LINES;
+  const float viewport_wd = std::abs(xfmem.viewport.wd);
+  const float viewport_ht = std::abs(xfmem.viewport.ht);
+  if (is_line_or_point && (viewport_wd == 0.0f || viewport_ht == 0.0f))
+    return false;
+
   const u32 stride = loader->m_native_vtx_decl.stride;
   const bool posHas3Elems = loader->m_native_vtx_decl.position.components >= 3;
   const bool perVertexPosMtx = loader->m_native_vtx_decl.posmtx.enable;
@@ -155,14 +179,29 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
   // transform functions need the projection matrix to tranform to clip space
   Core::System::GetInstance().GetVertexShaderManager().SetProjectionMatrix();
 
+  const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
+  transform(m_transform_buffer.get(), src, stride, count);
+
+  if (is_line_or_point)
+  {
+    // Widen the clip planes by the line width or point size. Use the full size rather than half of
+    // it to also cover the aspect ratio adjustment, which doubles it along one axis.
+    const u32 size_sixths = primitive == OpcodeDecoder::Primitive::GX_DRAW_POINTS ?
+                                bpmem.lineptwidth.pointsize :
+                                bpmem.lineptwidth.linesize;
+    const float size = size_sixths / 6.0f;
+    const LinePointCullFunction cull =
+        m_line_point_cull_table[u32(primitive) - u32(OpcodeDecoder::Primitive::GX_DRAW_LINES)];
+    return cull(m_transform_buffer.get(), count, 1.0f + size / viewport_wd,
+                1.0f + size / viewport_ht);
+  }
+
   static constexpr Common::EnumMap<CullMode, CullMode::All> cullmode_invert = {
       CullMode::None, CullMode::Front, CullMode::Back, CullMode::All};
 
   CullMode cullmode = bpmem.genMode.cullmode;
   if (xfmem.viewport.ht > 0)  // See videosoftware Clipper.cpp:IsBackface
     cullmode = cullmode_invert[cullmode];
-  const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
-  transform(m_transform_buffer.get(), src, stride, count);
   const CullFunction cull = m_cull_table[primitive][cullmode];
   return cull(m_transform_buffer.get(), count);
 }
@@ -22,6 +22,7 @@ public:
 
   using TransformFunction = void (*)(void*, const void*, u32, int);
   using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int);
+  using LinePointCullFunction = bool (*)(const CPUCull::TransformedVertex*, int, float, float);
 
 private:
   template <typename T>
@@ -35,4 +36,6 @@ private:
   Common::EnumMap<Common::EnumMap<CullFunction, CullMode::All>,
                   OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
       m_cull_table{};
+  // Indexed by primitive - GX_DRAW_LINES
+  std::array<LinePointCullFunction, 3> m_line_point_cull_table{};
 };
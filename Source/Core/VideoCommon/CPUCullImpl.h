@@ -653,6 +653,86 @@ ATTR_TARGET DOLPHIN_FORCE_INLINE static bool CullTriangle(const CPUCull::Transfo
   return cull;
 }
 
+ATTR_TARGET DOLPHIN_FORCE_INLINE static Vector MakeClipScale(float scale_x, float scale_y)
+{
+#if defined(USE_SSE)
+  return _mm_setr_ps(scale_x, scale_y, INFINITY, INFINITY);
+#elif defined(USE_NEON)
+  return vsetr_f32(scale_x, scale_y, INFINITY, INFINITY);
+#else
+  return {scale_x, scale_y, INFINITY, INFINITY};
+#endif
+}
+
+// Returns one bit for each of the x/y clip planes the vertex is outside of, after the planes have
+// been moved outwards by scale.
+ATTR_TARGET DOLPHIN_FORCE_INLINE static u32 ClipOutcode(const CPUCull::TransformedVertex& v,
+                                                        Vector scale)
+{
+#if defined(USE_SSE)
+  Vector vv = reinterpret_cast<const Vector&>(v);
+  Vector limit = _mm_mul_ps(vector_broadcast<3>(vv), scale);
+  Vector neg_limit = _mm_xor_ps(limit, _mm_set1_ps(-0.0f));
+  u32 gt = _mm_movemask_ps(_mm_cmpgt_ps(vv, limit));
+  u32 lt = _mm_movemask_ps(_mm_cmplt_ps(vv, neg_limit));
+  return (gt & 3) | ((lt & 3) << 2);
+#elif defined(USE_NEON)
+  Vector vv = reinterpret_cast<const Vector&>(v);
+  Vector limit = vmulq_laneq_f32(scale, vv, 3);
+  uint32x4_t gt = vcgtq_f32(vv, limit);
+  uint32x4_t lt = vcltq_f32(vv, vnegq_f32(limit));
+  return (vgetq_lane_u32(gt, 0) & 1) | (vgetq_lane_u32(gt, 1) & 2) | (vgetq_lane_u32(lt, 0) & 4) |
+         (vgetq_lane_u32(lt, 1) & 8);
+#else
+  float limit_x = v.w * scale.x;
+  float limit_y = v.w * scale.y;
+  return u32(v.x > limit_x) | (u32(v.y > limit_y) << 1) | (u32(v.x < -limit_x) << 2) |
+         (u32(v.y < -limit_y) << 3);
+#endif
+}
+
+// Lines and points are expanded in screen space, so there's no facing to cull by. They can only be
+// culled when they're entirely outside one of the (widened) clip planes.
+template <OpcodeDecoder::Primitive Primitive>
+ATTR_TARGET static bool AreAllLinesOrPointsCulled(const CPUCull::TransformedVertex* transformed,
+                                                  int count, float scale_x, float scale_y)
+{
+  Vector scale = MakeClipScale(scale_x, scale_y);
+  switch (Primitive)
+  {
+  case OpcodeDecoder::Primitive::GX_DRAW_LINES:
+    for (int i = 1; i < count; i += 2)
+    {
+      if (!(ClipOutcode(transformed[i - 1], scale) & ClipOutcode(transformed[i], scale)))
+        return false;
+    }
+    break;
+  case OpcodeDecoder::Primitive::GX_DRAW_LINE_STRIP:
+  {
+    u32 previous = ClipOutcode(transformed[0], scale);
+    for (int i = 1; i < count; ++i)
+    {
+      u32 current = ClipOutcode(transformed[i], scale);
+      if (!(previous & current))
+        return false;
+      previous = current;
+    }
+    break;
+  }
+  case OpcodeDecoder::Primitive::GX_DRAW_POINTS:
+    for (int i = 0; i < count; ++i)
+    {
+      if (!ClipOutcode(transformed[i], scale))
+        return false;
+    }
+    break;
+  default:
+    break;
+  }
+
+  return true;
+}
+
 template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
 ATTR_TARGET static bool AreAllVerticesCulled(const CPUCull::TransformedVertex* transformed,
                                              int count)
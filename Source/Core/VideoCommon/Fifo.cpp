@@ -4,7 +4,9 @@
 #include "VideoCommon/Fifo.h"
 
 #include <atomic>
+#include <chrono>
 #include <cstring>
+#include <thread>
 
 #include "Common/Assert.h"
 #include "Common/BlockingLoop.h"
@@ -13,6 +15,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Thread.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -36,6 +39,13 @@ namespace Fifo
 {
 static constexpr int GPU_TIME_SLOT_SIZE = 1000;
 
+static u64 NanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              start)
+      .count();
+}
+
 FifoManager::FifoManager() = default;
 FifoManager::~FifoManager() = default;
 
@@ -54,7 +64,7 @@ void FifoManager::DoState(PointerWrap& p)
   p.DoPointer(write_ptr, m_video_buffer);
   m_video_buffer_write_ptr = write_ptr;
   p.DoPointer(m_video_buffer_read_ptr, m_video_buffer);
-  if (p.IsReadMode() && m_use_deterministic_gpu_thread)
+  if (p.IsReadMode() && (m_use_deterministic_gpu_thread || m_use_pipelined_gpu_thread))
   {
     // We're good and paused, right?
     m_video_buffer_seen_ptr = m_video_buffer_pp_read_ptr = m_video_buffer_read_ptr;
@@ -74,6 +84,8 @@ void FifoManager::PauseAndLock(Core::System& system, bool doLock, bool unpauseOn
     if (!system.IsDualCoreMode() || m_use_deterministic_gpu_thread)
       return;
 
+    if (m_use_pipelined_gpu_thread)
+      m_decode_loop.WaitYield(std::chrono::milliseconds(100), Host_YieldToUI);
     m_gpu_mainloop.WaitYield(std::chrono::milliseconds(100), Host_YieldToUI);
   }
   else
@@ -92,8 +104,12 @@ void FifoManager::Init(Core::System& system)
   // Padded so that SIMD overreads in the vertex loader are safe
   m_video_buffer = static_cast<u8*>(Common::AllocateMemoryPages(FIFO_SIZE + 4));
   ResetVideoBuffer();
+  m_config_gpu_pipelining = system.IsDualCoreMode() && Config::Get(Config::MAIN_GPU_PIPELINING);
+  m_use_pipelined_gpu_thread = m_config_gpu_pipelining && !m_use_deterministic_gpu_thread;
   if (system.IsDualCoreMode())
     m_gpu_mainloop.Prepare();
+  if (m_config_gpu_pipelining)
+    m_decode_loop.Prepare();
   m_sync_ticks.store(0);
 }
 
@@ -131,6 +147,7 @@ void FifoManager::ExitGpuLoop(Core::System& system)
 
   // Terminate GPU thread loop
   m_emu_running_state.Set();
+  m_decode_loop.Stop(Common::BlockingLoop::StopMode::NonBlock);
   m_gpu_mainloop.Stop(Common::BlockingLoop::StopMode::NonBlock);
 }
 
@@ -138,9 +155,15 @@ void FifoManager::EmulatorState(bool running)
 {
   m_emu_running_state.Set(running);
   if (running)
+  {
+    m_decode_loop.Wakeup();
     m_gpu_mainloop.Wakeup();
+  }
   else
+  {
+    m_decode_loop.AllowSleep();
     m_gpu_mainloop.AllowSleep();
+  }
 }
 
 void FifoManager::SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
@@ -163,24 +186,28 @@ void FifoManager::SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
     m_fifo_aux_read_ptr = m_fifo_aux_data;
 
     if (may_move_read_ptr)
-    {
-      u8* write_ptr = m_video_buffer_write_ptr;
-
-      // what's left over in the buffer
-      size_t size = write_ptr - m_video_buffer_pp_read_ptr;
-
-      memmove(m_video_buffer, m_video_buffer_pp_read_ptr, size);
-      // This change always decreases the pointers.  We write seen_ptr
-      // after write_ptr here, and read it before in RunGpuLoop, so
-      // 'write_ptr > seen_ptr' there cannot become spuriously true.
-      m_video_buffer_write_ptr = write_ptr = m_video_buffer + size;
-      m_video_buffer_pp_read_ptr = m_video_buffer;
-      m_video_buffer_read_ptr = m_video_buffer;
-      m_video_buffer_seen_ptr = write_ptr;
-    }
+      MoveVideoBufferTailToStart();
   }
 }
 
+// Must only be called while the GPU thread is idle.
+void FifoManager::MoveVideoBufferTailToStart()
+{
+  u8* write_ptr = m_video_buffer_write_ptr;
+
+  // what's left over in the buffer
+  size_t size = write_ptr - m_video_buffer_pp_read_ptr;
+
+  memmove(m_video_buffer, m_video_buffer_pp_read_ptr, size);
+  // This change always decreases the pointers.  We write seen_ptr
+  // after write_ptr here, and read it before in RunGpuLoop, so
+  // 'write_ptr > seen_ptr' there cannot become spuriously true.
+  m_video_buffer_write_ptr = write_ptr = m_video_buffer + size;
+  m_video_buffer_pp_read_ptr = m_video_buffer;
+  m_video_buffer_read_ptr = m_video_buffer;
+  m_video_buffer_seen_ptr = write_ptr;
+}
+
 void FifoManager::PushFifoAuxBuffer(const void* ptr, size_t size)
 {
   if (size > (size_t)(m_fifo_aux_data + FIFO_SIZE - m_fifo_aux_write_ptr))
@@ -272,6 +299,13 @@ void FifoManager::ReadDataFromFifoOnCPU(Core::System& system, u32 readPtr)
 
 void FifoManager::ResetVideoBuffer()
 {
+  // In pipelined mode this runs on the GPU thread, so keep the decode thread out while the buffer
+  // is thrown away. Batches which weren't executed yet are dropped with it; as their chunks were
+  // never retired, the CP registers still point at them.
+  std::lock_guard lk(m_decode_lock);
+  m_pipeline_read_index.store(m_pipeline_write_index.load());
+  m_pipeline_pending_chunks.store(0);
+
   m_video_buffer_read_ptr = m_video_buffer;
   m_video_buffer_write_ptr = m_video_buffer;
   m_video_buffer_seen_ptr = m_video_buffer;
@@ -287,11 +321,40 @@ void FifoManager::RunGpuLoop(Core::System& system)
   AsyncRequests::GetInstance()->SetEnable(true);
   AsyncRequests::GetInstance()->SetPassthrough(false);
 
+  std::thread decode_thread;
+  if (m_config_gpu_pipelining)
+    decode_thread = std::thread(&FifoManager::RunDecodeLoop, this, std::ref(system));
+
   m_gpu_mainloop.Run(
       [this, &system] {
         // Run events from the CPU thread.
         AsyncRequests::GetInstance()->PullEvents();
 
+        if (m_use_pipelined_gpu_thread)
+        {
+          // The decode thread reads the FIFO. What it has decoded is executed even while paused, so
+          // that pausing leaves no decoded but unexecuted commands behind.
+          if (m_emu_running_state.IsSet())
+            system.GetCommandProcessor().SetCPStatusFromGPU(system);
+          ExecutePipelineBatches(system);
+
+          if (m_pipeline_read_index.load() == m_pipeline_write_index.load() &&
+              m_decode_idle.load())
+          {
+            // Both stages are idle, see below.
+            if (m_sync_ticks.load() > 0)
+            {
+              int old = m_sync_ticks.exchange(0);
+              if (old >= m_config_sync_gpu_max_distance)
+                m_sync_wakeup_event.Set();
+            }
+
+            g_vertex_manager->Flush();
+            g_framebuffer_manager->RefreshPeekCache();
+          }
+          return;
+        }
+
         // Do nothing while paused
         if (!m_emu_running_state.IsSet())
           return;
@@ -388,20 +451,249 @@ void FifoManager::RunGpuLoop(Core::System& system)
       },
       100);
 
+  if (decode_thread.joinable())
+  {
+    m_decode_loop.Stop();
+    decode_thread.join();
+  }
+
   AsyncRequests::GetInstance()->SetEnable(false);
   AsyncRequests::GetInstance()->SetPassthrough(true);
 }
 
+void FifoManager::RunDecodeLoop(Core::System& system)
+{
+  Common::SetCurrentThreadName("Video Decode");
+
+  m_decode_loop.Run(
+      [this, &system] {
+        // Do nothing while paused, or while the CPU thread feeds the GPU thread directly
+        if (!m_emu_running_state.IsSet() || !m_use_pipelined_gpu_thread)
+          return;
+
+        RunDecodeStage(system);
+      },
+      100);
+}
+
+// Does the FIFO handling of the non-pipelined loop in RunGpuLoop, but only decodes the commands
+// and hands them to the GPU thread in batches. The CP registers and the SyncGPU cycle accounting
+// are only updated by the GPU thread once it has executed a chunk, so the CPU never sees FIFO data
+// as read before it took effect.
+// This never waits for the GPU thread: whenever the decode stage has to let it catch up, it returns
+// and is woken up again as the GPU thread retires a batch.
+void FifoManager::RunDecodeStage(Core::System& system)
+{
+  std::lock_guard lk(m_decode_lock);
+  m_decode_idle.store(false);
+
+  auto& command_processor = system.GetCommandProcessor();
+  auto& fifo = command_processor.GetFifo();
+  auto& memory = system.GetMemory();
+
+  // With SyncGPU, the cycle budget has to be checked against executed chunks, so only decode one
+  // chunk at a time, like the non-pipelined loop reads them.
+  const u32 batch_chunks = m_config_sync_gpu ? 1 : PIPELINE_BATCH_CHUNKS;
+  const u32 max_pending_chunks = m_config_sync_gpu ? 1 : PIPELINE_BATCH_CHUNKS * PIPELINE_BATCHES;
+
+  PipelineBatch* batch = nullptr;
+  while (true)
+  {
+    const u32 pending_chunks = m_pipeline_pending_chunks.load();
+    if (pending_chunks == 0)
+    {
+      // Everything decoded so far was retired, so the CP registers are up to date.
+      m_decode_read_pointer = fifo.CPReadPointer.load(std::memory_order_relaxed);
+      m_decode_waits_for_drain = false;
+    }
+    else if (m_decode_waits_for_drain || pending_chunks >= max_pending_chunks)
+    {
+      break;
+    }
+
+    const s32 distance =
+        static_cast<s32>(fifo.CPReadWriteDistance.load(std::memory_order_relaxed)) -
+        static_cast<s32>(pending_chunks * GPFifo::GATHER_PIPE_SIZE);
+    if (command_processor.IsInterruptWaiting() ||
+        !fifo.bFF_GPReadEnable.load(std::memory_order_relaxed) || distance <= 0 ||
+        (fifo.bFF_BPEnable.load(std::memory_order_relaxed) &&
+         m_decode_read_pointer == fifo.CPBreakpoint.load(std::memory_order_relaxed)))
+    {
+      break;
+    }
+
+    if (m_config_sync_gpu && m_sync_ticks.load() < m_config_sync_gpu_min_distance)
+      break;
+
+    if (GPFifo::GATHER_PIPE_SIZE >
+        static_cast<size_t>(m_video_buffer + FIFO_SIZE - m_video_buffer_write_ptr))
+    {
+      // The incomplete command at the end of the buffer can only be moved back to the start once
+      // the GPU thread is done with everything before it.
+      if (pending_chunks != 0)
+        break;
+
+      MoveVideoBufferTailToStart();
+      if (GPFifo::GATHER_PIPE_SIZE >
+          static_cast<size_t>(m_video_buffer + FIFO_SIZE - m_video_buffer_write_ptr))
+      {
+        PanicAlertFmt("FIFO out of bounds (existing {} + new {} > {})",
+                      m_video_buffer_write_ptr - m_video_buffer, GPFifo::GATHER_PIPE_SIZE,
+                      FIFO_SIZE);
+        break;
+      }
+    }
+
+    if (batch == nullptr)
+    {
+      const u32 write_index = m_pipeline_write_index.load();
+      if (write_index - m_pipeline_read_index.load() >= PIPELINE_BATCHES)
+        break;
+
+      batch = &m_pipeline_batches[write_index % PIPELINE_BATCHES];
+      batch->decoded.commands.clear();
+      batch->decoded.display_lists.clear();
+      batch->chunks.clear();
+      batch->signals_cpu = false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    u8* write_ptr = m_video_buffer_write_ptr;
+    memory.CopyFromEmu(write_ptr, m_decode_read_pointer, GPFifo::GATHER_PIPE_SIZE);
+    write_ptr += GPFifo::GATHER_PIPE_SIZE;
+    m_video_buffer_write_ptr = write_ptr;
+
+    if (m_decode_read_pointer == fifo.CPEnd.load(std::memory_order_relaxed))
+      m_decode_read_pointer = fifo.CPBase.load(std::memory_order_relaxed);
+    else
+      m_decode_read_pointer += GPFifo::GATHER_PIPE_SIZE;
+
+    m_video_buffer_pp_read_ptr =
+        OpcodeDecoder::Decode(DataReader(m_video_buffer_pp_read_ptr, write_ptr), &batch->decoded,
+                              &batch->signals_cpu);
+    batch->chunks.push_back({batch->decoded.commands.size(), m_decode_read_pointer,
+                             m_video_buffer_pp_read_ptr, m_video_buffer_pp_read_ptr == write_ptr});
+    m_pipeline_pending_chunks.fetch_add(1);
+
+    m_decode_busy_ns.fetch_add(NanosecondsSince(start), std::memory_order_relaxed);
+
+    // Tokens and finish flags must reach the CPU before more of the FIFO is read, as that is what
+    // the interrupt check above relies on.
+    if (batch->signals_cpu)
+      m_decode_waits_for_drain = true;
+
+    if (batch->signals_cpu || batch->chunks.size() >= batch_chunks)
+    {
+      PublishPipelineBatch();
+      batch = nullptr;
+    }
+  }
+
+  if (batch != nullptr && !batch->chunks.empty())
+    PublishPipelineBatch();
+
+  m_decode_idle.store(true);
+  m_gpu_mainloop.Wakeup();
+}
+
+void FifoManager::PublishPipelineBatch()
+{
+  m_pipeline_write_index.fetch_add(1);
+  m_gpu_mainloop.Wakeup();
+}
+
+// Executes the batches published by the decode stage on the GPU thread, and retires each chunk of
+// the FIFO like the non-pipelined loop does once it has run the commands completed by it.
+void FifoManager::ExecutePipelineBatches(Core::System& system)
+{
+  auto& command_processor = system.GetCommandProcessor();
+  auto& fifo = command_processor.GetFifo();
+
+  u32 read_index = m_pipeline_read_index.load();
+  while (read_index != m_pipeline_write_index.load())
+  {
+    const auto start = std::chrono::steady_clock::now();
+
+    const PipelineBatch& batch = m_pipeline_batches[read_index % PIPELINE_BATCHES];
+    size_t command_begin = 0;
+    for (const PipelineChunk& chunk : batch.chunks)
+    {
+      u32 cycles_executed = 0;
+      OpcodeDecoder::ExecuteDecoded(batch.decoded, command_begin, chunk.command_end,
+                                    &cycles_executed);
+      command_begin = chunk.command_end;
+      m_video_buffer_read_ptr = chunk.video_buffer_read_ptr;
+
+      fifo.CPReadPointer.store(chunk.read_pointer, std::memory_order_relaxed);
+      fifo.CPReadWriteDistance.fetch_sub(GPFifo::GATHER_PIPE_SIZE, std::memory_order_seq_cst);
+      if (chunk.video_buffer_empty)
+        fifo.SafeCPReadPointer.store(chunk.read_pointer, std::memory_order_relaxed);
+
+      command_processor.SetCPStatusFromGPU(system);
+
+      if (m_config_sync_gpu)
+      {
+        cycles_executed = (int)(cycles_executed / m_config_sync_gpu_overclock);
+        int old = m_sync_ticks.fetch_sub(cycles_executed);
+        if (old >= m_config_sync_gpu_max_distance &&
+            old - (int)cycles_executed < m_config_sync_gpu_max_distance)
+        {
+          m_sync_wakeup_event.Set();
+        }
+      }
+
+      // Only once the registers are updated, so that the decode stage never reads the FIFO further
+      // than the CPU has written it.
+      m_pipeline_pending_chunks.fetch_sub(1);
+    }
+
+    m_pipeline_read_index.store(++read_index);
+    m_submit_busy_ns.fetch_add(NanosecondsSince(start), std::memory_order_relaxed);
+
+    // The decode stage may have stopped to let us catch up.
+    m_decode_loop.Wakeup();
+
+    // See the non-pipelined loop. A FIFO reset in here drops the remaining batches.
+    AsyncRequests::GetInstance()->PullEvents();
+    read_index = m_pipeline_read_index.load();
+  }
+}
+
+PipelineOccupancy FifoManager::GetPipelineOccupancy()
+{
+  const auto now = std::chrono::steady_clock::now();
+  const u64 decode_ns = m_decode_busy_ns.load(std::memory_order_relaxed);
+  const u64 submit_ns = m_submit_busy_ns.load(std::memory_order_relaxed);
+  const double elapsed_ns =
+      std::chrono::duration<double, std::nano>(now - m_occupancy_time).count();
+
+  PipelineOccupancy occupancy;
+  if (elapsed_ns > 0.0)
+  {
+    occupancy.decode = static_cast<float>((decode_ns - m_occupancy_decode_ns) / elapsed_ns);
+    occupancy.submit = static_cast<float>((submit_ns - m_occupancy_submit_ns) / elapsed_ns);
+  }
+
+  m_occupancy_time = now;
+  m_occupancy_decode_ns = decode_ns;
+  m_occupancy_submit_ns = submit_ns;
+  return occupancy;
+}
+
 void FifoManager::FlushGpu(Core::System& system)
 {
   if (!system.IsDualCoreMode() || m_use_deterministic_gpu_thread)
     return;
 
+  if (m_use_pipelined_gpu_thread)
+    m_decode_loop.Wait();
   m_gpu_mainloop.Wait();
 }
 
 void FifoManager::GpuMaySleep()
 {
+  m_decode_loop.AllowSleep();
   m_gpu_mainloop.AllowSleep();
 }
 
@@ -421,6 +713,8 @@ void FifoManager::RunGpu(Core::System& system)
   // wake up GPU thread
   if (is_dual_core && !m_use_deterministic_gpu_thread)
   {
+    if (m_use_pipelined_gpu_thread)
+      m_decode_loop.Wakeup();
     m_gpu_mainloop.Wakeup();
   }
 
@@ -521,7 +815,8 @@ void FifoManager::UpdateWantDeterminism(Core::System& system, bool want)
   if (m_use_deterministic_gpu_thread != gpu_thread)
   {
     m_use_deterministic_gpu_thread = gpu_thread;
-    if (gpu_thread)
+    m_use_pipelined_gpu_thread = m_config_gpu_pipelining && !gpu_thread;
+    if (gpu_thread || m_use_pipelined_gpu_thread)
     {
       // These haven't been updated in non-deterministic mode.
       m_video_buffer_seen_ptr = m_video_buffer_pp_read_ptr = m_video_buffer_read_ptr;
@@ -542,8 +837,11 @@ int FifoManager::WaitForGpuThread(Core::System& system, int ticks)
   int now = old + ticks;
 
   // GPU is idle, so stop polling.
-  if (old >= 0 && m_gpu_mainloop.IsDone())
+  if (old >= 0 && m_gpu_mainloop.IsDone() &&
+      (!m_use_pipelined_gpu_thread || m_decode_loop.IsDone()))
+  {
     return -1;
+  }
 
   // Wakeup GPU
   if (old < m_config_sync_gpu_min_distance && now >= m_config_sync_gpu_min_distance)
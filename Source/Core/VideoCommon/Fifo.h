@@ -3,14 +3,19 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 #include "Common/BlockingLoop.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
+#include "VideoCommon/OpcodeDecoding.h"
 
 class PointerWrap;
 
@@ -37,6 +42,13 @@ enum class SyncGPUReason
   AuxSpace,
 };
 
+// Fraction of wall time each stage of the pipelined GPU thread spent working.
+struct PipelineOccupancy
+{
+  float decode = 0.0f;
+  float submit = 0.0f;
+};
+
 class FifoManager final
 {
 public:
@@ -56,6 +68,13 @@ public:
   bool UseDeterministicGPUThread() const { return m_use_deterministic_gpu_thread; }
   bool UseSyncGPU() const { return m_config_sync_gpu; }
 
+  // In pipelined mode, a decode thread reads the FIFO, parses it and creates vertex loaders ahead
+  // of the GPU thread, which then only executes the decoded commands and retires the FIFO data
+  // they came from. Not used in deterministic mode.
+  bool UsePipelinedGPUThread() const { return m_use_pipelined_gpu_thread; }
+  // Returns the stage occupancy since the previous call.
+  PipelineOccupancy GetPipelineOccupancy();
+
   // In deterministic GPU thread mode this waits for the GPU to be done with pending work.
   void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr = true);
 
@@ -78,13 +97,23 @@ private:
   void RefreshConfig();
   void ReadDataFromFifo(Core::System& system, u32 readPtr);
   void ReadDataFromFifoOnCPU(Core::System& system, u32 readPtr);
+  void MoveVideoBufferTailToStart();
+  void RunDecodeLoop(Core::System& system);
+  void RunDecodeStage(Core::System& system);
+  void PublishPipelineBatch();
+  void ExecutePipelineBatches(Core::System& system);
   int RunGpuOnCpu(Core::System& system, int ticks);
   int WaitForGpuThread(Core::System& system, int ticks);
   static void SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLate);
 
   static constexpr u32 FIFO_SIZE = 2 * 1024 * 1024;
+  // The decode stage hands the GPU thread batches of up to PIPELINE_BATCH_CHUNKS gather pipe
+  // sized chunks of the FIFO, through a ring of PIPELINE_BATCHES batches.
+  static constexpr u32 PIPELINE_BATCH_CHUNKS = 32;
+  static constexpr u32 PIPELINE_BATCHES = 128;
 
   Common::BlockingLoop m_gpu_mainloop;
+  Common::BlockingLoop m_decode_loop;
 
   Common::Flag m_emu_running_state;
 
@@ -96,6 +125,44 @@ private:
   // This could be in SConfig, but it depends on multiple settings
   // and can change at runtime.
   bool m_use_deterministic_gpu_thread = false;
+  bool m_use_pipelined_gpu_thread = false;
+  // Only read on boot, as the decode thread is started along with the GPU thread.
+  bool m_config_gpu_pipelining = false;
+
+  // A chunk of the FIFO in a pipeline batch. Once the GPU thread has executed the commands before
+  // command_end, it updates the CP registers as if it had just read the chunk.
+  struct PipelineChunk
+  {
+    size_t command_end;
+    u32 read_pointer;
+    u8* video_buffer_read_ptr;
+    bool video_buffer_empty;
+  };
+  struct PipelineBatch
+  {
+    OpcodeDecoder::DecodedBatch decoded;
+    std::vector<PipelineChunk> chunks;
+    bool signals_cpu = false;
+  };
+
+  // Written by the decode thread, except that batches published before a FIFO reset are dropped by
+  // the GPU thread under m_decode_lock.
+  std::array<PipelineBatch, PIPELINE_BATCHES> m_pipeline_batches;
+  std::atomic<u32> m_pipeline_write_index = 0;
+  std::atomic<u32> m_pipeline_read_index = 0;
+  // Chunks which were decoded but not retired yet, so are still counted by CPReadWriteDistance.
+  std::atomic<u32> m_pipeline_pending_chunks = 0;
+  std::mutex m_decode_lock;
+  std::atomic<bool> m_decode_idle = true;
+  // Owned by the decode thread.
+  u32 m_decode_read_pointer = 0;
+  bool m_decode_waits_for_drain = false;
+
+  std::atomic<u64> m_decode_busy_ns = 0;
+  std::atomic<u64> m_submit_busy_ns = 0;
+  std::chrono::steady_clock::time_point m_occupancy_time;
+  u64 m_occupancy_decode_ns = 0;
+  u64 m_occupancy_submit_ns = 0;
 
   CoreTiming::EventType* m_event_sync_gpu = nullptr;
 
@@ -116,6 +183,9 @@ private:
   // FIFO.  Maybe someday it will be under the lock.  For now, because RunGpuLoop
   // polls, it's just atomic.
   // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
+  // In pipelined mode, the decode thread owns the write_ptr and the pp_read_ptr, and the GPU thread
+  // moves the read_ptr as it retires the chunks of the FIFO. The decode thread only moves the data
+  // back to the start of the buffer once everything it decoded has been retired.
 
   std::atomic<int> m_sync_ticks = 0;
   bool m_syncing_suspended = false;
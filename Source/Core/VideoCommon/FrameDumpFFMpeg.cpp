@@ -10,6 +10,8 @@
 #include <array>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -23,14 +25,18 @@ extern "C" {
 #include <libavutil/opt.h>
 #include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
+#include <libswscale/version.h>
 }
 
 #include "Common/ChunkFile.h"
+#include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/Logging/LogManager.h"
 #include "Common/MsgHandler.h"
+#include "Common/SPSCQueue.h"
 #include "Common/StringUtil.h"
+#include "Common/WorkQueueThread.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -48,8 +54,17 @@ struct FrameDumpContext
   AVStream* stream = nullptr;
   AVCodecContext* codec = nullptr;
   AVFrame* src_frame = nullptr;
-  AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
+  int sws_src_width = 0;
+  int sws_src_height = 0;
+
+  // Converted frames are encoded on a separate thread. Each one is either free, or queued for or
+  // being encoded. When all are in use, conversion waits for the encoder.
+  std::vector<AVFrame*> scaled_frames;
+  Common::SPSCQueue<AVFrame*, false> free_scaled_frames;
+  AVFrame* unused_scaled_frame = nullptr;
+  Common::Event scaled_frame_released;
+  Common::WorkQueueThread<AVFrame*> encode_thread;
 
   s64 last_pts = AV_NOPTS_VALUE;
 
@@ -64,6 +79,8 @@ struct FrameDumpContext
 
 namespace
 {
+constexpr size_t NUM_SCALED_FRAMES = 4;
+
 AVRational GetTimeBaseForCurrentRefreshRate()
 {
   auto& vi = Core::System::GetInstance().GetVideoInterface();
@@ -123,7 +140,15 @@ void InitAVCodec()
 std::string GetDumpPath(const std::string& extension, std::time_t time, u32 index)
 {
   if (!g_Config.sDumpPath.empty())
-    return g_Config.sDumpPath;
+  {
+    if (index == 0)
+      return g_Config.sDumpPath;
+
+    // Don't overwrite the first file when the dump is restarted, e.g. on a resolution change.
+    std::string directory, name, file_extension;
+    SplitPath(g_Config.sDumpPath, &directory, &name, &file_extension);
+    return fmt::format("{}{}_{}{}", directory, name, index, file_extension);
+  }
 
   const std::string path_prefix =
       File::GetUserPath(D_DUMPFRAMES_IDX) + SConfig::GetInstance().GetGameID();
@@ -300,14 +325,22 @@ bool FFMpegFrameDump::CreateVideoFile()
   }
 
   m_context->src_frame = av_frame_alloc();
-  m_context->scaled_frame = av_frame_alloc();
-
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
-  m_context->scaled_frame->width = m_context->width;
-  m_context->scaled_frame->height = m_context->height;
 
-  if (av_frame_get_buffer(m_context->scaled_frame, 1))
-    return false;
+  for (size_t i = 0; i < NUM_SCALED_FRAMES; i++)
+  {
+    AVFrame* const scaled_frame = av_frame_alloc();
+    if (!scaled_frame)
+      return false;
+    m_context->scaled_frames.push_back(scaled_frame);
+
+    scaled_frame->format = m_context->codec->pix_fmt;
+    scaled_frame->width = m_context->width;
+    scaled_frame->height = m_context->height;
+
+    if (av_frame_get_buffer(scaled_frame, 1))
+      return false;
+    m_context->free_scaled_frames.Push(scaled_frame);
+  }
 
   m_context->stream = avformat_new_stream(m_context->format, codec);
   if (!m_context->stream ||
@@ -333,6 +366,9 @@ bool FFMpegFrameDump::CreateVideoFile()
                  m_context->stream->time_base.num);
   }
 
+  m_context->encode_thread.Reset("FrameDumpEncoder",
+                                 [this](AVFrame* frame) { EncodeFrame(frame); });
+
   OSD::AddMessage(fmt::format("Dumping Frames to \"{}\" ({}x{})", dump_path, m_context->width,
                               m_context->height));
   return true;
@@ -375,34 +411,106 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
     }
   }
 
-  constexpr AVPixelFormat pix_fmt = AV_PIX_FMT_RGBA;
+  AVFrame* const scaled_frame = AcquireScaledFrame();
+
+  // The encoder may still reference the buffers of a frame it was given earlier.
+  if (const int error = av_frame_make_writable(scaled_frame))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not make frame writable: {}", AVErrorString(error));
+    m_context->unused_scaled_frame = scaled_frame;
+    return;
+  }
 
   m_context->src_frame->data[0] = const_cast<u8*>(frame.data);
   m_context->src_frame->linesize[0] = frame.stride;
-  m_context->src_frame->format = pix_fmt;
-  m_context->src_frame->width = m_context->width;
-  m_context->src_frame->height = m_context->height;
+  m_context->src_frame->format = AV_PIX_FMT_RGBA;
+  m_context->src_frame->width = frame.width;
+  m_context->src_frame->height = frame.height;
 
   // Convert image from RGBA to desired pixel format.
-  m_context->sws = sws_getCachedContext(
-      m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (m_context->sws)
+  if (UpdateScaler(frame.width, frame.height))
   {
+#if LIBSWSCALE_VERSION_INT >= AV_VERSION_INT(6, 1, 100)
+    // Unlike sws_scale(), this splits the conversion into slices across the scaler's threads.
+    if (const int error = sws_scale_frame(m_context->sws, scaled_frame, m_context->src_frame);
+        error < 0)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not convert frame: {}", AVErrorString(error));
+    }
+#else
     sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+              frame.height, scaled_frame->data, scaled_frame->linesize);
+#endif
   }
 
   m_context->last_pts = pts;
-  m_context->scaled_frame->pts = pts;
+  scaled_frame->pts = pts;
+
+  // The source frame is no longer needed, so the caller can reuse it while this one is encoded.
+  m_context->encode_thread.Push(scaled_frame);
+}
+
+AVFrame* FFMpegFrameDump::AcquireScaledFrame()
+{
+  if (m_context->unused_scaled_frame)
+    return std::exchange(m_context->unused_scaled_frame, nullptr);
+
+  AVFrame* frame;
+  while (!m_context->free_scaled_frames.Pop(frame))
+    m_context->scaled_frame_released.Wait();
+  return frame;
+}
 
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
+bool FFMpegFrameDump::UpdateScaler(int src_width, int src_height)
+{
+  if (m_context->sws && m_context->sws_src_width == src_width &&
+      m_context->sws_src_height == src_height)
   {
-    ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
-    return;
+    return true;
   }
 
-  ProcessPackets();
+  if (m_context->sws)
+    sws_freeContext(m_context->sws);
+
+  m_context->sws = sws_alloc_context();
+  m_context->sws_src_width = src_width;
+  m_context->sws_src_height = src_height;
+  if (!m_context->sws)
+    return false;
+
+  SwsContext* const sws = m_context->sws;
+  av_opt_set_int(sws, "srcw", src_width, 0);
+  av_opt_set_int(sws, "srch", src_height, 0);
+  av_opt_set_int(sws, "src_format", AV_PIX_FMT_RGBA, 0);
+  av_opt_set_int(sws, "dstw", m_context->width, 0);
+  av_opt_set_int(sws, "dsth", m_context->height, 0);
+  av_opt_set_int(sws, "dst_format", m_context->codec->pix_fmt, 0);
+  av_opt_set_int(sws, "sws_flags", SWS_BICUBIC, 0);
+#if LIBSWSCALE_VERSION_INT >= AV_VERSION_INT(6, 1, 100)
+  // Slice threading with one thread per core. This only applies to sws_scale_frame().
+  av_opt_set_int(sws, "threads", 0, 0);
+#endif
+
+  if (sws_init_context(sws, nullptr, nullptr) < 0)
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not initialize the color converter");
+    sws_freeContext(sws);
+    m_context->sws = nullptr;
+    return false;
+  }
+
+  return true;
+}
+
+void FFMpegFrameDump::EncodeFrame(AVFrame* frame)
+{
+  if (const int error = avcodec_send_frame(m_context->codec, frame))
+    ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
+  else
+    ProcessPackets();
+
+  m_context->free_scaled_frames.Push(frame);
+  m_context->scaled_frame_released.Set();
 }
 
 void FFMpegFrameDump::ProcessPackets()
@@ -448,6 +556,9 @@ void FFMpegFrameDump::Stop()
   if (!IsStarted())
     return;
 
+  // Encode all queued frames.
+  m_context->encode_thread.Shutdown();
+
   // Signal end of stream to encoder.
   if (const int flush_error = avcodec_send_frame(m_context->codec, nullptr))
     WARN_LOG_FMT(FRAMEDUMP, "Error sending flush packet: {}", AVErrorString(flush_error));
@@ -467,8 +578,11 @@ bool FFMpegFrameDump::IsStarted() const
 
 void FFMpegFrameDump::CloseVideoFile()
 {
+  m_context->encode_thread.Shutdown();
+
   av_frame_free(&m_context->src_frame);
-  av_frame_free(&m_context->scaled_frame);
+  for (AVFrame*& scaled_frame : m_context->scaled_frames)
+    av_frame_free(&scaled_frame);
 
   avcodec_free_context(&m_context->codec);
 
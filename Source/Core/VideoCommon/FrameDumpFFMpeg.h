@@ -8,6 +8,7 @@
 
 #include "Common/CommonTypes.h"
 
+struct AVFrame;
 struct FrameDumpContext;
 class PointerWrap;
 
@@ -50,6 +51,10 @@ private:
   bool CreateVideoFile();
   void CloseVideoFile();
   void CheckForConfigChange(const FrameData&);
+  AVFrame* AcquireScaledFrame();
+  bool UpdateScaler(int src_width, int src_height);
+  // Called on the encoder thread.
+  void EncodeFrame(AVFrame* frame);
   void ProcessPackets();
 
 #if defined(HAVE_FFMPEG)
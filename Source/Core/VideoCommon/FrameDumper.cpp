@@ -45,12 +45,19 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
   int target_width = target_rect.GetWidth();
   int target_height = target_rect.GetHeight();
 
+  const std::optional<size_t> readback_index = AcquireReadbackTexture(target_width, target_height);
+  if (!readback_index)
+    return;
+
   // We only need to render a copy if we need to stretch/scale the XFB copy.
   MathUtil::Rectangle<int> copy_rect = src_rect;
   if (source_width != target_width || source_height != target_height)
   {
     if (!CheckFrameDumpRenderTexture(target_width, target_height))
+    {
+      m_free_readbacks.push_back(*readback_index);
       return;
+    }
 
     g_gfx->ScaleTexture(m_frame_dump_render_framebuffer.get(),
                         m_frame_dump_render_framebuffer->GetRect(), src_texture, src_rect);
@@ -58,13 +65,10 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
-    return;
-
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  AbstractStagingTexture* readback_texture = m_readback_textures[*readback_index].get();
+  readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0, readback_texture->GetRect());
+  m_readback_states[*readback_index] = m_ffmpeg_dump.FetchState(ticks, frame_number);
+  m_pending_readbacks.push_back(*readback_index);
 }
 
 bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -95,174 +99,223 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+std::optional<size_t> FrameDumper::AcquireReadbackTexture(u32 target_width, u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
-  if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
-    return true;
+  ReclaimReadbackTextures();
 
-  rbtex.reset();
-  rbtex = g_gfx->CreateStagingTexture(
-      StagingTextureType::Readback,
-      TextureConfig(target_width, target_height, 1, 1, 1, AbstractTextureFormat::RGBA8, 0));
-  if (!rbtex)
-    return false;
+  if (!CheckFrameDumpReadbackTextures(target_width, target_height))
+    return std::nullopt;
 
-  return true;
+  if (m_free_readbacks.empty())
+  {
+    // Every texture is in use because conversion or encoding can't keep up.
+    if (g_ActiveConfig.bFrameDumpsDropFrames)
+    {
+      if (m_dropped_frame_count++ % 60 == 0)
+      {
+        WARN_LOG_FMT(VIDEO, "Frame dump can't keep up, {} frame(s) dropped so far.",
+                     m_dropped_frame_count);
+      }
+      return std::nullopt;
+    }
+
+    // Make sure the dump thread has every frame, so that one of them is guaranteed to finish.
+    SubmitReadbacks(0);
+    while (m_free_readbacks.empty())
+    {
+      m_readback_finished.Wait();
+      ReclaimReadbackTextures();
+    }
+  }
+
+  const size_t index = m_free_readbacks.back();
+  m_free_readbacks.pop_back();
+  return index;
 }
 
-void FrameDumper::FlushFrameDump()
+bool FrameDumper::CheckFrameDumpReadbackTextures(u32 target_width, u32 target_height)
 {
-  if (!m_frame_dump_needs_flush)
-    return;
-
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
+  const std::unique_ptr<AbstractStagingTexture>& first = m_readback_textures.front();
+  if (first && first->GetWidth() == target_width && first->GetHeight() == target_height)
+    return true;
 
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  // All frames of the old size must be done before their textures can be released.
+  SubmitReadbacks(0);
+  WaitForReadbacks();
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
-  {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
-  else
+  m_free_readbacks.clear();
+  for (std::unique_ptr<AbstractStagingTexture>& texture : m_readback_textures)
   {
-    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
-  }
+    texture.reset();
+    texture = g_gfx->CreateStagingTexture(
+        StagingTextureType::Readback,
+        TextureConfig(target_width, target_height, 1, 1, 1, AbstractTextureFormat::RGBA8, 0));
+    if (!texture)
+    {
+      for (std::unique_ptr<AbstractStagingTexture>& created_texture : m_readback_textures)
+        created_texture.reset();
+      m_free_readbacks.clear();
+      return false;
+    }
 
-  m_frame_dump_needs_flush = false;
+    m_free_readbacks.push_back(m_free_readbacks.size());
+  }
 
-  // Shutdown frame dumping if it is no longer active.
-  if (!IsFrameDumping())
-    ShutdownFrameDumping();
+  return true;
 }
 
-void FrameDumper::ShutdownFrameDumping()
+void FrameDumper::SubmitReadbacks(size_t keep_count)
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
-
-  if (!m_frame_dump_thread_running.IsSet())
-    return;
+  while (m_pending_readbacks.size() > keep_count)
+  {
+    const size_t index = m_pending_readbacks.front();
+    m_pending_readbacks.pop_front();
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
+    AbstractStagingTexture* texture = m_readback_textures[index].get();
+    texture->Flush();
+    if (!texture->Map())
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+      m_free_readbacks.push_back(index);
+      continue;
+    }
 
-  // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
-  if (m_frame_dump_thread.joinable())
-    m_frame_dump_thread.join();
-  m_frame_dump_render_framebuffer.reset();
-  m_frame_dump_render_texture.reset();
+    if (!m_frame_dump_thread_running)
+      StartFrameDumpThread();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+    m_frame_dump_thread.Push(index);
+  }
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::StartFrameDumpThread()
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
+  m_dump_to_ffmpeg = !g_ActiveConfig.bDumpFramesAsImages;
+  m_frame_dump_started = false;
 
-  if (!m_frame_dump_thread_running.IsSet())
+// If Dolphin was compiled without ffmpeg, we only support dumping to images.
+#if !defined(HAVE_FFMPEG)
+  if (m_dump_to_ffmpeg)
   {
-    if (m_frame_dump_thread.joinable())
-      m_frame_dump_thread.join();
-    m_frame_dump_thread_running.Set();
-    m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
+    WARN_LOG_FMT(VIDEO, "FrameDump: Dolphin was not compiled with FFmpeg, using fallback option. "
+                        "Frames will be saved as PNG images instead.");
+    m_dump_to_ffmpeg = false;
   }
+#endif
 
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  m_frame_dump_thread.Reset("FrameDumping", [this](size_t index) { ProcessFrame(index); });
+  m_frame_dump_thread_running = true;
 }
 
-void FrameDumper::FinishFrameData()
+void FrameDumper::ReclaimReadbackTextures()
 {
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  size_t index;
+  while (m_finished_readbacks.Pop(index))
+  {
+    m_readback_textures[index]->Unmap();
+    m_free_readbacks.push_back(index);
+  }
+}
 
-  m_frame_dump_output_texture->Unmap();
+void FrameDumper::WaitForReadbacks()
+{
+  ReclaimReadbackTextures();
+  while (m_free_readbacks.size() + m_pending_readbacks.size() < NUM_READBACK_TEXTURES &&
+         m_readback_textures.front())
+  {
+    m_readback_finished.Wait();
+    ReclaimReadbackTextures();
+  }
 }
 
-void FrameDumper::FrameDumpThreadFunc()
+void FrameDumper::FlushFrameDump()
 {
-  Common::SetCurrentThreadName("FrameDumping");
+  ReclaimReadbackTextures();
 
-  bool dump_to_ffmpeg = !g_ActiveConfig.bDumpFramesAsImages;
-  bool frame_dump_started = false;
+  // Frames from earlier presents have had a whole frame to finish their copies by now.
+  SubmitReadbacks(1);
 
-// If Dolphin was compiled without ffmpeg, we only support dumping to images.
-#if !defined(HAVE_FFMPEG)
-  if (dump_to_ffmpeg)
-  {
-    WARN_LOG_FMT(VIDEO, "FrameDump: Dolphin was not compiled with FFmpeg, using fallback option. "
-                        "Frames will be saved as PNG images instead.");
-    dump_to_ffmpeg = false;
-  }
-#endif
+  // Shutdown frame dumping if it is no longer active.
+  if (!IsFrameDumping())
+    ShutdownFrameDumping();
+}
+
+void FrameDumper::ShutdownFrameDumping()
+{
+  // Ensure all queued readbacks have been sent to the encoder.
+  SubmitReadbacks(0);
 
-  while (true)
+  if (m_frame_dump_thread_running)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
+    // Lets the thread finish the queued frames, then waits for it to exit.
+    m_frame_dump_thread.Shutdown();
+    m_frame_dump_thread_running = false;
 
-    auto frame = m_frame_dump_data;
+    // No additional cleanup is needed when dumping to images.
+    if (m_frame_dump_started && m_dump_to_ffmpeg)
+      StopFrameDumpToFFMPEG();
+    m_frame_dump_started = false;
+  }
 
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
-    {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
+  ReclaimReadbackTextures();
 
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+  m_frame_dump_render_framebuffer.reset();
+  m_frame_dump_render_texture.reset();
 
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
+  for (std::unique_ptr<AbstractStagingTexture>& texture : m_readback_textures)
+    texture.reset();
+  m_free_readbacks.clear();
+  m_dropped_frame_count = 0;
+}
 
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
-    {
-      if (!frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
-
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
-      }
+void FrameDumper::ProcessFrame(size_t readback_index)
+{
+  const AbstractStagingTexture* texture = m_readback_textures[readback_index].get();
+  const FrameData frame{reinterpret_cast<const u8*>(texture->GetMappedPointer()),
+                        static_cast<int>(texture->GetConfig().width),
+                        static_cast<int>(texture->GetConfig().height),
+                        static_cast<int>(texture->GetMappedStride()),
+                        m_readback_states[readback_index]};
+
+  // Save screenshot
+  if (m_screenshot_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
-      }
-    }
+    if (DumpFrameToPNG(frame, m_screenshot_name))
+      OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
 
-    m_frame_dump_done.Set();
+    // Reset settings
+    m_screenshot_name.clear();
+    m_screenshot_completed.Set();
   }
 
-  if (frame_dump_started)
+  if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
   {
-    // No additional cleanup is needed when dumping to images.
-    if (dump_to_ffmpeg)
-      StopFrameDumpToFFMPEG();
+    if (!m_frame_dump_started)
+    {
+      if (m_dump_to_ffmpeg)
+        m_frame_dump_started = StartFrameDumpToFFMPEG(frame);
+      else
+        m_frame_dump_started = StartFrameDumpToImage(frame);
+
+      // Stop frame dumping if we fail to start.
+      if (!m_frame_dump_started)
+        Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+    }
+
+    // If we failed to start frame dumping, don't write a frame.
+    if (m_frame_dump_started)
+    {
+      if (m_dump_to_ffmpeg)
+        DumpFrameToFFMPEG(frame);
+      else
+        DumpFrameToImage(frame);
+    }
   }
+
+  // The frame has been converted, so the video thread can reuse the texture.
+  m_finished_readbacks.Push(readback_index);
+  m_readback_finished.Set();
 }
 
 #if defined(HAVE_FFMPEG)
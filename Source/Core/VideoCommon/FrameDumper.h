@@ -3,11 +3,20 @@
 
 #pragma once
 
+#include <array>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
-#include "Common/Thread.h"
+#include "Common/SPSCQueue.h"
+#include "Common/WorkQueueThread.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/VideoEvents.h"
@@ -22,10 +31,11 @@ public:
   FrameDumper();
   ~FrameDumper();
 
-  // Ensures all rendered frames are queued for encoding.
+  // Queues the frames whose readback has completed for encoding. The most recent frame is held
+  // back for one frame, so that its copy can finish on the GPU without stalling.
   void FlushFrameDump();
 
-  // Fills the frame dump staging texture with the current XFB texture.
+  // Starts copying the current XFB texture to a free readback texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect,
                         const MathUtil::Rectangle<int>& target_rect, u64 ticks, int frame_number);
@@ -37,8 +47,11 @@ public:
   void DoState(PointerWrap& p);
 
 private:
+  // Number of frames that can be in flight between the GPU copy and the end of color conversion.
+  static constexpr size_t NUM_READBACK_TEXTURES = 4;
+
   // NOTE: The methods below are called on the framedumping thread.
-  void FrameDumpThreadFunc();
+  void ProcessFrame(size_t readback_index);
   bool StartFrameDumpToFFMPEG(const FrameData&);
   void DumpFrameToFFMPEG(const FrameData&);
   void StopFrameDumpToFFMPEG();
@@ -51,41 +64,47 @@ private:
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
-
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Returns a free readback texture of the given size, waiting for the dump thread or dropping the
+  // frame if there is none.
+  std::optional<size_t> AcquireReadbackTexture(u32 target_width, u32 target_height);
 
-  // Ensures all encoded frames have been written to the output file.
-  void FinishFrameData();
+  // Checks that the readback textures exist and are the correct size.
+  bool CheckFrameDumpReadbackTextures(u32 target_width, u32 target_height);
 
-  std::thread m_frame_dump_thread;
-  Common::Flag m_frame_dump_thread_running;
+  // Maps pending readbacks and hands them to the dump thread, keeping the newest keep_count back.
+  void SubmitReadbacks(size_t keep_count);
 
-  // Used to kick frame dump thread.
-  Common::Event m_frame_dump_start;
+  void StartFrameDumpThread();
 
-  // Set by frame dump thread on frame completion.
-  Common::Event m_frame_dump_done;
+  // Unmaps the readback textures the dump thread is done with and returns them to the pool.
+  void ReclaimReadbackTextures();
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
+  // Waits until the dump thread is done with every readback texture.
+  void WaitForReadbacks();
 
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
+  Common::WorkQueueThread<size_t> m_frame_dump_thread;
+  bool m_frame_dump_thread_running = false;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  // Pool of readback textures. Each one is either free, waiting for its GPU copy to complete, or
+  // mapped and owned by the dump thread until the frame has been converted.
+  std::array<std::unique_ptr<AbstractStagingTexture>, NUM_READBACK_TEXTURES> m_readback_textures;
+  // Emulation state at the time each readback texture was filled.
+  std::array<FrameState, NUM_READBACK_TEXTURES> m_readback_states;
+  std::vector<size_t> m_free_readbacks;
+  std::deque<size_t> m_pending_readbacks;
+  // Filled by the dump thread, then unmapped and reused by the video thread.
+  Common::SPSCQueue<size_t, false> m_finished_readbacks;
+  Common::Event m_readback_finished;
+
+  u32 m_dropped_frame_count = 0;
+
+  // Only accessed by the dump thread, or while it is not running.
+  bool m_dump_to_ffmpeg = false;
+  bool m_frame_dump_started = false;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
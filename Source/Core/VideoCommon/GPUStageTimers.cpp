@@ -0,0 +1,54 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/GPUStageTimers.h"
+
+GPUStageTimers g_gpu_stage_timers;
+
+void GPUStageTimers::SetEnabled(bool enabled)
+{
+  m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void GPUStageTimers::Reset()
+{
+  for (StageTotals& totals : m_totals)
+  {
+    totals.nanoseconds.store(0, std::memory_order_relaxed);
+    totals.samples.store(0, std::memory_order_relaxed);
+  }
+}
+
+void GPUStageTimers::AddSample(GPUStage stage, u64 nanoseconds)
+{
+  StageTotals& totals = m_totals[static_cast<size_t>(stage)];
+  totals.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+  totals.samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+u64 GPUStageTimers::GetTotalNanoseconds(GPUStage stage) const
+{
+  return m_totals[static_cast<size_t>(stage)].nanoseconds.load(std::memory_order_relaxed);
+}
+
+u64 GPUStageTimers::GetSampleCount(GPUStage stage) const
+{
+  return m_totals[static_cast<size_t>(stage)].samples.load(std::memory_order_relaxed);
+}
+
+const char* GPUStageTimers::GetStageName(GPUStage stage)
+{
+  switch (stage)
+  {
+  case GPUStage::OpcodeDecode:
+    return "opcode_decode";
+  case GPUStage::VertexLoading:
+    return "vertex_loading";
+  case GPUStage::TextureCache:
+    return "texture_cache";
+  case GPUStage::ShaderLookup:
+    return "shader_lookup";
+  default:
+    return "unknown";
+  }
+}
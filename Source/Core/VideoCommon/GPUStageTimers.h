@@ -0,0 +1,81 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include "Common/CommonTypes.h"
+
+// Coarse wall-clock accounting of the main stages of the GPU thread, used by benchmarks.
+// Recording is off by default, in which case a timer costs a single relaxed load.
+enum class GPUStage : u32
+{
+  // Includes the time spent in all other stages, which are reached through the decoder.
+  OpcodeDecode,
+  VertexLoading,
+  TextureCache,
+  ShaderLookup,
+  Count,
+};
+
+class GPUStageTimers
+{
+public:
+  bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+  void SetEnabled(bool enabled);
+  void Reset();
+
+  void AddSample(GPUStage stage, u64 nanoseconds);
+
+  u64 GetTotalNanoseconds(GPUStage stage) const;
+  u64 GetSampleCount(GPUStage stage) const;
+
+  static const char* GetStageName(GPUStage stage);
+
+private:
+  struct StageTotals
+  {
+    std::atomic<u64> nanoseconds{0};
+    std::atomic<u64> samples{0};
+  };
+
+  std::atomic<bool> m_enabled{false};
+  std::array<StageTotals, static_cast<size_t>(GPUStage::Count)> m_totals;
+};
+
+extern GPUStageTimers g_gpu_stage_timers;
+
+class ScopedGPUStageTimer
+{
+public:
+  // Passing record = false disables the timer, for paths shared with the CPU thread.
+  explicit ScopedGPUStageTimer(GPUStage stage, bool record = true)
+      : m_stage(stage), m_active(record && g_gpu_stage_timers.IsEnabled())
+  {
+    if (m_active)
+      m_start = Clock::now();
+  }
+
+  ~ScopedGPUStageTimer()
+  {
+    if (!m_active)
+      return;
+
+    const auto elapsed = Clock::now() - m_start;
+    g_gpu_stage_timers.AddSample(
+        m_stage, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  }
+
+  ScopedGPUStageTimer(const ScopedGPUStageTimer&) = delete;
+  ScopedGPUStageTimer& operator=(const ScopedGPUStageTimer&) = delete;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  GPUStage m_stage;
+  bool m_active;
+  Clock::time_point m_start;
+};
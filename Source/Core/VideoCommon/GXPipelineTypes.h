@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstring>
+#include <functional>
+
+#include "Common/Hash.h"
 #include "VideoCommon/GeometryShaderGen.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/PixelShaderGen.h"
@@ -31,19 +36,28 @@ struct GXPipelineUid
   DepthState depth_state;
   BlendingState blending_state;
 
+  // Hash of the members above, used as the key hash for the pipeline cache. This is not updated
+  // automatically: UpdateHash() must be called after modifying the UID and before looking it up,
+  // so that the hash is computed once per state change rather than once per lookup.
+  u64 hash;
+
   // We use memcmp() for comparing pipelines as std::tie generates a large number of instructions,
   // and this map lookup can happen every draw call. However, as using memcmp() will also compare
   // any padding bytes, we have to ensure these are zeroed out.
   GXPipelineUid() { std::memset(static_cast<void*>(this), 0, sizeof(*this)); }
+  void UpdateHash() { hash = Common::GetHash64(reinterpret_cast<const u8*>(this), KeySize(), 0); }
   bool operator<(const GXPipelineUid& rhs) const
   {
-    return std::memcmp(this, &rhs, sizeof(*this)) < 0;
+    return std::memcmp(this, &rhs, KeySize()) < 0;
   }
   bool operator==(const GXPipelineUid& rhs) const
   {
-    return std::memcmp(this, &rhs, sizeof(*this)) == 0;
+    return hash == rhs.hash && std::memcmp(this, &rhs, KeySize()) == 0;
   }
   bool operator!=(const GXPipelineUid& rhs) const { return !operator==(rhs); }
+
+private:
+  static constexpr u32 KeySize() { return offsetof(GXPipelineUid, hash); }
 };
 struct GXUberPipelineUid
 {
@@ -55,16 +69,23 @@ struct GXUberPipelineUid
   DepthState depth_state;
   BlendingState blending_state;
 
+  // See GXPipelineUid::hash.
+  u64 hash;
+
   GXUberPipelineUid() { std::memset(static_cast<void*>(this), 0, sizeof(*this)); }
+  void UpdateHash() { hash = Common::GetHash64(reinterpret_cast<const u8*>(this), KeySize(), 0); }
   bool operator<(const GXUberPipelineUid& rhs) const
   {
-    return std::memcmp(this, &rhs, sizeof(*this)) < 0;
+    return std::memcmp(this, &rhs, KeySize()) < 0;
   }
   bool operator==(const GXUberPipelineUid& rhs) const
   {
-    return std::memcmp(this, &rhs, sizeof(*this)) == 0;
+    return hash == rhs.hash && std::memcmp(this, &rhs, KeySize()) == 0;
   }
   bool operator!=(const GXUberPipelineUid& rhs) const { return !operator==(rhs); }
+
+private:
+  static constexpr u32 KeySize() { return offsetof(GXUberPipelineUid, hash); }
 };
 
 // Disk cache of pipeline UIDs. We can't use the whole UID as a type as it contains pointers.
@@ -93,3 +114,23 @@ struct SerializedGXUberPipelineUid
 #pragma pack(pop)
 
 }  // namespace VideoCommon
+
+namespace std
+{
+template <>
+struct hash<VideoCommon::GXPipelineUid>
+{
+  size_t operator()(const VideoCommon::GXPipelineUid& uid) const
+  {
+    return static_cast<size_t>(uid.hash);
+  }
+};
+template <>
+struct hash<VideoCommon::GXUberPipelineUid>
+{
+  size_t operator()(const VideoCommon::GXUberPipelineUid& uid) const
+  {
+    return static_cast<size_t>(uid.hash);
+  }
+};
+}  // namespace std
@@ -14,6 +14,8 @@
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <cstring>
+
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
@@ -24,6 +26,7 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/GPUStageTimers.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -262,6 +265,7 @@ u8* RunFifo(DataReader src, u32* cycles)
 {
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
+  ScopedGPUStageTimer timer(GPUStage::OpcodeDecode, !is_preprocess);
   u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
 
   if (cycles != nullptr)
@@ -274,4 +278,208 @@ u8* RunFifo(DataReader src, u32* cycles)
 template u8* RunFifo<true>(DataReader src, u32* cycles);
 template u8* RunFifo<false>(DataReader src, u32* cycles);
 
+class DecodeCallback final : public Callback
+{
+public:
+  explicit DecodeCallback(DecodedBatch* batch) : m_batch(batch) {}
+
+  OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data))
+  {
+    m_command.type = DecodedCommand::Type::XF;
+    m_command.xf = {address, count};
+  }
+  OPCODE_CALLBACK(void OnCP(u8 command, u32 value))
+  {
+    m_command.type = DecodedCommand::Type::CP;
+    m_command.reg = {command, value};
+
+    const u8 sub_command = command & CP_COMMAND_MASK;
+    if (sub_command == VCD_LO || sub_command == VCD_HI)
+    {
+      VertexLoaderManager::g_preprocess_vat_dirty = BitSet8::AllTrue(CP_NUM_VAT_REG);
+    }
+    else if (sub_command == CP_VAT_REG_A || sub_command == CP_VAT_REG_B ||
+             sub_command == CP_VAT_REG_C)
+    {
+      VertexLoaderManager::g_preprocess_vat_dirty[command & CP_VAT_MASK] = true;
+    }
+    GetCPState().LoadCPReg(command, value);
+  }
+  OPCODE_CALLBACK(void OnBP(u8 command, u32 value))
+  {
+    m_command.type = DecodedCommand::Type::BP;
+    m_command.reg = {command, value};
+
+    // See LoadBPReg; these are the writes which end up in PixelEngine::SetFinish/SetToken.
+    if ((command == BPMEM_SETDRAWDONE && (value & 0xff) == 0x02) ||
+        command == BPMEM_PE_TOKEN_ID || command == BPMEM_PE_TOKEN_INT_ID)
+    {
+      m_signals_cpu = true;
+    }
+  }
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size))
+  {
+    m_command.type = DecodedCommand::Type::IndexedLoad;
+    m_command.indexed_load = {array, size, address, index};
+  }
+  OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
+                                          u32 vertex_size, u16 num_vertices, const u8* vertex_data))
+  {
+    // The loader was already created by GetVertexSize.
+    m_command.type = DecodedCommand::Type::Primitive;
+    m_command.draw = {primitive, vat, num_vertices, vertex_size};
+  }
+  // This can't be inlined since it calls Run, which makes it recursive.
+  OPCODE_CALLBACK_NOINLINE(void OnDisplayList(u32 address, u32 size))
+  {
+    DecodedCommand call{};
+    call.type = DecodedCommand::Type::DisplayList;
+    call.display_list.recursive = m_display_list_data != nullptr;
+    if (call.display_list.recursive)
+    {
+      m_batch->commands.push_back(call);
+      return;
+    }
+
+    // Copy the display list, as the CPU may overwrite it before the GPU thread gets to it. The
+    // padding keeps SIMD overreads in the vertex loader in bounds.
+    auto& memory = Core::System::GetInstance().GetMemory();
+    const u8* const start_address = memory.GetPointer(address);
+    call.display_list.valid = start_address != nullptr;
+    m_batch->commands.push_back(call);
+    if (!call.display_list.valid)
+      return;
+
+    std::vector<u8>& display_lists = m_batch->display_lists;
+    const size_t offset = display_lists.size();
+    display_lists.resize(offset + size + 4);
+    std::memcpy(display_lists.data() + offset, start_address, size);
+
+    m_display_list_data = display_lists.data() + offset;
+    m_display_list_offset = static_cast<u32>(offset);
+    Run(m_display_list_data, size, *this);
+    m_display_list_data = nullptr;
+
+    DecodedCommand end{};
+    end.type = DecodedCommand::Type::DisplayListEnd;
+    m_batch->commands.push_back(end);
+  }
+  OPCODE_CALLBACK(void OnNop(u32 count))
+  {
+    m_command.type = DecodedCommand::Type::Nop;
+    m_command.nop_count = count;
+  }
+  OPCODE_CALLBACK(void OnUnknown(u8 opcode, const u8* data))
+  {
+    m_command.type = DecodedCommand::Type::Unknown;
+  }
+  OPCODE_CALLBACK(void OnCommand(const u8* data, u32 size))
+  {
+    if (static_cast<Opcode>(data[0]) == Opcode::GX_CMD_CALL_DL)
+      return;
+
+    if (m_display_list_data != nullptr)
+    {
+      m_command.data = nullptr;
+      m_command.display_list_offset =
+          m_display_list_offset + static_cast<u32>(data - m_display_list_data);
+    }
+    else
+    {
+      m_command.data = data;
+      m_command.display_list_offset = 0;
+    }
+    m_command.size = size;
+    m_batch->commands.push_back(m_command);
+  }
+  OPCODE_CALLBACK(CPState& GetCPState()) { return g_preprocess_cp_state; }
+  OPCODE_CALLBACK(u32 GetVertexSize(u8 vat))
+  {
+    VertexLoaderBase* loader = VertexLoaderManager::RefreshLoader<true>(vat);
+    return loader->m_vertex_size;
+  }
+
+  bool m_signals_cpu = false;
+
+private:
+  DecodedBatch* m_batch;
+  DecodedCommand m_command{};
+  // The copy of the display list being decoded, which stays in place while it is parsed.
+  const u8* m_display_list_data = nullptr;
+  u32 m_display_list_offset = 0;
+};
+
+u8* Decode(DataReader src, DecodedBatch* batch, bool* signals_cpu)
+{
+  DecodeCallback callback(batch);
+  u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
+
+  if (callback.m_signals_cpu)
+    *signals_cpu = true;
+
+  src.Skip(size);
+  return src.GetPointer();
+}
+
+void ExecuteDecoded(const DecodedBatch& batch, size_t begin, size_t end, u32* cycles)
+{
+  RunCallback<false> callback;
+  ScopedGPUStageTimer timer(GPUStage::OpcodeDecode);
+
+  for (size_t i = begin; i < end; ++i)
+  {
+    const DecodedCommand& command = batch.commands[i];
+    switch (command.type)
+    {
+    case DecodedCommand::Type::DisplayList:
+      // The commands of the list follow and are executed in order, like RunCallback::OnDisplayList
+      // would when it runs the list.
+      callback.m_cycles += 6;
+      if (command.display_list.recursive)
+        WARN_LOG_FMT(VIDEO, "recursive display list detected");
+      else if (command.display_list.valid)
+        g_stats.SwapDL();
+      continue;
+    case DecodedCommand::Type::DisplayListEnd:
+      INCSTAT(g_stats.this_frame.num_dlists_called);
+      g_stats.SwapDL();
+      continue;
+    default:
+      break;
+    }
+
+    const u8* data = batch.GetData(command);
+    switch (command.type)
+    {
+    case DecodedCommand::Type::XF:
+      callback.OnXF(command.xf.address, command.xf.count, &data[5]);
+      break;
+    case DecodedCommand::Type::CP:
+      callback.OnCP(command.reg.command, command.reg.value);
+      break;
+    case DecodedCommand::Type::BP:
+      callback.OnBP(command.reg.command, command.reg.value);
+      break;
+    case DecodedCommand::Type::IndexedLoad:
+      callback.OnIndexedLoad(command.indexed_load.array, command.indexed_load.index,
+                             command.indexed_load.address, command.indexed_load.size);
+      break;
+    case DecodedCommand::Type::Primitive:
+      callback.OnPrimitiveCommand(command.draw.primitive, command.draw.vat,
+                                  command.draw.vertex_size, command.draw.num_vertices, &data[3]);
+      break;
+    case DecodedCommand::Type::Nop:
+      callback.OnNop(command.nop_count);
+      break;
+    default:
+      callback.OnUnknown(data[0], data);
+      break;
+    }
+    callback.OnCommand(data, command.size);
+  }
+
+  if (cycles != nullptr)
+    *cycles = callback.m_cycles;
+}
+
 }  // namespace OpcodeDecoder
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <type_traits>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -276,6 +277,92 @@ DOLPHIN_FORCE_INLINE u32 Run(const u8* data, u32 available, T& callback)
 template <bool is_preprocess = false>
 u8* RunFifo(DataReader src, u32* cycles);
 
+// A command parsed by the decode stage of the pipelined GPU thread, which the GPU thread executes
+// with ExecuteDecoded without parsing it again.
+struct DecodedCommand
+{
+  enum class Type : u8
+  {
+    XF,
+    CP,
+    BP,
+    IndexedLoad,
+    Primitive,
+    Nop,
+    Unknown,
+    // The commands of a display list follow DisplayList and end with DisplayListEnd.
+    DisplayList,
+    DisplayListEnd,
+  };
+
+  struct XFLoad
+  {
+    u16 address;
+    u8 count;
+  };
+  struct RegisterLoad
+  {
+    u8 command;
+    u32 value;
+  };
+  struct IndexedXFLoad
+  {
+    CPArray array;
+    u8 size;
+    u16 address;
+    u32 index;
+  };
+  struct PrimitiveDraw
+  {
+    Primitive primitive;
+    u8 vat;
+    u16 num_vertices;
+    u32 vertex_size;
+  };
+  struct DisplayListCall
+  {
+    bool recursive;
+    bool valid;
+  };
+
+  Type type;
+  union
+  {
+    XFLoad xf;
+    RegisterLoad reg;
+    IndexedXFLoad indexed_load;
+    PrimitiveDraw draw;
+    DisplayListCall display_list;
+    u32 nop_count;
+  };
+
+  // The raw command, starting with the opcode. Commands read from a display list have no pointer
+  // and are instead located at display_list_offset in the batch's copy of its display lists.
+  const u8* data;
+  u32 display_list_offset;
+  u32 size;
+};
+
+struct DecodedBatch
+{
+  std::vector<DecodedCommand> commands;
+  std::vector<u8> display_lists;
+
+  const u8* GetData(const DecodedCommand& command) const
+  {
+    return command.data ? command.data : display_lists.data() + command.display_list_offset;
+  }
+};
+
+// Parses the complete commands in src for the decode stage of the pipelined GPU thread and appends
+// them to batch, copying any display lists they call. This tracks g_preprocess_cp_state and creates
+// the vertex loaders the commands will need, but has no effects visible to the emulated system.
+// signals_cpu is set if a parsed command sets a PE token or finish flag once it is executed.
+u8* Decode(DataReader src, DecodedBatch* batch, bool* signals_cpu);
+
+// Executes commands [begin, end) of a batch made by Decode, exactly like RunFifo would have.
+void ExecuteDecoded(const DecodedBatch& batch, size_t begin, size_t end, u32* cycles);
+
 }  // namespace OpcodeDecoder
 
 template <>
@@ -24,6 +24,9 @@ void PerformanceMetrics::Reset()
   m_time_sleeping = DT::zero();
   m_real_times.fill(Clock::now());
   m_cpu_times.fill(Core::System::GetInstance().GetCoreTiming().GetCPUTimePoint(0));
+
+  m_audio_latency.store(DT::zero());
+  m_audio_underruns.store(0);
 }
 
 void PerformanceMetrics::CountFrame()
@@ -52,6 +55,16 @@ void PerformanceMetrics::CountPerformanceMarker(Core::System& system, s64 cycles
   m_time_index += 1;
 }
 
+void PerformanceMetrics::SetAudioLatency(DT latency)
+{
+  m_audio_latency.store(latency, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountAudioUnderrun()
+{
+  m_audio_underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
 double PerformanceMetrics::GetFPS() const
 {
   return m_fps_counter.GetHzAvg();
@@ -80,6 +93,16 @@ double PerformanceMetrics::GetLastSpeedDenominator() const
          Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
 }
 
+DT PerformanceMetrics::GetAudioLatency() const
+{
+  return m_audio_latency.load(std::memory_order_relaxed);
+}
+
+u64 PerformanceMetrics::GetAudioUnderrunCount() const
+{
+  return m_audio_underruns.load(std::memory_order_relaxed);
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
 {
   const float bg_alpha = 0.7f;
@@ -269,5 +292,29 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     }
   }
 
+  if (g_ActiveConfig.bShowAudioLatency)
+  {
+    float window_height = (12.f + 17.f * 2) * backbuffer_scale;
+
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("AudioStats", nullptr, imgui_flags))
+    {
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Audio:%4.0lfms",
+                         DT_ms(GetAudioLatency()).count());
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Drops:%5llu",
+                         static_cast<unsigned long long>(GetAudioUnderrunCount()));
+      ImGui::End();
+    }
+  }
+
   ImGui::PopStyleVar(2);
 }
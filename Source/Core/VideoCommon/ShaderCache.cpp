@@ -3,6 +3,8 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <cstring>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
@@ -116,10 +118,22 @@ void ShaderCache::Shutdown()
 
 const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 {
+  INCSTAT(g_stats.this_frame.num_pipeline_lookups);
+  if (m_last_gx_pipeline && uid == m_last_gx_pipeline_uid)
+  {
+    INCSTAT(g_stats.this_frame.num_pipeline_lookups_last);
+    return m_last_gx_pipeline;
+  }
+
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
+  {
+    m_last_gx_pipeline_uid = uid;
+    m_last_gx_pipeline = it->second.first.get();
     return it->second.first.get();
+  }
 
+  INCSTAT(g_stats.this_frame.num_pipeline_lookup_misses);
   const bool exists_in_cache = it != m_gx_pipeline_cache.end();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
@@ -132,16 +146,30 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 
 std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& uid)
 {
+  INCSTAT(g_stats.this_frame.num_pipeline_lookups);
+  if (m_last_gx_pipeline && uid == m_last_gx_pipeline_uid)
+  {
+    INCSTAT(g_stats.this_frame.num_pipeline_lookups_last);
+    return m_last_gx_pipeline;
+  }
+
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end())
   {
     // .second is the pending flag, i.e. compiling in the background.
     if (!it->second.second)
+    {
+      m_last_gx_pipeline_uid = uid;
+      m_last_gx_pipeline = it->second.first.get();
       return it->second.first.get();
+    }
     else
+    {
       return {};
+    }
   }
 
+  INCSTAT(g_stats.this_frame.num_pipeline_lookup_misses);
   AppendGXPipelineUID(uid);
   QueuePipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE);
   return {};
@@ -149,10 +177,22 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
 
 const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineUid& uid)
 {
+  INCSTAT(g_stats.this_frame.num_pipeline_lookups);
+  if (m_last_gx_uber_pipeline && uid == m_last_gx_uber_pipeline_uid)
+  {
+    INCSTAT(g_stats.this_frame.num_pipeline_lookups_last);
+    return m_last_gx_uber_pipeline;
+  }
+
   auto it = m_gx_uber_pipeline_cache.find(uid);
   if (it != m_gx_uber_pipeline_cache.end() && !it->second.second)
+  {
+    m_last_gx_uber_pipeline_uid = uid;
+    m_last_gx_uber_pipeline = it->second.first.get();
     return it->second.first.get();
+  }
 
+  INCSTAT(g_stats.this_frame.num_pipeline_lookup_misses);
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
@@ -223,60 +263,29 @@ static void UnserializePipelineUid(const SerializedUidType& uid, UidType& real_u
   real_uid.rasterization_state.hex = uid.rasterization_state_bits;
   real_uid.depth_state.hex = uid.depth_state_bits;
   real_uid.blending_state.hex = uid.blending_state_bits;
+  real_uid.UpdateHash();
 }
 
-template <ShaderStage stage, typename K, typename T>
+template <typename T>
 void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid)
 {
-  class CacheReader : public Common::LinearDiskCacheReader<K, u8>
-  {
-  public:
-    CacheReader(T& cache_) : cache(cache_) {}
-    void Read(const K& key, const u8* value, u32 value_size) override
-    {
-      auto shader = g_gfx->CreateShaderFromBinary(stage, value, value_size);
-      if (shader)
-      {
-        auto& entry = cache.shader_map[key];
-        entry.shader = std::move(shader);
-        entry.pending = false;
-
-        switch (stage)
-        {
-        case ShaderStage::Vertex:
-          INCSTAT(g_stats.num_vertex_shaders_created);
-          INCSTAT(g_stats.num_vertex_shaders_alive);
-          break;
-        case ShaderStage::Pixel:
-          INCSTAT(g_stats.num_pixel_shaders_created);
-          INCSTAT(g_stats.num_pixel_shaders_alive);
-          break;
-        default:
-          break;
-        }
-      }
-    }
-
-  private:
-    T& cache;
-  };
-
+  // Only the index is read here. Shaders are created from their binaries when they are first
+  // needed, see CreateShaderFromDiskCache.
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
-  CacheReader reader(cache);
-  u32 count = cache.disk_cache.OpenAndRead(filename, reader);
-  INFO_LOG_FMT(VIDEO, "Loaded {} cached shaders from {}", count, filename);
+  u32 count = cache.disk_cache.Open(filename);
+  cache.disk_cache.CompactInBackground();
+  INFO_LOG_FMT(VIDEO, "Opened {} with {} cached shaders", filename, count);
 }
 
 template <typename T>
 void ShaderCache::ClearShaderCache(T& cache)
 {
-  cache.disk_cache.Sync();
   cache.disk_cache.Close();
   cache.shader_map.clear();
 }
 
 template <typename KeyType, typename DiskKeyType, typename T>
-void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyType, u8>& disk_cache,
+void ShaderCache::LoadPipelineCache(T& cache, Common::IndexedDiskCache<DiskKeyType, u8>& disk_cache,
                                     APIType api_type, const char* type, bool include_gameid)
 {
   class CacheReader : public Common::LinearDiskCacheReader<DiskKeyType, u8>
@@ -333,12 +342,16 @@ void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyTyp
     File::Delete(filename);
     disk_cache.OpenAndRead(filename, reader);
   }
+
+  disk_cache.CompactInBackground();
 }
 
 template <typename T, typename Y>
 void ShaderCache::ClearPipelineCache(T& cache, Y& disk_cache)
 {
-  disk_cache.Sync();
+  m_last_gx_pipeline = nullptr;
+  m_last_gx_uber_pipeline = nullptr;
+
   disk_cache.Close();
 
   // Set the pending flag to false, and destroy the pipeline.
@@ -354,21 +367,16 @@ void ShaderCache::LoadCaches()
   // Ubershader caches, if present.
   if (g_ActiveConfig.backend_info.bSupportsShaderBinaries)
   {
-    LoadShaderCache<ShaderStage::Vertex, UberShader::VertexShaderUid>(m_uber_vs_cache, m_api_type,
-                                                                      "uber-vs", false);
-    LoadShaderCache<ShaderStage::Pixel, UberShader::PixelShaderUid>(m_uber_ps_cache, m_api_type,
-                                                                    "uber-ps", false);
+    LoadShaderCache(m_uber_vs_cache, m_api_type, "uber-vs", false);
+    LoadShaderCache(m_uber_ps_cache, m_api_type, "uber-ps", false);
 
     // We also share geometry shaders, as there aren't many variants.
     if (m_host_config.backend_geometry_shaders)
-      LoadShaderCache<ShaderStage::Geometry, GeometryShaderUid>(m_gs_cache, m_api_type, "gs",
-                                                                false);
+      LoadShaderCache(m_gs_cache, m_api_type, "gs", false);
 
     // Specialized shaders, gameid-specific.
-    LoadShaderCache<ShaderStage::Vertex, VertexShaderUid>(m_vs_cache, m_api_type, "specialized-vs",
-                                                          true);
-    LoadShaderCache<ShaderStage::Pixel, PixelShaderUid>(m_ps_cache, m_api_type, "specialized-ps",
-                                                        true);
+    LoadShaderCache(m_vs_cache, m_api_type, "specialized-vs", true);
+    LoadShaderCache(m_ps_cache, m_api_type, "specialized-ps", true);
   }
 
   if (g_ActiveConfig.backend_info.bSupportsPipelineCacheData)
@@ -430,8 +438,45 @@ void ShaderCache::CompileMissingPipelines()
   }
 }
 
+// Creates the shader from the binary in the disk cache, if there is one.
+template <typename K>
+static std::unique_ptr<AbstractShader>
+CreateShaderFromDiskCache(ShaderStage stage, const Common::IndexedDiskCache<K, u8>& disk_cache,
+                          const K& uid)
+{
+  std::unique_ptr<AbstractShader> shader;
+  disk_cache.Lookup(uid, [&](const u8* value, u32 value_size) {
+    shader = g_gfx->CreateShaderFromBinary(stage, value, value_size);
+  });
+  return shader;
+}
+
+template <typename K>
+static void AppendShaderToDiskCache(Common::IndexedDiskCache<K, u8>& disk_cache, const K& uid,
+                                    const AbstractShader& shader)
+{
+  if (!g_ActiveConfig.bShaderCache || !g_ActiveConfig.backend_info.bSupportsShaderBinaries)
+    return;
+
+  auto binary = shader.GetBinary();
+  if (binary.empty())
+    return;
+
+  // Skip shaders which were created from the same binary by CreateShaderFromDiskCache. A binary
+  // which failed to load is superseded by the new one.
+  bool cached = false;
+  disk_cache.Lookup(uid, [&](const u8* value, u32 value_size) {
+    cached = value_size == binary.size() && std::memcmp(value, binary.data(), value_size) == 0;
+  });
+  if (!cached)
+    disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
+}
+
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Vertex, m_vs_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
@@ -440,6 +485,9 @@ std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexSha
 std::unique_ptr<AbstractShader>
 ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Vertex, m_uber_vs_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData());
   return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer(),
@@ -448,6 +496,9 @@ ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) con
 
 std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Pixel, m_ps_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData());
   return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
@@ -456,6 +507,9 @@ std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShade
 std::unique_ptr<AbstractShader>
 ShaderCache::CompilePixelUberShader(const UberShader::PixelShaderUid& uid) const
 {
+  if (auto shader = CreateShaderFromDiskCache(ShaderStage::Pixel, m_uber_ps_cache.disk_cache, uid))
+    return shader;
+
   const ShaderCode source_code =
       UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData());
   return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer(),
@@ -470,12 +524,7 @@ const AbstractShader* ShaderCache::InsertVertexShader(const VertexShaderUid& uid
 
   if (shader && !entry.shader)
   {
-    if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_vs_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+    AppendShaderToDiskCache(m_vs_cache.disk_cache, uid, *shader);
     INCSTAT(g_stats.num_vertex_shaders_created);
     INCSTAT(g_stats.num_vertex_shaders_alive);
     entry.shader = std::move(shader);
@@ -492,12 +541,7 @@ const AbstractShader* ShaderCache::InsertVertexUberShader(const UberShader::Vert
 
   if (shader && !entry.shader)
   {
-    if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_uber_vs_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+    AppendShaderToDiskCache(m_uber_vs_cache.disk_cache, uid, *shader);
     INCSTAT(g_stats.num_vertex_shaders_created);
     INCSTAT(g_stats.num_vertex_shaders_alive);
     entry.shader = std::move(shader);
@@ -514,12 +558,7 @@ const AbstractShader* ShaderCache::InsertPixelShader(const PixelShaderUid& uid,
 
   if (shader && !entry.shader)
   {
-    if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_ps_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+    AppendShaderToDiskCache(m_ps_cache.disk_cache, uid, *shader);
     INCSTAT(g_stats.num_pixel_shaders_created);
     INCSTAT(g_stats.num_pixel_shaders_alive);
     entry.shader = std::move(shader);
@@ -536,12 +575,7 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
 
   if (shader && !entry.shader)
   {
-    if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_uber_ps_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+    AppendShaderToDiskCache(m_uber_ps_cache.disk_cache, uid, *shader);
     INCSTAT(g_stats.num_pixel_shaders_created);
     INCSTAT(g_stats.num_pixel_shaders_alive);
     entry.shader = std::move(shader);
@@ -552,23 +586,22 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
 
 const AbstractShader* ShaderCache::CreateGeometryShader(const GeometryShaderUid& uid)
 {
-  const ShaderCode source_code =
-      GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
   std::unique_ptr<AbstractShader> shader =
-      g_gfx->CreateShaderFromSource(ShaderStage::Geometry, source_code.GetBuffer(),
-                                    fmt::format("Geometry shader: {}", *uid.GetUidData()));
+      CreateShaderFromDiskCache(ShaderStage::Geometry, m_gs_cache.disk_cache, uid);
+  if (!shader)
+  {
+    const ShaderCode source_code =
+        GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
+    shader = g_gfx->CreateShaderFromSource(ShaderStage::Geometry, source_code.GetBuffer(),
+                                           fmt::format("Geometry shader: {}", *uid.GetUidData()));
+  }
 
   auto& entry = m_gs_cache.shader_map[uid];
   entry.pending = false;
 
   if (shader && !entry.shader)
   {
-    if (g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries)
-    {
-      auto binary = shader->GetBinary();
-      if (!binary.empty())
-        m_gs_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
-    }
+    AppendShaderToDiskCache(m_gs_cache.disk_cache, uid, *shader);
     entry.shader = std::move(shader);
   }
 
@@ -1319,6 +1352,7 @@ void ShaderCache::QueueUberShaderPipelines()
           config.blending_state.logicopenable = true;
           config.blending_state.logicmode = LogicOp::And;
         }
+        config.UpdateHash();
 
         auto iter = m_gx_uber_pipeline_cache.find(config);
         if (iter != m_gx_uber_pipeline_cache.end())
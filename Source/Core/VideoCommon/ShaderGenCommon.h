@@ -15,6 +15,7 @@
 #include "Common/BitField.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/Hash.h"
 #include "Common/StringUtil.h"
 #include "Common/TypeUtils.h"
 
@@ -62,7 +63,7 @@ public:
  * Unless performance is not an issue, uid_data should be tightly packed to reduce memory footprint.
  * Shader generators will write to specific uid_data fields; ShaderUid methods will only read raw
  * u32 values from a union.
- * NOTE: Because LinearDiskCache reads and writes the storage associated with a ShaderUid instance,
+ * NOTE: Because IndexedDiskCache reads and writes the storage associated with a ShaderUid instance,
  * ShaderUid must be trivially copyable.
  */
 template <class uid_data>
@@ -103,6 +104,16 @@ private:
   uid_data data{};
 };
 
+template <class uid_data>
+struct std::hash<ShaderUid<uid_data>>
+{
+  size_t operator()(const ShaderUid<uid_data>& uid) const
+  {
+    return static_cast<size_t>(
+        Common::GetHash64(uid.GetUidDataRaw(), static_cast<u32>(uid.GetUidDataSize()), 0));
+  }
+};
+
 class ShaderCode : public ShaderGeneratorInterface
 {
 public:
@@ -10,8 +10,10 @@
 
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/SystemTimers.h"
+#include "Core/System.h"
 
 #include "VideoCommon/BPFunctions.h"
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/VideoEvents.h"
@@ -97,6 +99,12 @@ void Statistics::Display() const
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
+  draw_statistic("Pipeline lookups", "%d", this_frame.num_pipeline_lookups);
+  draw_statistic("Pipeline lookups (last)", "%d", this_frame.num_pipeline_lookups_last);
+  draw_statistic("Pipeline lookup misses", "%d", this_frame.num_pipeline_lookup_misses);
+  draw_statistic("CPU cull draws culled", "%d/%d", this_frame.num_cpu_cull_draws_culled,
+                 this_frame.num_cpu_cull_draws_tested);
+  draw_statistic("CPU culled vertices", "%d", this_frame.num_cpu_culled_vertices);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
   draw_statistic("Primitives (DL)", "%d", this_frame.num_dl_prims);
   draw_statistic("XF loads", "%d", this_frame.num_xf_loads);
@@ -109,11 +117,20 @@ void Statistics::Display() const
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
+  draw_statistic("Vertex Loaders (cached)", "%d", num_vertex_loaders_cached);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
+  auto& fifo = Core::System::GetInstance().GetFifo();
+  if (fifo.UsePipelinedGPUThread())
+  {
+    const Fifo::PipelineOccupancy occupancy = fifo.GetPipelineOccupancy();
+    draw_statistic("GPU decode stage busy", "%.1f%%", occupancy.decode * 100.0f);
+    draw_statistic("GPU submit stage busy", "%.1f%%", occupancy.submit * 100.0f);
+  }
+
   ImGui::Columns(1);
 
   ImGui::End();
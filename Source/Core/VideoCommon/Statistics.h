@@ -20,6 +20,7 @@ struct Statistics
   int num_textures_alive = 0;
 
   int num_vertex_loaders = 0;
+  int num_vertex_loaders_cached = 0;
 
   std::array<float, 6> proj{};
   std::array<float, 16> gproj{};
@@ -52,6 +53,14 @@ struct Statistics
     int num_primitive_joins = 0;
     int num_draw_calls = 0;
 
+    int num_pipeline_lookups = 0;
+    int num_pipeline_lookups_last = 0;
+    int num_pipeline_lookup_misses = 0;
+
+    int num_cpu_cull_draws_tested = 0;
+    int num_cpu_cull_draws_culled = 0;
+    int num_cpu_culled_vertices = 0;
+
     int num_dlists_called = 0;
 
     int bytes_vertex_streamed = 0;
@@ -86,6 +86,24 @@ struct EFBCopyParams
                                             rhs.copy_filter_can_overflow, rhs.apply_gamma);
   }
 
+  bool operator==(const EFBCopyParams& rhs) const
+  {
+    return std::tie(efb_format, copy_format, depth, yuv, all_copy_filter_coefs_needed,
+                    copy_filter_can_overflow,
+                    apply_gamma) == std::tie(rhs.efb_format, rhs.copy_format, rhs.depth, rhs.yuv,
+                                             rhs.all_copy_filter_coefs_needed,
+                                             rhs.copy_filter_can_overflow, rhs.apply_gamma);
+  }
+
+  // Packs all members into an integer for hashing.
+  u32 GetKey() const
+  {
+    return static_cast<u32>(efb_format) | static_cast<u32>(copy_format) << 8 |
+           static_cast<u32>(depth) << 16 | static_cast<u32>(yuv) << 17 |
+           static_cast<u32>(all_copy_filter_coefs_needed) << 18 |
+           static_cast<u32>(copy_filter_can_overflow) << 19 | static_cast<u32>(apply_gamma) << 20;
+  }
+
   PixelFormat efb_format;
   EFBCopyFormat copy_format;
   bool depth;
@@ -95,6 +113,12 @@ struct EFBCopyParams
   bool apply_gamma;
 };
 
+template <>
+struct std::hash<EFBCopyParams>
+{
+  size_t operator()(const EFBCopyParams& params) const { return std::hash<u32>{}(params.GetKey()); }
+};
+
 template <>
 struct fmt::formatter<EFBCopyParams>
 {
@@ -15,6 +15,7 @@
 #include "Common/Assert.h"
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
@@ -224,6 +225,26 @@ u32 VertexLoaderBase::GetVertexComponents(const TVtxDesc& vtx_desc, const VAT& v
   return components;
 }
 
+void VertexLoaderBase::OpenDiskCache()
+{
+#if defined(_M_X86_64)
+  const std::string cache_dir = File::GetUserPath(D_CACHE_IDX);
+  if (!File::IsDirectory(cache_dir))
+    File::CreateFullPath(cache_dir);
+
+  const std::string filename = cache_dir + "VertexLoaderX64.cache";
+  const u32 count = VertexLoaderX64::OpenDiskCache(filename);
+  INFO_LOG_FMT(VIDEO, "Loaded {} cached vertex loaders from {}", count, filename);
+#endif
+}
+
+void VertexLoaderBase::CloseDiskCache()
+{
+#if defined(_M_X86_64)
+  VertexLoaderX64::CloseDiskCache();
+#endif
+}
+
 std::unique_ptr<VertexLoaderBase> VertexLoaderBase::CreateVertexLoader(const TVtxDesc& vtx_desc,
                                                                        const VAT& vtx_attr)
 {
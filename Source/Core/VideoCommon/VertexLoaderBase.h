@@ -62,6 +62,11 @@ public:
   static u32 GetVertexComponents(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
   static std::unique_ptr<VertexLoaderBase> CreateVertexLoader(const TVtxDesc& vtx_desc,
                                                               const VAT& vtx_attr);
+
+  // Persistent cache of generated loader code, for the JIT loaders which support it.
+  static void OpenDiskCache();
+  static void CloseDiskCache();
+
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(const u8* src, u8* dst, int count) = 0;
 
@@ -25,6 +25,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/GPUStageTimers.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/Statistics.h"
@@ -69,6 +70,10 @@ void Init()
   for (auto& map_entry : g_preprocess_vertex_loaders)
     map_entry = nullptr;
   SETSTAT(g_stats.num_vertex_loaders, 0);
+  SETSTAT(g_stats.num_vertex_loaders_cached, 0);
+
+  if (g_Config.bShaderCache)
+    VertexLoaderBase::OpenDiskCache();
 }
 
 void Clear()
@@ -76,6 +81,7 @@ void Clear()
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
+  VertexLoaderBase::CloseDiskCache();
 }
 
 void UpdateVertexArrayPointers()
@@ -371,9 +377,7 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
 
     // CPUCull's performance increase comes from encoding fewer GPU commands, not sending less data
     // Therefore it's only useful to check if culling could remove a flush
-    const bool can_cpu_cull = g_ActiveConfig.bCPUCull &&
-                              primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES &&
-                              !g_vertex_manager->HasSendableVertices();
+    const bool can_cpu_cull = g_ActiveConfig.bCPUCull && !g_vertex_manager->HasSendableVertices();
 
     // if cull mode is CULL_ALL, tell VertexManager to skip triangles and quads.
     // They still need to go through vertex loading, because we need to calculate a zfreeze
@@ -385,15 +389,24 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, count, stride,
                                                                 cullall || can_cpu_cull);
 
-    count = loader->RunVertices(src, dst.GetPointer(), count);
+    {
+      ScopedGPUStageTimer timer(GPUStage::VertexLoading);
+      count = loader->RunVertices(src, dst.GetPointer(), count);
+    }
 
     if (can_cpu_cull && !cullall)
     {
+      INCSTAT(g_stats.this_frame.num_cpu_cull_draws_tested);
       if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
       {
         DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
         memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
       }
+      else
+      {
+        INCSTAT(g_stats.this_frame.num_cpu_cull_draws_culled);
+        ADDSTAT(g_stats.this_frame.num_cpu_culled_vertices, count);
+      }
     }
 
     g_vertex_manager->AddIndices(primitive, count);
@@ -6,16 +6,21 @@
 #include <array>
 #include <cstring>
 #include <string>
+#include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/CPUDetect.h"
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "Common/IndexedDiskCache.h"
 #include "Common/Intrinsics.h"
 #include "Common/JitRegister.h"
+#include "Common/Logging/Log.h"
 #include "Common/x64ABI.h"
 #include "Common/x64Emitter.h"
 #include "VideoCommon/CPMemory.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 
 using namespace Gen;
@@ -33,6 +38,10 @@ static const X64Reg base_reg = RBX;
 
 static const u8* memory_base_ptr = (u8*)&g_main_cp_state.array_strides;
 
+// Generated loaders only reference data relative to memory_base_ptr and jump within themselves,
+// so their code can be copied to a new address, and to a later run of the same build.
+static Common::IndexedDiskCache<VertexLoaderX64::DiskCacheKey, u8> s_disk_cache;
+
 static OpArg MPIC(const void* ptr, X64Reg scale_reg, int scale = SCALE_1)
 {
   return MComplex(base_reg, scale_reg, scale, PtrOffset(ptr, memory_base_ptr));
@@ -43,18 +52,161 @@ static OpArg MPIC(const void* ptr)
   return MDisp(base_reg, PtrOffset(ptr, memory_base_ptr));
 }
 
+// These tables are referenced by the generated code, which may come from the disk cache without
+// ReadVertex ever running, so they must not be function-local statics with lazy initialization.
+static const __m128i shuffle_lut[5][3] = {
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
+     _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
+     _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
+     _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
+};
+static const __m128 scale_factors[32] = {
+    _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
+    _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
+    _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
+    _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
+    _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
+    _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
+    _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
+    _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
+    _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
+    _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
+    _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
+};
+
+// Each disk cache entry is this header, the native vertex declaration and then the code.
+struct DiskCacheEntryHeader
+{
+  // Size of a source vertex as read by the code, which must match m_vertex_size.
+  u32 src_size;
+  // CRC32 of everything after the header.
+  u32 checksum;
+};
+
+// The generated code embeds the offsets of the tables it uses relative to memory_base_ptr, which
+// depend on how this binary was linked, and picks instructions based on the host CPU.
+static u32 GetDiskCacheEnvironment()
+{
+  const std::array<u32, 7> offsets{
+      PtrOffset(&VertexLoaderManager::cached_arraybases, memory_base_ptr),
+      PtrOffset(VertexLoaderManager::position_cache.data(), memory_base_ptr),
+      PtrOffset(VertexLoaderManager::tangent_cache.data(), memory_base_ptr),
+      PtrOffset(VertexLoaderManager::binormal_cache.data(), memory_base_ptr),
+      PtrOffset(VertexLoaderManager::position_matrix_index_cache.data(), memory_base_ptr),
+      PtrOffset(&shuffle_lut, memory_base_ptr),
+      PtrOffset(&scale_factors, memory_base_ptr),
+  };
+  const std::array<u8, 4> cpu_features{cpu_info.bSSSE3, cpu_info.bSSE4_1, cpu_info.bBMI1,
+                                       cpu_info.bBMI2FastParallelBitOps};
+
+  u32 crc = Common::StartCRC32();
+  crc = Common::UpdateCRC32(crc, reinterpret_cast<const u8*>(offsets.data()), sizeof(offsets));
+  crc = Common::UpdateCRC32(crc, cpu_features.data(), cpu_features.size());
+  return crc;
+}
+
 VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
     : VertexLoaderBase(vtx_desc, vtx_att)
 {
   AllocCodeSpace(4096);
   ClearCodeSpace();
-  GenerateVertexLoader();
+  if (!LoadFromDiskCache())
+  {
+    GenerateVertexLoader();
+    SaveToDiskCache();
+  }
   WriteProtect();
 
   Common::JitRegister::Register(region, GetCodePtr(), "VertexLoaderX64\nVtx desc: \n{}\nVAT:\n{}",
                                 vtx_desc, vtx_att);
 }
 
+u32 VertexLoaderX64::OpenDiskCache(const std::string& filename)
+{
+  return s_disk_cache.Open(filename);
+}
+
+void VertexLoaderX64::CloseDiskCache()
+{
+  if (s_disk_cache.NeedsCompaction())
+    s_disk_cache.Compact();
+  s_disk_cache.Close();
+}
+
+VertexLoaderX64::DiskCacheKey VertexLoaderX64::GetDiskCacheKey() const
+{
+  DiskCacheKey key;
+  key.vid = {m_VtxDesc.low.Hex, m_VtxDesc.high.Hex, m_VtxAttr.g0.Hex, m_VtxAttr.g1.Hex,
+             m_VtxAttr.g2.Hex};
+  key.version = DISK_CACHE_VERSION;
+  static const u32 environment = GetDiskCacheEnvironment();
+  key.environment = environment;
+  return key;
+}
+
+bool VertexLoaderX64::LoadFromDiskCache()
+{
+  bool loaded = false;
+  s_disk_cache.Lookup(GetDiskCacheKey(), [this, &loaded](const u8* value, u32 value_size) {
+    constexpr size_t data_offset = sizeof(DiskCacheEntryHeader);
+    constexpr size_t code_offset = data_offset + sizeof(PortableVertexDeclaration);
+    if (value_size <= code_offset)
+      return;
+
+    const size_t code_size = value_size - code_offset;
+    if (code_size > region_size)
+      return;
+
+    // Anything that doesn't look exactly like what this build would emit is generated again
+    DiskCacheEntryHeader header;
+    std::memcpy(&header, value, sizeof(header));
+    if (header.src_size != m_vertex_size ||
+        header.checksum != Common::ComputeCRC32(value + data_offset, value_size - data_offset))
+    {
+      WARN_LOG_FMT(VIDEO, "Ignoring invalid cached vertex loader");
+      return;
+    }
+
+    std::memcpy(&m_native_vtx_decl, value + data_offset, sizeof(PortableVertexDeclaration));
+    std::memcpy(region, value + code_offset, code_size);
+    SetCodePtr(region + code_size, region + region_size);
+    loaded = true;
+  });
+
+  if (loaded)
+    INCSTAT(g_stats.num_vertex_loaders_cached);
+  return loaded;
+}
+
+void VertexLoaderX64::SaveToDiskCache()
+{
+  if (HasWriteFailed() || m_src_ofs != m_vertex_size)
+    return;
+
+  constexpr size_t data_offset = sizeof(DiskCacheEntryHeader);
+  constexpr size_t code_offset = data_offset + sizeof(PortableVertexDeclaration);
+  const size_t code_size = GetCodePtr() - region;
+  std::vector<u8> value(code_offset + code_size);
+  std::memcpy(value.data() + data_offset, &m_native_vtx_decl, sizeof(PortableVertexDeclaration));
+  std::memcpy(value.data() + code_offset, region, code_size);
+
+  const DiskCacheEntryHeader header{
+      m_src_ofs, Common::ComputeCRC32(value.data() + data_offset, value.size() - data_offset)};
+  std::memcpy(value.data(), &header, sizeof(header));
+  s_disk_cache.Append(GetDiskCacheKey(), value.data(), static_cast<u32>(value.size()));
+}
+
 OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attribute)
 {
   OpArg data = MDisp(src_reg, m_src_ofs);
@@ -83,37 +235,6 @@ void VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute,
                                  bool dequantize, u8 scaling_exponent,
                                  AttributeFormat* native_format)
 {
-  static const __m128i shuffle_lut[5][3] = {
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
-       _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
-       _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
-       _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
-  };
-  static const __m128 scale_factors[32] = {
-      _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
-      _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
-      _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
-      _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
-      _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
-      _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
-      _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
-      _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
-      _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
-      _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
-      _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
-  };
-
   X64Reg coords = XMM0;
 
   const auto write_zfreeze = [&]() {  // zfreeze
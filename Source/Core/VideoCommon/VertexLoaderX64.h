@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <array>
+#include <string>
+
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -17,6 +20,22 @@ class VertexLoaderX64 : public VertexLoaderBase, public Gen::X64CodeBlock
 public:
   VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att);
 
+  // Generated loaders are stored in a disk cache while it is open, and reused by later runs
+  // instead of being emitted again. Returns the number of loaders in the cache.
+  static u32 OpenDiskCache(const std::string& filename);
+  static void CloseDiskCache();
+
+  struct DiskCacheKey
+  {
+    std::array<u32, 5> vid;
+    // Increment DISK_CACHE_VERSION when the emitted code changes; the cache is also discarded
+    // whenever the scm revision changes.
+    u32 version;
+    // Hash of everything else the emitted code depends on: the link layout and the host CPU.
+    u32 environment;
+  };
+  static constexpr u32 DISK_CACHE_VERSION = 2;
+
 protected:
   int RunVertices(const u8* src, u8* dst, int count) override;
 
@@ -30,4 +49,7 @@ private:
                   AttributeFormat* native_format);
   void ReadColor(Gen::OpArg data, VertexComponentFormat attribute, ColorFormat format);
   void GenerateVertexLoader();
+  DiskCacheKey GetDiskCacheKey() const;
+  bool LoadFromDiskCache();
+  void SaveToDiskCache();
 };
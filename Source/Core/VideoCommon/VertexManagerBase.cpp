@@ -22,6 +22,7 @@
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/GPUStageTimers.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
@@ -817,6 +818,13 @@ void VertexManagerBase::UpdatePipelineConfig()
       m_pipeline_config_changed = true;
     }
   }
+
+  // Hash the UIDs here, once per state change, rather than in every pipeline cache lookup.
+  if (m_pipeline_config_changed)
+  {
+    m_current_pipeline_config.UpdateHash();
+    m_current_uber_pipeline_config.UpdateHash();
+  }
 }
 
 void VertexManagerBase::UpdatePipelineObject()
@@ -824,6 +832,7 @@ void VertexManagerBase::UpdatePipelineObject()
   if (!m_pipeline_config_changed)
     return;
 
+  ScopedGPUStageTimer timer(GPUStage::ShaderLookup);
   m_current_pipeline_object = nullptr;
   m_pipeline_config_changed = false;
 
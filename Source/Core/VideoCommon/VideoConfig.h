@@ -138,6 +138,7 @@ struct VideoConfig final
   bool bShowGraphs = false;
   bool bShowSpeed = false;
   bool bShowSpeedColors = false;
+  bool bShowAudioLatency = false;
   int iPerfSampleUSec = 0;
   bool bShowPlayerNames = false;
   bool bTrainingModeOverlay = false;
@@ -171,6 +172,8 @@ struct VideoConfig final
   std::string sDumpFormat;
   std::string sDumpPath;
   bool bInternalResolutionFrameDumps = false;
+  // Skip frames instead of stalling emulation when the frame dump encoder falls behind.
+  bool bFrameDumpsDropFrames = false;
   bool bBorderlessFullscreen = false;
   bool bEnableGPUTextureDecoding = false;
   bool bPreferVSForLinePointExpansion = false;
@@ -0,0 +1,195 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "AudioCommon/MixerKernels.h"
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+
+using namespace AudioCommon::MixerKernels;
+
+namespace
+{
+using MixFunction = void (*)(s16* output, const s16* input, u32 num_frames, u64 position,
+                             u32 ratio, s32 left_volume, s32 right_volume);
+
+// Room for the frame before the first one, which cubic interpolation reads.
+constexpr u32 INPUT_OFFSET = 2;
+
+struct MixCase
+{
+  std::vector<s16> input;
+  std::vector<s16> output;
+  u32 num_frames;
+  u64 position;
+  u32 ratio;
+  s32 left_volume;
+  s32 right_volume;
+};
+
+MixCase RandomMixCase(std::mt19937& rng)
+{
+  // Full-scale samples, so that interpolation overshoots and the output saturates.
+  std::uniform_int_distribution<int> sample_dist(-32768, 32767);
+  std::uniform_int_distribution<u32> frames_dist(0, 67);
+  std::uniform_int_distribution<u32> ratio_dist(0, 65536 * 3);
+  std::uniform_int_distribution<u32> frac_dist(0, 0xffff);
+  std::uniform_int_distribution<s32> volume_dist(0, 256);
+
+  MixCase c;
+  c.num_frames = frames_dist(rng);
+  c.position = frac_dist(rng);
+  c.ratio = ratio_dist(rng);
+  c.left_volume = volume_dist(rng);
+  c.right_volume = volume_dist(rng);
+
+  const u64 last_position = c.position + u64{c.ratio} * c.num_frames;
+  c.input.resize(((last_position >> 16) + 3) * 2 + INPUT_OFFSET);
+  for (s16& sample : c.input)
+    sample = static_cast<s16>(sample_dist(rng));
+  c.output.resize(c.num_frames * 2);
+  for (s16& sample : c.output)
+    sample = static_cast<s16>(sample_dist(rng));
+  return c;
+}
+
+std::vector<s16> RunMix(MixFunction mix, const MixCase& c)
+{
+  std::vector<s16> output = c.output;
+  mix(output.data(), c.input.data() + INPUT_OFFSET, c.num_frames, c.position, c.ratio,
+      c.left_volume, c.right_volume);
+  return output;
+}
+
+std::string Describe(const MixCase& c)
+{
+  return fmt::format("frames={} position={} ratio={} volume={}/{}", c.num_frames, c.position,
+                     c.ratio, c.left_volume, c.right_volume);
+}
+}  // namespace
+
+// The loop Mixer::MixerFifo::Mix used before the kernels were split out of it.
+TEST(MixerKernels, LinearMatchesPreviousMixer)
+{
+  std::mt19937 rng(1);
+  for (int n = 0; n < 2000; n++)
+  {
+    MixCase c = RandomMixCase(rng);
+    c.position &= 0xffff;
+
+    std::vector<s16> expected = c.output;
+    const s16* input = c.input.data() + INPUT_OFFSET;
+    u32 index = 0;
+    u32 frac = static_cast<u32>(c.position);
+    for (u32 i = 0; i < c.num_frames * 2; i += 2)
+    {
+      const s16 l1 = input[index];
+      const s16 l2 = input[index + 2];
+      int sample_l = static_cast<s32>((static_cast<u32>(l1) << 16) +
+                                      static_cast<u32>(l2 - l1) * static_cast<u16>(frac)) >>
+                     16;
+      sample_l = (sample_l * c.left_volume) >> 8;
+      expected[i + 1] = std::clamp(sample_l + expected[i + 1], -32767, 32767);
+
+      const s16 r1 = input[index + 1];
+      const s16 r2 = input[index + 3];
+      int sample_r = static_cast<s32>((static_cast<u32>(r1) << 16) +
+                                      static_cast<u32>(r2 - r1) * static_cast<u16>(frac)) >>
+                     16;
+      sample_r = (sample_r * c.right_volume) >> 8;
+      expected[i] = std::clamp(sample_r + expected[i], -32767, 32767);
+
+      frac += c.ratio;
+      index += 2 * static_cast<u16>(frac >> 16);
+      frac &= 0xffff;
+    }
+
+    ASSERT_EQ(expected, RunMix(MixLinearScalar, c)) << Describe(c);
+  }
+}
+
+TEST(MixerKernels, CubicPassesThroughInputFrames)
+{
+  std::mt19937 rng(2);
+  MixCase c = RandomMixCase(rng);
+  c.num_frames = 16;
+  c.position = 0;
+  c.ratio = 0x10000;
+  c.left_volume = 256;
+  c.right_volume = 256;
+  c.input.resize((c.num_frames + 2) * 2 + INPUT_OFFSET);
+  c.output.assign(c.num_frames * 2, 0);
+
+  const std::vector<s16> output = RunMix(MixCubicScalar, c);
+  for (u32 i = 0; i < c.num_frames; i++)
+  {
+    EXPECT_EQ(std::max<s16>(c.input[INPUT_OFFSET + i * 2 + 1], -32767), output[i * 2]);
+    EXPECT_EQ(std::max<s16>(c.input[INPUT_OFFSET + i * 2], -32767), output[i * 2 + 1]);
+  }
+}
+
+#ifdef _M_X86_64
+TEST(MixerKernels, SSE41MatchesScalar)
+{
+  if (!cpu_info.bSSE4_1)
+    GTEST_SKIP() << "SSE4.1 is not supported";
+
+  std::mt19937 rng(3);
+  for (int n = 0; n < 5000; n++)
+  {
+    const MixCase c = RandomMixCase(rng);
+    ASSERT_EQ(RunMix(MixLinearScalar, c), RunMix(MixLinearSSE41, c)) << "linear " << Describe(c);
+    ASSERT_EQ(RunMix(MixCubicScalar, c), RunMix(MixCubicSSE41, c)) << "cubic " << Describe(c);
+  }
+}
+#endif
+
+// Run with --gtest_also_run_disabled_tests. Mixes 32 kHz input to 48 kHz output, like the DMA
+// FIFO, once per active FIFO.
+TEST(MixerKernels, DISABLED_Benchmark)
+{
+  constexpr u32 OUTPUT_FRAMES = 512;
+  constexpr u32 RATIO = 65536 * 32000 / 48000;
+  constexpr int ITERATIONS = 20000;
+
+  std::mt19937 rng(4);
+  std::uniform_int_distribution<int> sample_dist(-16384, 16383);
+  std::vector<s16> input((OUTPUT_FRAMES * RATIO / 65536 + 4) * 2);
+  for (s16& sample : input)
+    sample = static_cast<s16>(sample_dist(rng));
+  std::vector<s16> output(OUTPUT_FRAMES * 2);
+
+  const auto benchmark = [&](const char* name, MixFunction mix) {
+    for (int fifos = 1; fifos <= 8; fifos *= 2)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < ITERATIONS; i++)
+      {
+        std::fill(output.begin(), output.end(), 0);
+        for (int fifo = 0; fifo < fifos; fifo++)
+          mix(output.data(), input.data() + 2, OUTPUT_FRAMES, 0, RATIO, 200, 200);
+      }
+      const double seconds =
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      fmt::print("{:<13} {} FIFOs: {:8.1f} M output frames/s\n", name, fifos,
+                 double(OUTPUT_FRAMES) * ITERATIONS / seconds / 1e6);
+    }
+  };
+
+  benchmark("linear", MixLinearScalar);
+  benchmark("cubic", MixCubicScalar);
+#ifdef _M_X86_64
+  if (cpu_info.bSSE4_1)
+  {
+    benchmark("linear SSE4.1", MixLinearSSE41);
+    benchmark("cubic SSE4.1", MixCubicSSE41);
+  }
+#endif
+}
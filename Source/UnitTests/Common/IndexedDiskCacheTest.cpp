@@ -0,0 +1,236 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/IndexedDiskCache.h"
+
+namespace
+{
+struct Key
+{
+  u32 id;
+  std::array<u8, 12> padding;
+};
+
+using Cache = Common::IndexedDiskCache<Key, u8>;
+
+Key MakeKey(u32 id)
+{
+  return Key{id, {}};
+}
+
+std::vector<u8> MakeValue(u32 id, u32 size)
+{
+  std::vector<u8> value(size);
+  for (u32 i = 0; i < size; i++)
+    value[i] = static_cast<u8>(id * 31 + i);
+  return value;
+}
+
+std::vector<u8> LookupValue(const Cache& cache, u32 id)
+{
+  std::vector<u8> result;
+  cache.Lookup(MakeKey(id), [&result](const u8* value, u32 value_size) {
+    result.assign(value, value + value_size);
+  });
+  return result;
+}
+}  // namespace
+
+class IndexedDiskCacheTest : public testing::Test
+{
+protected:
+  IndexedDiskCacheTest()
+      : m_parent_directory(File::CreateTempDir()), m_file_path(m_parent_directory + "/cache.bin")
+  {
+  }
+
+  ~IndexedDiskCacheTest() override
+  {
+    if (!m_parent_directory.empty())
+      File::DeleteDirRecursively(m_parent_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_parent_directory.empty())
+      FAIL();
+  }
+
+  void Populate(Cache& cache, u32 count)
+  {
+    for (u32 i = 0; i < count; i++)
+    {
+      const std::vector<u8> value = MakeValue(i, i % 17);
+      cache.Append(MakeKey(i), value.data(), static_cast<u32>(value.size()));
+    }
+  }
+
+  const std::string m_parent_directory;
+  const std::string m_file_path;
+};
+
+TEST_F(IndexedDiskCacheTest, LookupBeforeAndAfterReopen)
+{
+  Cache cache;
+  EXPECT_EQ(0u, cache.Open(m_file_path));
+  Populate(cache, 100);
+
+  // Entries appended this session are read back through the file.
+  EXPECT_EQ(MakeValue(42, 42 % 17), LookupValue(cache, 42));
+  EXPECT_FALSE(cache.Contains(MakeKey(100)));
+  cache.Close();
+
+  EXPECT_EQ(100u, cache.Open(m_file_path));
+  for (u32 i = 0; i < 100; i++)
+    EXPECT_EQ(MakeValue(i, i % 17), LookupValue(cache, i));
+  EXPECT_FALSE(cache.Lookup(MakeKey(100), [](const u8*, u32) {}));
+}
+
+TEST_F(IndexedDiskCacheTest, ForEachVisitsEntriesInWriteOrder)
+{
+  {
+    Cache cache;
+    cache.Open(m_file_path);
+    Populate(cache, 20);
+  }
+
+  Cache cache;
+  cache.Open(m_file_path);
+  u32 expected_id = 0;
+  cache.ForEach([&expected_id](const Key& key, const u8* value, u32 value_size) {
+    EXPECT_EQ(expected_id, key.id);
+    EXPECT_EQ(MakeValue(key.id, key.id % 17), std::vector<u8>(value, value + value_size));
+    expected_id++;
+  });
+  EXPECT_EQ(20u, expected_id);
+}
+
+TEST_F(IndexedDiskCacheTest, RecoversFromMissingIndex)
+{
+  {
+    Cache cache;
+    cache.Open(m_file_path);
+    Populate(cache, 10);
+    cache.Close();
+
+    // Simulate a crash: append without writing the index, then truncate the last record.
+    // The records are large enough to overwrite the old index completely.
+    cache.Open(m_file_path);
+    const std::vector<u8> value = MakeValue(10, 200);
+    cache.Append(MakeKey(10), value.data(), static_cast<u32>(value.size()));
+    cache.Append(MakeKey(11), value.data(), static_cast<u32>(value.size()));
+    cache.Sync();
+
+    File::IOFile file(m_file_path, "r+b");
+    const u64 size = file.GetSize();
+    file.Close();
+
+    // Copy the file away before Close() writes the index.
+    File::Copy(m_file_path, m_file_path + ".crash");
+    cache.Close();
+
+    File::IOFile crashed(m_file_path + ".crash", "r+b");
+    crashed.Resize(size - 2);
+    crashed.Close();
+    File::Rename(m_file_path + ".crash", m_file_path);
+  }
+
+  Cache cache;
+  EXPECT_EQ(11u, cache.Open(m_file_path));
+  EXPECT_EQ(MakeValue(10, 200), LookupValue(cache, 10));
+  EXPECT_FALSE(cache.Contains(MakeKey(11)));
+}
+
+TEST_F(IndexedDiskCacheTest, CompactDropsSupersededEntries)
+{
+  Cache cache;
+  cache.Open(m_file_path);
+  Populate(cache, 8);
+  cache.Close();
+
+  cache.Open(m_file_path);
+  const std::vector<u8> replacement = MakeValue(99, 3);
+  for (u32 i = 0; i < 4; i++)
+    cache.Append(MakeKey(i), replacement.data(), static_cast<u32>(replacement.size()));
+
+  EXPECT_EQ(12u, cache.GetEntryCount());
+  EXPECT_TRUE(cache.NeedsCompaction());
+  EXPECT_TRUE(cache.Compact());
+  EXPECT_EQ(8u, cache.GetEntryCount());
+  EXPECT_FALSE(cache.NeedsCompaction());
+
+  for (u32 i = 0; i < 8; i++)
+    EXPECT_EQ(i < 4 ? replacement : MakeValue(i, i % 17), LookupValue(cache, i));
+  cache.Close();
+
+  EXPECT_EQ(8u, cache.Open(m_file_path));
+  EXPECT_EQ(replacement, LookupValue(cache, 2));
+}
+
+TEST_F(IndexedDiskCacheTest, RejectsIndexPointingOutsideRecords)
+{
+  u64 index_offset;
+  {
+    Cache cache;
+    cache.Open(m_file_path);
+    Populate(cache, 10);
+    cache.Close();
+
+    File::IOFile file(m_file_path, "rb");
+    index_offset = file.GetSize() - 10 * 2 * sizeof(u64);
+  }
+
+  {
+    // Point the first index entry far past the end of the file.
+    File::IOFile file(m_file_path, "r+b");
+    const u64 bad_offset = ~u64{0} - 2;
+    file.Seek(index_offset + sizeof(u64), File::SeekOrigin::Begin);
+    file.WriteArray(&bad_offset, 1);
+  }
+
+  // The records are scanned instead.
+  Cache cache;
+  EXPECT_EQ(10u, cache.Open(m_file_path));
+  for (u32 i = 0; i < 10; i++)
+    EXPECT_EQ(MakeValue(i, i % 17), LookupValue(cache, i));
+  cache.Close();
+
+  // And the index is rewritten on close.
+  EXPECT_EQ(10u, cache.Open(m_file_path));
+  EXPECT_EQ(MakeValue(3, 3), LookupValue(cache, 3));
+}
+
+TEST_F(IndexedDiskCacheTest, CompactInBackground)
+{
+  Cache cache;
+  cache.Open(m_file_path);
+  Populate(cache, 8);
+  cache.Close();
+
+  cache.Open(m_file_path);
+  const std::vector<u8> replacement = MakeValue(99, 3);
+  for (u32 i = 0; i < 4; i++)
+    cache.Append(MakeKey(i), replacement.data(), static_cast<u32>(replacement.size()));
+
+  cache.CompactInBackground();
+  // Appends made while the compaction runs are kept.
+  cache.Append(MakeKey(8), replacement.data(), static_cast<u32>(replacement.size()));
+  cache.WaitForCompaction();
+
+  EXPECT_EQ(9u, cache.GetEntryCount());
+  for (u32 i = 0; i < 8; i++)
+    EXPECT_EQ(i < 4 ? replacement : MakeValue(i, i % 17), LookupValue(cache, i));
+  EXPECT_EQ(replacement, LookupValue(cache, 8));
+  cache.Close();
+
+  EXPECT_EQ(9u, cache.Open(m_file_path));
+}
@@ -0,0 +1,286 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+#include "Core/HW/DSPHLE/UCodes/AXKernels.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+constexpr u32 COUNT = 32 * 5 + 3;
+
+// The per-sample loops that AXVoice.h used before the kernels, kept as a reference.
+void ReferenceMixAdd(int* out, const s16* input, u32 count, u16& volume, u16 volume_delta,
+                     s16* dpop)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);
+
+    out[i] += (s16)sample;
+    volume += volume_delta;
+
+    *dpop = (s16)sample;
+  }
+}
+
+void ReferenceEnvelope(s16* samples, u32 count, u16& volume, s16 volume_delta)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 sample = ((s32)samples[i] * volume) >> 15;
+    samples[i] = std::clamp(sample, -32767, 32767);
+    volume += volume_delta;
+  }
+}
+
+// Returns the new position, and updates last_samples and the number of samples read.
+u32 ReferenceResample(const s16* new_samples, u32* read_samples_count, s16* output, u32 count,
+                      s16* last_samples, u32 curr_pos, u32 ratio, const s16* coeffs)
+{
+  s16 temp[4];
+  u32 idx = 0;
+  temp[idx++ & 3] = last_samples[0];
+  temp[idx++ & 3] = last_samples[1];
+  temp[idx++ & 3] = last_samples[2];
+  temp[idx++ & 3] = last_samples[3];
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos += ratio;
+    while (curr_pos >= 0x10000)
+    {
+      temp[idx++ & 3] = new_samples[(*read_samples_count)++];
+      curr_pos -= 0x10000;
+    }
+
+    if (coeffs)
+    {
+      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
+      const s16* c = &coeffs[curr_pos_frac];
+
+      s64 t0 = temp[idx++ & 3];
+      s64 t1 = temp[idx++ & 3];
+      s64 t2 = temp[idx++ & 3];
+      s64 t3 = temp[idx++ & 3];
+
+      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
+      output[i] = MathUtil::SaturatingCast<s16>(samp);
+    }
+    else
+    {
+      u16 curr_frac = curr_pos & 0xFFFF;
+      u16 inv_curr_frac = -curr_frac;
+
+      s16 sample;
+      if (curr_frac)
+      {
+        s32 s0 = temp[idx++ & 3];
+        s32 s1 = temp[idx++ & 3];
+
+        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
+        idx += 2;
+      }
+      else
+      {
+        sample = temp[idx++ & 3];
+        idx += 3;
+      }
+      output[i] = sample;
+    }
+  }
+
+  last_samples[3] = temp[--idx & 3];
+  last_samples[2] = temp[--idx & 3];
+  last_samples[1] = temp[--idx & 3];
+  last_samples[0] = temp[--idx & 3];
+  return curr_pos;
+}
+
+std::vector<s16> RandomSamples(std::mt19937& rng, size_t count)
+{
+  // Half of the samples are at full scale, where saturation matters.
+  std::uniform_int_distribution<int> dist(-32768, 32767);
+  std::bernoulli_distribution extreme(0.5);
+  std::vector<s16> samples(count);
+  for (s16& sample : samples)
+  {
+    const int value = dist(rng);
+    sample = static_cast<s16>(extreme(rng) ? (value < 0 ? -32768 : 32767) : value);
+  }
+  return samples;
+}
+
+// Runs a kernel with the same interface as ResampleAudio, and checks it against the reference.
+template <typename Resample>
+void CheckResample(Resample resample, bool polyphase, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<u32> ratio_dist(0x100, 0x40000);
+  std::uniform_int_distribution<u32> pos_dist(0, 0xFFFF);
+  const std::vector<s16> coeffs = RandomSamples(rng, 512);
+
+  for (int iteration = 0; iteration < 2000; iteration++)
+  {
+    const u32 ratio = iteration < 4 ? 0x10000 << iteration >> 1 : ratio_dist(rng);
+    const u32 position = pos_dist(rng);
+    const std::vector<s16> input = RandomSamples(rng, 4 + COUNT * 5);
+
+    std::array<s16, 4> last_samples;
+    std::copy_n(input.begin(), 4, last_samples.begin());
+    u32 read_samples_count = 0;
+    std::array<s16, COUNT> expected;
+    const u32 expected_position =
+        ReferenceResample(input.data() + 4, &read_samples_count, expected.data(), COUNT,
+                          last_samples.data(), position, ratio, polyphase ? coeffs.data() : nullptr);
+
+    const u64 end_position = position + u64(ratio) * COUNT;
+    ASSERT_EQ(read_samples_count, end_position >> 16);
+    ASSERT_EQ(expected_position, end_position & 0xFFFF);
+    ASSERT_TRUE(std::equal(last_samples.begin(), last_samples.end(),
+                           input.begin() + read_samples_count));
+
+    std::array<s16, COUNT> output;
+    resample(output.data(), input.data(), COUNT, position, ratio, coeffs.data());
+    ASSERT_EQ(expected, output) << "ratio=" << ratio << " position=" << position;
+  }
+}
+}  // namespace
+
+TEST(AXKernels, MixAddMatchesPreviousLoop)
+{
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<u32> u16_dist(0, 0xFFFF);
+  for (int iteration = 0; iteration < 2000; iteration++)
+  {
+    const std::vector<s16> input = RandomSamples(rng, COUNT);
+    const u16 volume = u16_dist(rng);
+    const u16 volume_delta = iteration % 2 ? u16_dist(rng) : 0;
+
+    std::vector<int> expected(COUNT, iteration);
+    u16 expected_volume = volume;
+    s16 expected_dpop = 0;
+    ReferenceMixAdd(expected.data(), input.data(), COUNT, expected_volume, volume_delta,
+                    &expected_dpop);
+
+    std::vector<int> out(COUNT, iteration);
+    u16 out_volume = volume;
+    s16 dpop = 0;
+    AXKernels::MixAddScalar(out.data(), input.data(), COUNT, &out_volume, volume_delta, &dpop);
+    ASSERT_EQ(expected, out);
+    ASSERT_EQ(expected_volume, out_volume);
+    ASSERT_EQ(expected_dpop, dpop);
+  }
+}
+
+TEST(AXKernels, VolumeEnvelopeMatchesPreviousLoop)
+{
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<u32> u16_dist(0, 0xFFFF);
+  for (int iteration = 0; iteration < 2000; iteration++)
+  {
+    std::vector<s16> expected = RandomSamples(rng, COUNT);
+    std::vector<s16> samples = expected;
+    const u16 volume = u16_dist(rng);
+    const s16 volume_delta = static_cast<s16>(u16_dist(rng));
+
+    u16 expected_volume = volume;
+    ReferenceEnvelope(expected.data(), COUNT, expected_volume, volume_delta);
+    u16 out_volume = volume;
+    AXKernels::ApplyVolumeEnvelopeScalar(samples.data(), COUNT, &out_volume,
+                                         static_cast<u16>(volume_delta));
+    ASSERT_EQ(expected, samples);
+    ASSERT_EQ(expected_volume, out_volume);
+  }
+}
+
+TEST(AXKernels, ResampleMatchesPreviousLoop)
+{
+  CheckResample(
+      [](s16* output, const s16* input, u32 count, u64 position, u32 ratio, const s16*) {
+        AXKernels::ResampleLinearScalar(output, input, count, position, ratio);
+      },
+      false, 3);
+  CheckResample(AXKernels::ResamplePolyphaseScalar, true, 4);
+}
+
+#ifdef _M_X86_64
+TEST(AXKernels, SSE41MatchesScalar)
+{
+  if (!cpu_info.bSSE4_1)
+    GTEST_SKIP() << "SSE4.1 is not supported";
+
+  CheckResample(
+      [](s16* output, const s16* input, u32 count, u64 position, u32 ratio, const s16*) {
+        AXKernels::ResampleLinearSSE41(output, input, count, position, ratio);
+      },
+      false, 5);
+  CheckResample(AXKernels::ResamplePolyphaseSSE41, true, 6);
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<u32> u16_dist(0, 0xFFFF);
+  for (int iteration = 0; iteration < 2000; iteration++)
+  {
+    // Odd counts exercise the scalar tails.
+    const u32 count = COUNT - iteration % 4;
+    const std::vector<s16> input = RandomSamples(rng, count);
+    const u16 volume = u16_dist(rng);
+    const u16 volume_delta = u16_dist(rng);
+
+    std::vector<int> expected(count, iteration);
+    u16 expected_volume = volume;
+    s16 expected_dpop = 0;
+    AXKernels::MixAddScalar(expected.data(), input.data(), count, &expected_volume, volume_delta,
+                            &expected_dpop);
+    std::vector<int> out(count, iteration);
+    u16 out_volume = volume;
+    s16 dpop = 0;
+    AXKernels::MixAddSSE41(out.data(), input.data(), count, &out_volume, volume_delta, &dpop);
+    ASSERT_EQ(expected, out);
+    ASSERT_EQ(expected_volume, out_volume);
+    ASSERT_EQ(expected_dpop, dpop);
+
+    std::vector<s16> expected_samples = input;
+    expected_volume = volume;
+    AXKernels::ApplyVolumeEnvelopeScalar(expected_samples.data(), count, &expected_volume,
+                                         volume_delta);
+    std::vector<s16> samples = input;
+    out_volume = volume;
+    AXKernels::ApplyVolumeEnvelopeSSE41(samples.data(), count, &out_volume, volume_delta);
+    ASSERT_EQ(expected_samples, samples);
+    ASSERT_EQ(expected_volume, out_volume);
+  }
+
+  // Full scale samples and filter taps, which overflow a 32-bit sum of products.
+  std::array<s16, 512> coeffs;
+  std::array<s16, 4 + COUNT * 2> input;
+  for (const s16 tap : {-32768, 32767})
+  {
+    for (const s16 sample : {-32768, 32767})
+    {
+      coeffs.fill(tap);
+      input.fill(sample);
+      std::array<s16, COUNT> expected;
+      std::array<s16, COUNT> output;
+      AXKernels::ResamplePolyphaseScalar(expected.data(), input.data(), COUNT, 0, 0x12345,
+                                         coeffs.data());
+      AXKernels::ResamplePolyphaseSSE41(output.data(), input.data(), COUNT, 0, 0x12345,
+                                        coeffs.data());
+      ASSERT_EQ(expected, output) << "tap=" << tap << " sample=" << sample;
+    }
+  }
+}
+#endif
@@ -0,0 +1,131 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+
+namespace
+{
+constexpr u32 FRAME_COUNT = 20;
+
+FifoFrameInfo MakeFrame(u32 frame)
+{
+  FifoFrameInfo info;
+  info.fifoStart = 0x00100000;
+  info.fifoEnd = 0x00110000 + frame;
+  info.fifoData.resize(100 + frame * 37);
+  for (size_t i = 0; i < info.fifoData.size(); i++)
+    info.fifoData[i] = static_cast<u8>(i * frame);
+
+  for (u32 i = 0; i < frame % 4; i++)
+  {
+    MemoryUpdate& update = info.memoryUpdates.emplace_back();
+    update.fifoPosition = i * 10;
+    update.address = 0x00200000 + frame * 0x100 + i;
+    update.type = i % 2 ? MemoryUpdate::TEXTURE_MAP : MemoryUpdate::VERTEX_STREAM;
+    update.data.assign(frame + i + 1, static_cast<u8>(frame ^ i));
+  }
+  return info;
+}
+
+void ExpectFramesEqual(const FifoFrameInfo& expected, const FifoFrameInfo& actual)
+{
+  EXPECT_EQ(expected.fifoStart, actual.fifoStart);
+  EXPECT_EQ(expected.fifoEnd, actual.fifoEnd);
+  EXPECT_EQ(expected.fifoData, actual.fifoData);
+  ASSERT_EQ(expected.memoryUpdates.size(), actual.memoryUpdates.size());
+  for (size_t i = 0; i < expected.memoryUpdates.size(); i++)
+  {
+    EXPECT_EQ(expected.memoryUpdates[i].fifoPosition, actual.memoryUpdates[i].fifoPosition);
+    EXPECT_EQ(expected.memoryUpdates[i].address, actual.memoryUpdates[i].address);
+    EXPECT_EQ(expected.memoryUpdates[i].type, actual.memoryUpdates[i].type);
+    EXPECT_EQ(expected.memoryUpdates[i].data, actual.memoryUpdates[i].data);
+  }
+}
+}  // namespace
+
+class FifoDataFileTest : public testing::TestWithParam<bool>
+{
+protected:
+  FifoDataFileTest() : m_parent_directory(File::CreateTempDir()) {}
+
+  ~FifoDataFileTest() override
+  {
+    if (!m_parent_directory.empty())
+      File::DeleteDirRecursively(m_parent_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_parent_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_parent_directory;
+};
+
+TEST_P(FifoDataFileTest, SaveAndLoadRoundTrip)
+{
+  const bool compressed = GetParam();
+  const std::string path = m_parent_directory + "/test.dff";
+
+  {
+    auto file = std::make_unique<FifoDataFile>();
+    file->SetIsWii(true);
+    file->GetBPMem()[0x20] = 0x12345678;
+    file->GetXFRegs()[3] = 0xcafe;
+    file->GetTexMem()[FifoDataFile::TEX_MEM_SIZE - 1] = 0x5a;
+    for (u32 i = 0; i < FRAME_COUNT; i++)
+      file->AddFrame(MakeFrame(i));
+    ASSERT_TRUE(file->Save(path, compressed));
+  }
+
+  const std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(path, false);
+  ASSERT_NE(nullptr, file);
+  EXPECT_EQ(compressed, file->IsCompressed());
+  EXPECT_TRUE(file->GetIsWii());
+  EXPECT_EQ(0x12345678u, file->GetBPMem()[0x20]);
+  EXPECT_EQ(0xcafeu, file->GetXFRegs()[3]);
+  EXPECT_EQ(0x5a, file->GetTexMem()[FifoDataFile::TEX_MEM_SIZE - 1]);
+  ASSERT_EQ(FRAME_COUNT, file->GetFrameCount());
+
+  // Access the frames out of order, which has to bypass the frame cache of compressed files.
+  for (u32 i = 0; i < FRAME_COUNT; i++)
+  {
+    const u32 frame = (i * 7) % FRAME_COUNT;
+    ExpectFramesEqual(MakeFrame(frame), *file->GetFrame(frame));
+  }
+}
+
+TEST_P(FifoDataFileTest, SaveLoadedFileInPlace)
+{
+  const std::string path = m_parent_directory + "/test.dff";
+
+  {
+    auto file = std::make_unique<FifoDataFile>();
+    for (u32 i = 0; i < FRAME_COUNT; i++)
+      file->AddFrame(MakeFrame(i));
+    ASSERT_TRUE(file->Save(path, true));
+  }
+
+  // The frames of the loaded file are still read from the file being replaced.
+  {
+    const std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(path, false);
+    ASSERT_NE(nullptr, file);
+    ASSERT_TRUE(file->Save(path, GetParam()));
+  }
+
+  const std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(path, false);
+  ASSERT_NE(nullptr, file);
+  ASSERT_EQ(FRAME_COUNT, file->GetFrameCount());
+  for (u32 i = 0; i < FRAME_COUNT; i++)
+    ExpectFramesEqual(MakeFrame(i), *file->GetFrame(i));
+}
+
+INSTANTIATE_TEST_SUITE_P(FifoDataFile, FifoDataFileTest, testing::Bool());
@@ -417,6 +417,60 @@ TEST_F(FileSystemTest, MultipleHandles)
   EXPECT_EQ(TEST_DATA, read_buffer);
 }
 
+// Writes can be buffered by the backend, but must still be visible through the path-based API.
+TEST_F(FileSystemTest, WriteIsVisibleWhileFileIsOpen)
+{
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", 0, modes), ResultCode::Success);
+
+  const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::ReadWrite);
+  ASSERT_TRUE(file.Succeeded());
+  ASSERT_TRUE(file->Write(std::vector<u8>(20).data(), 20).Succeeded());
+
+  const Result<Metadata> metadata = m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f");
+  ASSERT_TRUE(metadata.Succeeded());
+  EXPECT_EQ(metadata->size, 20u);
+}
+
+TEST_F(FileSystemTest, WriteAndReadLargeFile)
+{
+  // Large enough that the file cannot stay buffered in memory
+  std::vector<u8> test_data(0x180000);
+  for (size_t i = 0; i < test_data.size(); ++i)
+    test_data[i] = static_cast<u8>(i ^ (i >> 8));
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", 0, modes), ResultCode::Success);
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::Write);
+    ASSERT_TRUE(file.Succeeded());
+    constexpr size_t CHUNK_SIZE = 0x10000;
+    for (size_t offset = 0; offset < test_data.size(); offset += CHUNK_SIZE)
+      ASSERT_TRUE(file->Write(test_data.data() + offset, CHUNK_SIZE).Succeeded());
+  }
+
+  const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::Read);
+  ASSERT_TRUE(file.Succeeded());
+  std::vector<u8> read_buffer(test_data.size());
+  ASSERT_TRUE(file->Read(read_buffer.data(), read_buffer.size()).Succeeded());
+  EXPECT_EQ(test_data, read_buffer);
+}
+
+TEST_F(FileSystemTest, MetadataIsKeptAfterShutdown)
+{
+  constexpr Modes other_modes{Mode::ReadWrite, Mode::Read, Mode::None};
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/shared2/f", 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->SetMetadata(Uid{0}, "/shared2/f", Uid{0x1000}, Gid{1}, 0, other_modes),
+            ResultCode::Success);
+
+  // The FST is written when the file system is destroyed at the latest
+  m_fs.reset();
+  m_fs = IOS::HLE::Kernel{}.GetFS();
+  const Result<Metadata> metadata = m_fs->GetMetadata(Uid{0}, Gid{0}, "/shared2/f");
+  ASSERT_TRUE(metadata.Succeeded());
+  EXPECT_EQ(metadata->uid, 0x1000u);
+  EXPECT_EQ(metadata->gid, 1u);
+  EXPECT_EQ(metadata->modes, other_modes);
+}
+
 // ReadDirectory is used by official titles to determine whether a path is a file.
 // If it is not a file, ResultCode::Invalid must be returned.
 TEST_F(FileSystemTest, ReadDirectoryOnFile)
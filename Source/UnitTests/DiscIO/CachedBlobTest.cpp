@@ -0,0 +1,181 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/CachedBlob.h"
+
+namespace
+{
+constexpr u64 BLOCK_SIZE = 0x10000;
+constexpr u64 DATA_SIZE = BLOCK_SIZE * 40 + 0x1234;
+constexpr u64 PARTITION_DATA_OFFSET = 0x50000;
+constexpr u64 PARTITION_DATA_SIZE = 0x7C00 * 2 * 30 + 0x4321;
+// Reads outside of partitions use this in place of a partition data offset
+constexpr u64 RAW_DATA = 0;
+
+u8 GetByte(u64 offset, u64 partition_data_offset)
+{
+  return static_cast<u8>((offset * 7) ^ (offset >> 11) ^ (partition_data_offset >> 16));
+}
+
+struct ReadCounters
+{
+  std::atomic<u64> blocks_read = 0;
+  std::atomic<bool> fail = false;
+};
+
+// Pretends to be a compressed format, which can only read whole blocks.
+class TestBlobReader final : public DiscIO::BlobReader
+{
+public:
+  explicit TestBlobReader(ReadCounters* counters) : m_counters(counters) {}
+
+  DiscIO::BlobType GetBlobType() const override { return DiscIO::BlobType::RVZ; }
+  u64 GetRawSize() const override { return DATA_SIZE / 2; }
+  u64 GetDataSize() const override { return DATA_SIZE; }
+  DiscIO::DataSizeType GetDataSizeType() const override
+  {
+    return DiscIO::DataSizeType::Accurate;
+  }
+  u64 GetBlockSize() const override { return BLOCK_SIZE; }
+  bool HasFastRandomAccessInBlock() const override { return false; }
+  std::string GetCompressionMethod() const override { return "Test"; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override
+  {
+    return Fill(offset, size, out_ptr, RAW_DATA, DATA_SIZE);
+  }
+
+  bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override
+  {
+    return partition_data_offset == PARTITION_DATA_OFFSET && offset + size <= PARTITION_DATA_SIZE;
+  }
+
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override
+  {
+    if (!SupportsReadWiiDecrypted(offset, size, partition_data_offset))
+      return false;
+    return Fill(offset, size, out_ptr, partition_data_offset, PARTITION_DATA_SIZE);
+  }
+
+private:
+  bool Fill(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset, u64 data_size)
+  {
+    if (m_counters->fail || offset + size > data_size)
+      return false;
+
+    ++m_counters->blocks_read;
+    for (u64 i = 0; i < size; ++i)
+      out_ptr[i] = GetByte(offset + i, partition_data_offset);
+    return true;
+  }
+
+  ReadCounters* m_counters;
+};
+
+std::unique_ptr<DiscIO::CachedBlobReader> CreateReader(ReadCounters* counters,
+                                                       size_t read_ahead_threads)
+{
+  std::vector<std::unique_ptr<DiscIO::BlobReader>> read_ahead_readers;
+  for (size_t i = 0; i < read_ahead_threads; ++i)
+    read_ahead_readers.push_back(std::make_unique<TestBlobReader>(counters));
+
+  return DiscIO::CachedBlobReader::Create(std::make_unique<TestBlobReader>(counters),
+                                          std::move(read_ahead_readers));
+}
+
+bool CheckData(const std::vector<u8>& data, u64 offset, u64 partition_data_offset)
+{
+  for (u64 i = 0; i < data.size(); ++i)
+  {
+    if (data[i] != GetByte(offset + i, partition_data_offset))
+      return false;
+  }
+  return true;
+}
+}  // namespace
+
+TEST(CachedBlob, RandomReadsMatchReader)
+{
+  ReadCounters counters;
+  const auto reader = CreateReader(&counters, 2);
+  ASSERT_NE(reader, nullptr);
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<u64> offset_dist(0, DATA_SIZE - 1);
+  std::uniform_int_distribution<u64> partition_offset_dist(0, PARTITION_DATA_SIZE - 1);
+  std::uniform_int_distribution<u64> size_dist(1, BLOCK_SIZE * 3);
+  for (int i = 0; i < 2000; ++i)
+  {
+    // Mix sequential runs in, so that the read-ahead threads get to work
+    const bool partition = i % 3 == 0;
+    const u64 data_size = partition ? PARTITION_DATA_SIZE : DATA_SIZE;
+    u64 offset = partition ? partition_offset_dist(rng) : offset_dist(rng);
+    for (int j = 0; j < 4 && offset < data_size; ++j)
+    {
+      std::vector<u8> data(std::min(size_dist(rng), data_size - offset));
+      if (partition)
+      {
+        ASSERT_TRUE(reader->ReadWiiDecrypted(offset, data.size(), data.data(),
+                                             PARTITION_DATA_OFFSET));
+        ASSERT_TRUE(CheckData(data, offset, PARTITION_DATA_OFFSET)) << offset;
+      }
+      else
+      {
+        ASSERT_TRUE(reader->Read(offset, data.size(), data.data()));
+        ASSERT_TRUE(CheckData(data, offset, RAW_DATA)) << offset;
+      }
+      offset += data.size();
+    }
+  }
+
+  // Reads past the end fail like they do for the wrapped reader
+  std::vector<u8> data(0x100);
+  EXPECT_FALSE(reader->Read(DATA_SIZE - 0x80, data.size(), data.data()));
+}
+
+TEST(CachedBlob, SequentialReadsReadEachBlockOnce)
+{
+  for (const size_t read_ahead_threads : {0, 1, 4})
+  {
+    ReadCounters counters;
+    const auto reader = CreateReader(&counters, read_ahead_threads);
+
+    std::vector<u8> data(0x800);
+    for (u64 offset = 0; offset + data.size() <= DATA_SIZE; offset += data.size())
+    {
+      ASSERT_TRUE(reader->Read(offset, data.size(), data.data()));
+      ASSERT_TRUE(CheckData(data, offset, RAW_DATA));
+    }
+
+    // Whether a block was read ahead or read on demand, it was only decompressed once.
+    EXPECT_EQ(counters.blocks_read, DATA_SIZE / BLOCK_SIZE + 1) << read_ahead_threads;
+  }
+}
+
+TEST(CachedBlob, FailedReadsAreNotCached)
+{
+  ReadCounters counters;
+  const auto reader = CreateReader(&counters, 2);
+
+  std::vector<u8> data(0x100);
+  counters.fail = true;
+  EXPECT_FALSE(reader->Read(0, data.size(), data.data()));
+
+  counters.fail = false;
+  ASSERT_TRUE(reader->Read(0, data.size(), data.data()));
+  EXPECT_TRUE(CheckData(data, 0, RAW_DATA));
+}
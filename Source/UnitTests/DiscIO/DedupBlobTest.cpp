@@ -0,0 +1,167 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DedupBlob.h"
+
+namespace
+{
+constexpr int CHUNK_SIZE = 0x8000;
+constexpr u64 DATA_SIZE = CHUNK_SIZE * 20 + 0x1234;
+
+class MemoryBlobReader final : public DiscIO::BlobReader
+{
+public:
+  explicit MemoryBlobReader(std::vector<u8> data) : m_data(std::move(data)) {}
+
+  DiscIO::BlobType GetBlobType() const override { return DiscIO::BlobType::PLAIN; }
+  u64 GetRawSize() const override { return m_data.size(); }
+  u64 GetDataSize() const override { return m_data.size(); }
+  DiscIO::DataSizeType GetDataSizeType() const override
+  {
+    return DiscIO::DataSizeType::Accurate;
+  }
+  u64 GetBlockSize() const override { return 0; }
+  bool HasFastRandomAccessInBlock() const override { return false; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override
+  {
+    if (offset + size > m_data.size())
+      return false;
+    std::copy_n(m_data.begin() + offset, size, out_ptr);
+    return true;
+  }
+
+private:
+  std::vector<u8> m_data;
+};
+
+std::vector<u8> CreateData(u8 seed)
+{
+  std::vector<u8> data(DATA_SIZE);
+  for (u64 i = 0; i < data.size(); ++i)
+    data[i] = static_cast<u8>((i * 7) ^ (i >> 11) ^ seed);
+  return data;
+}
+
+bool Convert(const std::vector<u8>& data, const std::string& path)
+{
+  MemoryBlobReader reader(data);
+  return DiscIO::ConvertToDedup(&reader, "memory", path, "Store", CHUNK_SIZE,
+                                [](const std::string&, float) { return true; });
+}
+
+std::vector<u8> ReadAll(DiscIO::BlobReader* reader)
+{
+  std::vector<u8> data(reader->GetDataSize());
+  if (!reader->Read(0, data.size(), data.data()))
+    return {};
+  return data;
+}
+
+u64 GetTotalFileSize(const File::FSTEntry& entry)
+{
+  if (!entry.isDirectory)
+    return entry.size;
+
+  u64 size = 0;
+  for (const File::FSTEntry& child : entry.children)
+    size += GetTotalFileSize(child);
+  return size;
+}
+
+class DedupBlobTest : public testing::Test
+{
+protected:
+  void SetUp() override { m_directory = File::CreateTempDir(); }
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string m_directory;
+};
+}  // namespace
+
+TEST_F(DedupBlobTest, RoundTrip)
+{
+  const std::vector<u8> data = CreateData(0);
+  const std::string path = m_directory + "/game.dedup";
+  ASSERT_TRUE(Convert(data, path));
+
+  const auto reader = DiscIO::CreateBlobReader(path);
+  ASSERT_NE(reader, nullptr);
+  EXPECT_EQ(reader->GetBlobType(), DiscIO::BlobType::DEDUP);
+  EXPECT_EQ(reader->GetDataSize(), DATA_SIZE);
+  EXPECT_EQ(ReadAll(reader.get()), data);
+
+  // Reads crossing chunk boundaries
+  std::vector<u8> buffer(CHUNK_SIZE + 0x100);
+  ASSERT_TRUE(reader->Read(CHUNK_SIZE * 3 - 0x80, buffer.size(), buffer.data()));
+  EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin() + CHUNK_SIZE * 3 - 0x80));
+  EXPECT_FALSE(reader->Read(DATA_SIZE - 0x10, 0x20, buffer.data()));
+}
+
+TEST_F(DedupBlobTest, SharedChunksAreStoredOnce)
+{
+  const std::vector<u8> original = CreateData(0);
+  std::vector<u8> modified = original;
+  modified[CHUNK_SIZE * 5 + 3] ^= 0xFF;
+
+  ASSERT_TRUE(Convert(original, m_directory + "/original.dedup"));
+  const u64 store_size = GetTotalFileSize(File::ScanDirectoryTree(m_directory + "/Store", true));
+  ASSERT_TRUE(Convert(modified, m_directory + "/modified.dedup"));
+
+  // Only the one chunk that differs was added
+  EXPECT_EQ(GetTotalFileSize(File::ScanDirectoryTree(m_directory + "/Store", true)),
+            store_size + CHUNK_SIZE);
+
+  const auto reader = DiscIO::CreateBlobReader(m_directory + "/modified.dedup");
+  ASSERT_NE(reader, nullptr);
+  EXPECT_EQ(ReadAll(reader.get()), modified);
+}
+
+TEST_F(DedupBlobTest, MissingChunkFailsRead)
+{
+  const std::vector<u8> data = CreateData(0);
+  const std::string path = m_directory + "/game.dedup";
+  ASSERT_TRUE(Convert(data, path));
+
+  const auto reader = DiscIO::CreateBlobReader(path);
+  ASSERT_NE(reader, nullptr);
+
+  File::DeleteDirRecursively(m_directory + "/Store");
+  std::vector<u8> buffer(0x100);
+  EXPECT_FALSE(reader->Read(0, buffer.size(), buffer.data()));
+}
+
+TEST_F(DedupBlobTest, InvalidHeaderIsRejected)
+{
+  const std::string path = m_directory + "/game.dedup";
+  ASSERT_TRUE(Convert(CreateData(0), path));
+
+  const auto patch_header = [&path](u64 offset, const auto& value) {
+    File::IOFile file(path, "r+b");
+    return file.Seek(offset, File::SeekOrigin::Begin) && file.WriteBytes(&value, sizeof(value));
+  };
+
+  // A data size this large would need more digests than fit in the address space
+  ASSERT_TRUE(patch_header(8, u64(0xFFFFFFFFFFFFFFFF)));
+  EXPECT_EQ(DiscIO::CreateBlobReader(path), nullptr);
+  ASSERT_TRUE(patch_header(8, DATA_SIZE));
+  EXPECT_NE(DiscIO::CreateBlobReader(path), nullptr);
+
+  ASSERT_TRUE(patch_header(16, u32(CHUNK_SIZE + 1)));
+  EXPECT_EQ(DiscIO::CreateBlobReader(path), nullptr);
+}
@@ -0,0 +1,157 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/TevCombiner.h"
+#include "VideoCommon/BPMemory.h"
+
+namespace
+{
+struct CombinerState
+{
+  TevStageCombiner::ColorCombiner cc;
+  TevStageCombiner::AlphaCombiner ac;
+};
+
+// Every regular-mode combination of bias, op, clamp and scale, for color and alpha independently.
+std::vector<CombinerState> GetAllRegularCombiners()
+{
+  std::vector<u32> modes;
+  for (u32 bias = 0; bias < 3; bias++)
+  {
+    for (u32 op = 0; op < 2; op++)
+    {
+      for (u32 clamp = 0; clamp < 2; clamp++)
+      {
+        for (u32 scale = 0; scale < 4; scale++)
+          modes.push_back(bias << 16 | op << 18 | clamp << 19 | scale << 20);
+      }
+    }
+  }
+
+  std::vector<CombinerState> states;
+  for (u32 color_mode : modes)
+  {
+    for (u32 alpha_mode : modes)
+    {
+      CombinerState& state = states.emplace_back();
+      state.cc.hex = color_mode;
+      state.ac.hex = alpha_mode;
+    }
+  }
+  return states;
+}
+
+TevCombiner::Inputs RandomInputs(std::mt19937& rng)
+{
+  // Bias the distribution towards the edges of each range, where rounding matters most.
+  std::uniform_int_distribution<int> u8_dist(-32, 255 + 32);
+  std::uniform_int_distribution<int> d_dist(-1024 - 64, 1023 + 64);
+
+  TevCombiner::Inputs inputs;
+  for (TevCombiner::InputRegType& input : inputs)
+  {
+    input.a = std::clamp(u8_dist(rng), 0, 255);
+    input.b = std::clamp(u8_dist(rng), 0, 255);
+    input.c = std::clamp(u8_dist(rng), 0, 255);
+    input.d = std::clamp(d_dist(rng), -1024, 1023);
+  }
+  return inputs;
+}
+
+std::string Describe(const CombinerState& state, const TevCombiner::Inputs& inputs)
+{
+  std::string description = fmt::format("cc={:08x} ac={:08x}", state.cc.hex, state.ac.hex);
+  for (const TevCombiner::InputRegType& input : inputs)
+  {
+    description +=
+        fmt::format(" ({} {} {} {})", int(input.a), int(input.b), int(input.c), int(input.d));
+  }
+  return description;
+}
+}  // namespace
+
+TEST(SWTevCombiner, ScalarMatchesPerChannelFunctions)
+{
+  std::mt19937 rng(1);
+  for (const CombinerState& state : GetAllRegularCombiners())
+  {
+    const TevCombiner::Inputs inputs = RandomInputs(rng);
+    const TevCombiner::Output output =
+        TevCombiner::CombineRegularScalar(state.cc, state.ac, inputs);
+
+    const s16 alpha = static_cast<s16>(TevCombiner::AlphaRegular(state.ac, inputs[0]));
+    EXPECT_EQ(
+        state.ac.clamp ? std::clamp<s16>(alpha, 0, 255) : std::clamp<s16>(alpha, -1024, 1023),
+        output[0])
+        << Describe(state, inputs);
+
+    for (int i = 1; i < 4; i++)
+    {
+      const s16 color = static_cast<s16>(TevCombiner::ColorRegular(state.cc, inputs[i]));
+      EXPECT_EQ(
+          state.cc.clamp ? std::clamp<s16>(color, 0, 255) : std::clamp<s16>(color, -1024, 1023),
+          output[i])
+          << Describe(state, inputs);
+    }
+  }
+}
+
+#ifdef _M_X86_64
+TEST(SWTevCombiner, SSE41MatchesScalar)
+{
+  if (!cpu_info.bSSE4_1)
+    GTEST_SKIP() << "SSE4.1 is not supported";
+
+  std::mt19937 rng(2);
+  const std::vector<CombinerState> states = GetAllRegularCombiners();
+  for (const CombinerState& state : states)
+  {
+    for (int i = 0; i < 64; i++)
+    {
+      const TevCombiner::Inputs inputs = RandomInputs(rng);
+      ASSERT_EQ(TevCombiner::CombineRegularScalar(state.cc, state.ac, inputs),
+                TevCombiner::CombineRegularSSE41(state.cc, state.ac, inputs))
+          << Describe(state, inputs);
+    }
+  }
+
+  // Extreme inputs, which exercise the s16 truncation and both clamp ranges
+  for (const CombinerState& state : states)
+  {
+    for (const u32 a : {0, 255})
+    {
+      for (const u32 b : {0, 255})
+      {
+        for (const u32 c : {0, 127, 128, 255})
+        {
+          for (const s32 d : {-1024, -1, 0, 1023})
+          {
+            TevCombiner::InputRegType input;
+            input.a = a;
+            input.b = b;
+            input.c = c;
+            input.d = d;
+
+            TevCombiner::Inputs inputs;
+            inputs.fill(input);
+            ASSERT_EQ(TevCombiner::CombineRegularScalar(state.cc, state.ac, inputs),
+                      TevCombiner::CombineRegularSSE41(state.cc, state.ac, inputs))
+                << Describe(state, inputs);
+          }
+        }
+      }
+    }
+  }
+}
+#endif